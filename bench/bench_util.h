@@ -0,0 +1,128 @@
+#pragma once
+#ifndef SERIAL_PORT_BENCH_UTIL_H
+#define SERIAL_PORT_BENCH_UTIL_H
+
+/// 说明：基准测试与测试程序共用的工具（伪终端、计时与分位数统计），仅 POSIX
+
+#include <fcntl.h>
+#include <stdlib.h>
+#include <termios.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace bench
+{
+/// @brief 单调时钟（纳秒）
+inline int64_t nowNs()
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+/**
+ * @brief 伪终端对：master 端模拟串口设备，slave 端路径交给 SerialPort 打开
+ *
+ * 析构或 close() 关闭 master 端，slave 端随之挂断，相当于拔出设备。
+ */
+class PtyPair
+{
+ public:
+  PtyPair() = default;
+  ~PtyPair()
+  {
+    close();
+  }
+
+  // 禁止复制
+  PtyPair(const PtyPair&) = delete;
+  PtyPair& operator=(const PtyPair&) = delete;
+
+  /**
+   * @brief 创建伪终端，并把 slave 端设为原始模式（SerialPort 打开前写入的数据也不经过行规程处理）
+   * @return 失败返回 false
+   */
+  bool open()
+  {
+    close();
+    master_ = ::posix_openpt(O_RDWR | O_NOCTTY);
+    if (master_ < 0) return false;
+    if (::grantpt(master_) != 0 || ::unlockpt(master_) != 0)
+    {
+      close();
+      return false;
+    }
+    const char* name = ::ptsname(master_);
+    if (!name)
+    {
+      close();
+      return false;
+    }
+    slave_ = name;
+    int fd = ::open(name, O_RDWR | O_NOCTTY);
+    if (fd >= 0)
+    {
+      struct termios options;
+      if (::tcgetattr(fd, &options) == 0)
+      {
+        ::cfmakeraw(&options);
+        ::tcsetattr(fd, TCSANOW, &options);
+      }
+      ::close(fd);
+    }
+    return true;
+  }
+
+  /**
+   * @brief 关闭 master 端
+   */
+  void close()
+  {
+    if (master_ >= 0) ::close(master_);
+    master_ = -1;
+  }
+
+  /// master 端文件描述符
+  int master() const
+  {
+    return master_;
+  }
+
+  /// slave 端路径（如 /dev/pts/3）
+  const std::string& slave() const
+  {
+    return slave_;
+  }
+
+ private:
+  int master_{-1};     ///< master 端
+  std::string slave_;  ///< slave 端路径
+};
+
+/**
+ * @brief 打印一组耗时样本的分位数
+ * @param label 标签
+ * @param samples_ns 样本（纳秒），会被排序
+ * @param unit_ns 输出单位（1000 为微秒，1000000 为毫秒）
+ * @param unit 单位名
+ */
+inline void printPercentiles(const char* label, std::vector<int64_t>& samples_ns, double unit_ns, const char* unit)
+{
+  if (samples_ns.empty())
+  {
+    std::printf("%-34s no samples\n", label);
+    return;
+  }
+  std::sort(samples_ns.begin(), samples_ns.end());
+  const size_t n = samples_ns.size();
+  std::printf("%-34s n=%-6zu p50 %9.2f  p90 %9.2f  p99 %9.2f  max %9.2f %s\n", label, n, samples_ns[n / 2] / unit_ns,
+              samples_ns[n * 9 / 10] / unit_ns, samples_ns[n * 99 / 100] / unit_ns, samples_ns[n - 1] / unit_ns, unit);
+}
+}  // namespace bench
+
+#endif  // SERIAL_PORT_BENCH_UTIL_H
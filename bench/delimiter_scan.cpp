@@ -0,0 +1,90 @@
+/// 说明：分隔符扫描基准测试——向量化 DelimiterScanner 与原 readline 的逐字节比较
+/// 用法：benchDelimiterScan
+/// 缓冲区为不含分隔符的可打印字符，分隔符只出现在末尾（每次都扫描整个缓冲区），长度 64B ~ 64KB
+
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <serial/delimiter_scanner.h>
+
+#include "bench_util.h"
+
+namespace
+{
+volatile size_t g_sink = 0;  ///< 防止扫描结果被优化掉
+
+/// @brief 原 Serial::readline 的判断方式：每读入一个字节，构造临时字符串与 eol 比较
+size_t perByteString(const uint8_t* data, size_t size, const std::string& eol)
+{
+  const size_t eol_len = eol.length();
+  for (size_t read_so_far = 1; read_so_far <= size; ++read_so_far)
+  {
+    if (read_so_far < eol_len) continue;
+    if (std::string(reinterpret_cast<const char*>(data + read_so_far - eol_len), eol_len) == eol)
+    {
+      return read_so_far - eol_len;
+    }
+  }
+  return serial::DelimiterScanner::npos;
+}
+
+/// @brief 不构造临时字符串的逐字节比较（标量基线）
+size_t perByteCompare(const uint8_t* data, size_t size, const std::string& eol)
+{
+  const size_t eol_len = eol.length();
+  for (size_t i = 0; i + eol_len <= size; ++i)
+  {
+    if (data[i] == static_cast<uint8_t>(eol[0]) && std::memcmp(data + i, eol.data(), eol_len) == 0) return i;
+  }
+  return serial::DelimiterScanner::npos;
+}
+
+/// @brief 多次调用 fn 扫描 buf（总计约 budget 字节，至少 16 次），返回每次调用的平均耗时（纳秒）
+template <typename Fn>
+double timeScan(const std::vector<uint8_t>& buf, size_t budget, Fn fn)
+{
+  const size_t iterations = std::max<size_t>(16, budget / buf.size());
+  const int64_t start = bench::nowNs();
+  for (size_t i = 0; i < iterations; ++i) g_sink = g_sink + fn(buf.data(), buf.size());
+  return static_cast<double>(bench::nowNs() - start) / iterations;
+}
+
+/// @brief 测量一组分隔符
+void run(const char* label, const std::vector<std::string>& delimiters)
+{
+  const serial::DelimiterScanner scanner(delimiters);
+  const std::string& eol = delimiters.front();
+  std::printf("\ndelimiters %s\n", label);
+  std::printf("%8s %14s %14s %14s %10s %10s\n", "size", "string ns", "compare ns", "scanner ns", "vs string",
+              "vs compare");
+
+  std::mt19937 rng(7);
+  for (size_t size = 64; size <= 64 * 1024; size *= 4)
+  {
+    std::vector<uint8_t> buf(size);
+    for (uint8_t& c : buf) c = static_cast<uint8_t>('A' + rng() % 26);
+    std::memcpy(buf.data() + size - eol.size(), eol.data(), eol.size());
+
+    const double t_string =
+        timeScan(buf, 4u << 20, [&](const uint8_t* d, size_t n) { return perByteString(d, n, eol); });
+    const double t_compare =
+        timeScan(buf, 32u << 20, [&](const uint8_t* d, size_t n) { return perByteCompare(d, n, eol); });
+    const double t_scanner = timeScan(buf, 32u << 20, [&](const uint8_t* d, size_t n) { return scanner.find(d, n); });
+    std::printf("%8zu %14.1f %14.1f %14.1f %9.1fx %9.1fx\n", size, t_string, t_compare, t_scanner,
+                t_string / t_scanner, t_compare / t_scanner);
+  }
+}
+}  // namespace
+
+int main()
+{
+  std::printf("scanner kernel: %s\n", serial::DelimiterScanner::kernelName());
+  run("\"\\n\"", {"\n"});
+  run("\"\\r\\n\"", {"\r\n"});
+  // 多分隔符时逐字节基线只比较第一个（对其有利），扫描器同时查找全部三个
+  run("\"\\r\\n\" \"\\n\" \";\"", {"\r\n", "\n", ";"});
+  return 0;
+}
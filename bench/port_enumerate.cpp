@@ -0,0 +1,90 @@
+/// 说明：串口枚举基准测试——在合成 sysfs 目录树上比较原 list_ports 做法与 PortEnumerator
+/// 用法：benchPortEnumerate [USB 串口数=300] [次数=20]
+/// 目录树另含 67 个虚拟终端与 32 个 8250 串口（28 个为占位节点），见 bench::FakeSysfs
+
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "bench_util.h"
+#include "serialport/device_watcher.h"
+#include "serialport/port_enumerator.h"
+#include "sysfs_fixture.h"
+
+namespace
+{
+/// @brief 调用 fn 若干次，打印单次耗时分位数
+template <typename Fn>
+void measure(const char* label, int iterations, Fn fn)
+{
+  std::vector<int64_t> samples;
+  for (int i = 0; i < iterations; ++i)
+  {
+    const int64_t start = bench::nowNs();
+    fn();
+    samples.push_back(bench::nowNs() - start);
+  }
+  bench::printPercentiles(label, samples, 1000.0, "us");
+}
+
+/// @brief 两组结果中端口、描述与硬件 ID 都相同的条目数
+size_t identical(const std::vector<serial::PortInfo>& a, const std::vector<serial::PortInfo>& b)
+{
+  auto key = [](const serial::PortInfo& info) { return info.port + '\n' + info.description + '\n' + info.hardware_id; };
+  std::set<std::string> keys;
+  for (const serial::PortInfo& info : a) keys.insert(key(info));
+  size_t same = 0;
+  for (const serial::PortInfo& info : b) same += keys.count(key(info));
+  return same;
+}
+}  // namespace
+
+int main(int argc, char** argv)
+{
+  const size_t usb_ports = argc > 1 ? static_cast<size_t>(std::atoi(argv[1])) : 300;
+  const int iterations = argc > 2 ? std::atoi(argv[2]) : 20;
+
+  bench::FakeSysfs tree;
+  if (!tree.create(usb_ports))
+  {
+    std::printf("failed to create the synthetic sysfs tree\n");
+    return 1;
+  }
+  PortEnumerator::Config config;
+  config.sysfs_root = tree.sysfsRoot();
+  config.dev_root = tree.devRoot();
+
+  const std::vector<serial::PortInfo> legacy = bench::legacyListPorts(config.sysfs_root, config.dev_root);
+  PortEnumerator reference(config);
+  const std::vector<serial::PortInfo> ports = reference.list();
+  std::printf("%zu USB ports: legacy lists %zu entries (incl. 8250 placeholders), enumerator %zu (%zu candidates), "
+              "%zu identical\n",
+              usb_ports, legacy.size(), ports.size(), reference.stats().candidates, identical(legacy, ports));
+
+  measure("legacy list_ports", iterations, [&] { bench::legacyListPorts(config.sysfs_root, config.dev_root); });
+
+  config.threads = 1;
+  PortEnumerator single(config);
+  measure("enumerator, 1 thread", iterations, [&] { single.list(); });
+
+  config.threads = 0;
+  PortEnumerator parallel(config);
+  measure("enumerator, parallel", iterations, [&] { parallel.list(); });
+
+  // 启用监视后由设备事件维护缓存，list() 不再访问 sysfs
+  DeviceWatcher::Config watch_config;
+  watch_config.netlink = false;
+  watch_config.watch_dirs = {config.dev_root};
+  watch_config.dev_root = config.dev_root;
+  watch_config.sysfs_root = config.sysfs_root;
+  PortEnumerator cached(config);
+  if (cached.watch(std::make_shared<DeviceWatcher>(watch_config)))
+  {
+    cached.list();
+    measure("enumerator, watched (cached)", iterations, [&] { cached.list(); });
+  }
+  return 0;
+}
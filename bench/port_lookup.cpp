@@ -0,0 +1,120 @@
+/// 说明：按身份查找串口的基准测试——在合成 sysfs 目录树上比较"列出全部端口再解析 hardware_id"与索引查找
+/// 用法：benchPortLookup [USB 串口数=200] [查找次数=200]
+/// 每次按序列号 + VID:PID 查找一个随机的 USB 串口；另测按物理路径（USB 接口名）查找
+
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "bench_util.h"
+#include "serialport/device_watcher.h"
+#include "serialport/port_enumerator.h"
+#include "sysfs_fixture.h"
+
+namespace
+{
+/**
+ * @brief 对 keys 中的每个下标调用一次 fn，打印单次耗时分位数与命中数
+ * @param fn 参数为 USB 串口序号，返回是否找到了正确的端口
+ */
+template <typename Fn>
+void measure(const char* label, const std::vector<size_t>& keys, Fn fn)
+{
+  std::vector<int64_t> samples;
+  size_t found = 0;
+  for (size_t k : keys)
+  {
+    const int64_t start = bench::nowNs();
+    if (fn(k)) ++found;
+    samples.push_back(bench::nowNs() - start);
+  }
+  bench::printPercentiles(label, samples, 1000.0, "us");
+  if (found != keys.size()) std::printf("%-34s only %zu/%zu found\n", "", found, keys.size());
+}
+
+/// @brief 原调用方的做法：列出全部端口，在 hardware_id 字符串里找 VID:PID 与 SNR=
+bool legacyFind(const std::string& sysfs_root, const std::string& dev_root, size_t k)
+{
+  const std::string serial = "SNR=" + bench::FakeSysfs::serialOf(k);
+  for (const serial::PortInfo& info : bench::legacyListPorts(sysfs_root, dev_root))
+  {
+    const std::string& hw = info.hardware_id;
+    const size_t pos = hw.find(serial);
+    // 序列号须完整匹配（SN00001 不能匹配 SN000012）
+    const bool whole = pos != std::string::npos && (pos + serial.size() == hw.size() || hw[pos + serial.size()] == ' ');
+    if (whole && hw.find("VID:PID=0403:6001") != std::string::npos) return true;
+  }
+  return false;
+}
+
+/// @brief 第 k 个 USB 串口的身份
+DeviceIdentity identityOf(size_t k)
+{
+  DeviceIdentity id;
+  id.vid = 0x0403;
+  id.pid = 0x6001;
+  id.serial = bench::FakeSysfs::serialOf(k);
+  return id;
+}
+
+/// @brief 查找结果是否为第 k 个 USB 串口
+bool isPort(const PortMetadata& meta, size_t k)
+{
+  return meta.serial == bench::FakeSysfs::serialOf(k);
+}
+}  // namespace
+
+int main(int argc, char** argv)
+{
+  const size_t usb_ports = argc > 1 ? static_cast<size_t>(std::atoi(argv[1])) : 200;
+  const size_t lookups = argc > 2 ? static_cast<size_t>(std::atoi(argv[2])) : 200;
+
+  bench::FakeSysfs tree;
+  if (usb_ports == 0 || !tree.create(usb_ports))
+  {
+    std::printf("failed to create the synthetic sysfs tree\n");
+    return 1;
+  }
+  PortEnumerator::Config config;
+  config.sysfs_root = tree.sysfsRoot();
+  config.dev_root = tree.devRoot();
+
+  std::mt19937 rng(7);
+  std::vector<size_t> keys(lookups);
+  for (size_t& k : keys) k = rng() % usb_ports;
+  std::printf("%zu USB ports, %zu lookups by serial + VID:PID\n", usb_ports, lookups);
+
+  measure("list + parse hardware_id", keys,
+          [&](size_t k) { return legacyFind(config.sysfs_root, config.dev_root, k); });
+
+  // 未启用监视：查上次枚举建立的索引，并对命中的端口做一次定点探测确认
+  PortEnumerator unwatched(config);
+  PortMetadata meta;
+  measure("find(), unwatched", keys, [&](size_t k) { return unwatched.find(identityOf(k), meta) && isPort(meta, k); });
+  PortEnumerator::Stats stats = unwatched.stats();
+  std::printf("%-34s lookups %llu, full scans during lookups %llu\n", "",
+              static_cast<unsigned long long>(stats.lookups), static_cast<unsigned long long>(stats.lookup_scans));
+
+  // 启用监视：索引由设备事件维护，直接查索引
+  DeviceWatcher::Config watch_config;
+  watch_config.netlink = false;
+  watch_config.watch_dirs = {config.dev_root};
+  watch_config.dev_root = config.dev_root;
+  watch_config.sysfs_root = config.sysfs_root;
+  PortEnumerator watched(config);
+  if (watched.watch(std::make_shared<DeviceWatcher>(watch_config)))
+  {
+    watched.list();
+    measure("find(), watched", keys, [&](size_t k) { return watched.find(identityOf(k), meta) && isPort(meta, k); });
+    measure("findByPath(), watched", keys, [&](size_t k) {
+      return watched.findByPath(bench::FakeSysfs::interfaceOf(k), meta) && isPort(meta, k);
+    });
+  }
+  measure("findByPath(), unwatched", keys, [&](size_t k) {
+    return unwatched.findByPath(bench::FakeSysfs::interfaceOf(k), meta) && isPort(meta, k);
+  });
+  return 0;
+}
@@ -0,0 +1,158 @@
+/// 说明：多串口规模基准测试——每串口一个读线程与共享 epoll 反应器
+/// 用法：benchReactorScale [串口数=1000] [反应器线程数=4] [轮数=10]
+/// 打开大量伪终端串口，每轮向每个串口写 10 字节，测量全部交付的耗时、进程线程数与空闲唤醒次数；
+/// 会尝试把 RLIMIT_NOFILE 提高到硬上限
+
+#include <dirent.h>
+#include <sys/resource.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "bench_util.h"
+#include "serialport/port_reactor.h"
+#include "serialport/serialport.h"
+
+namespace
+{
+/// @brief 当前进程的线程数
+int threadCount()
+{
+  int n = 0;
+  DIR* dir = ::opendir("/proc/self/task");
+  if (!dir) return -1;
+  while (struct dirent* entry = ::readdir(dir))
+  {
+    if (entry->d_name[0] != '.') ++n;
+  }
+  ::closedir(dir);
+  return n;
+}
+
+/// @brief 进程内所有线程的上下文切换次数（用于统计空闲唤醒）
+uint64_t contextSwitches()
+{
+  FILE* f = std::fopen("/proc/self/status", "r");
+  if (!f) return 0;
+  char line[256];
+  uint64_t total = 0;
+  while (std::fgets(line, sizeof(line), f))
+  {
+    unsigned long long n = 0;
+    if (std::sscanf(line, "voluntary_ctxt_switches: %llu", &n) == 1 ||
+        std::sscanf(line, "nonvoluntary_ctxt_switches: %llu", &n) == 1)
+    {
+      total += n;
+    }
+  }
+  std::fclose(f);
+  return total;
+}
+
+/// @brief 把打开文件数上限提高到硬上限，返回新的软上限
+rlim_t raiseFileLimit()
+{
+  struct rlimit limit;
+  if (::getrlimit(RLIMIT_NOFILE, &limit) != 0) return 0;
+  if (limit.rlim_cur < limit.rlim_max)
+  {
+    limit.rlim_cur = limit.rlim_max;
+    ::setrlimit(RLIMIT_NOFILE, &limit);
+    ::getrlimit(RLIMIT_NOFILE, &limit);
+  }
+  return limit.rlim_cur;
+}
+
+/**
+ * @brief 测量一种读路径
+ * @param reactor 共享反应器，为空时每个串口使用事件驱动模式的专用读线程
+ */
+void run(const char* label, const std::shared_ptr<PortReactor>& reactor, int count, int rounds)
+{
+  std::vector<std::unique_ptr<bench::PtyPair>> ptys;
+  std::vector<std::unique_ptr<SerialPort>> ports;
+  std::atomic<size_t> received{0};
+  const int threads_before = threadCount();
+
+  for (int i = 0; i < count; ++i)
+  {
+    std::unique_ptr<bench::PtyPair> pty(new bench::PtyPair);
+    if (!pty->open())
+    {
+      std::printf("%s: pty %d failed to open (see /proc/sys/kernel/pty/max)\n", label, i);
+      break;
+    }
+    std::unique_ptr<SerialPort> sp(new SerialPort(pty->slave(), 115200));
+    sp->setReadMode(SerialPort::ReadMode::Event).setDataViewCallback([&](const SerialPort::DataView& data) {
+      received.fetch_add(data.size);
+    });
+    if (reactor) sp->setReactor(reactor);
+    if (!sp->open())
+    {
+      std::printf("%s: port %d failed to open (file limit?)\n", label, i);
+      break;
+    }
+    ptys.push_back(std::move(pty));
+    ports.push_back(std::move(sp));
+  }
+  const int opened = static_cast<int>(ports.size());
+  const int threads = threadCount() - threads_before;
+
+  // 空闲 1 秒：所有串口都没有数据时的唤醒次数
+  const uint64_t switches_before = contextSwitches();
+  std::this_thread::sleep_for(std::chrono::seconds(1));
+  uint64_t idle_switches = contextSwitches() - switches_before;
+  if (idle_switches > 0) --idle_switches;  // 扣除主线程自身的一次睡眠
+
+  const size_t target = static_cast<size_t>(opened) * rounds * 10;
+  const int64_t start = bench::nowNs();
+  for (int r = 0; r < rounds; ++r)
+  {
+    for (const auto& pty : ptys)
+    {
+      ssize_t n = ::write(pty->master(), "0123456789", 10);
+      (void)n;
+    }
+  }
+  while (received.load() < target && bench::nowNs() - start < 30000000000LL)
+  {
+    std::this_thread::sleep_for(std::chrono::microseconds(200));
+  }
+  const double elapsed_ms = (bench::nowNs() - start) / 1e6;
+
+  std::printf("%-10s ports %5d  threads %5d  idle wakeups/s %5llu  delivered %zu/%zu in %8.1f ms", label, opened,
+              threads, static_cast<unsigned long long>(idle_switches), received.load(), target, elapsed_ms);
+  if (reactor)
+  {
+    const PortReactor::Stats stats = reactor->stats();
+    std::printf("  (epoll wakeups %llu, events %llu, registered %zu)", static_cast<unsigned long long>(stats.wakeups),
+                static_cast<unsigned long long>(stats.events), stats.registered);
+  }
+  std::printf("\n");
+
+  const int64_t close_start = bench::nowNs();
+  for (const auto& sp : ports) sp->close();
+  std::printf("%-10s close all ports %.1f ms", label, (bench::nowNs() - close_start) / 1e6);
+  if (reactor) std::printf(", registered after close %zu", reactor->stats().registered);
+  std::printf("\n");
+}
+}  // namespace
+
+int main(int argc, char** argv)
+{
+  const int count = argc > 1 ? std::atoi(argv[1]) : 1000;
+  const size_t reactor_threads = argc > 2 ? static_cast<size_t>(std::atoi(argv[2])) : 4;
+  const int rounds = argc > 3 ? std::atoi(argv[3]) : 10;
+  const rlim_t limit = raiseFileLimit();
+  std::printf("ports %d, reactor threads %zu, rounds %d x 10 bytes, RLIMIT_NOFILE %llu\n", count, reactor_threads,
+              rounds, static_cast<unsigned long long>(limit));
+
+  run("dedicated", nullptr, count, rounds);
+  run("reactor", std::make_shared<PortReactor>(reactor_threads), count, rounds);
+  return 0;
+}
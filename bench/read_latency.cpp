@@ -0,0 +1,107 @@
+/// 说明：读路径基准测试——空闲间隔后的首字节延迟，以及线路空闲时读线程每秒被唤醒的次数
+/// 用法：benchReadLatency [轮数=100]
+/// 在伪终端上分别测量轮询模式与事件驱动模式；唤醒次数取自 /proc 中各线程的上下文切换计数（仅 Linux）
+
+#include <dirent.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "bench_util.h"
+#include "serialport/serialport.h"
+
+namespace
+{
+/// @brief 除主线程外所有线程的上下文切换次数之和（自愿 + 非自愿）
+uint64_t otherThreadSwitches()
+{
+  uint64_t total = 0;
+  const std::string self = std::to_string(::getpid());
+  DIR* dir = ::opendir("/proc/self/task");
+  if (!dir) return 0;
+  while (struct dirent* entry = ::readdir(dir))
+  {
+    if (entry->d_name[0] == '.' || self == entry->d_name) continue;
+    std::ifstream status(std::string("/proc/self/task/") + entry->d_name + "/status");
+    std::string line;
+    while (std::getline(status, line))
+    {
+      const size_t colon = line.find(':');
+      if (colon == std::string::npos) continue;
+      const std::string key = line.substr(0, colon);
+      if (key == "voluntary_ctxt_switches" || key == "nonvoluntary_ctxt_switches")
+      {
+        total += std::strtoull(line.c_str() + colon + 1, nullptr, 10);
+      }
+    }
+  }
+  ::closedir(dir);
+  return total;
+}
+
+/// @brief 测量一种读模式
+void run(SerialPort::ReadMode mode, const char* name, int rounds)
+{
+  bench::PtyPair pty;
+  if (!pty.open())
+  {
+    std::printf("%s: cannot create pty\n", name);
+    return;
+  }
+
+  std::atomic<int64_t> arrived_ns{0};
+  SerialPort sp(pty.slave(), 115200);
+  sp.setReadMode(mode).setTimeout(10).setDataViewCallback([&](const SerialPort::DataView&) {
+    if (arrived_ns.load(std::memory_order_relaxed) == 0) arrived_ns.store(bench::nowNs(), std::memory_order_release);
+  });
+  if (!sp.open())
+  {
+    std::printf("%s: open failed\n", name);
+    return;
+  }
+
+  // 首字节延迟：空闲间隔随机取 5 ~ 25ms，覆盖轮询模式读超时与休眠的各个相位
+  std::mt19937 rng(1);
+  std::vector<int64_t> latency;
+  for (int i = 0; i < rounds; ++i)
+  {
+    std::this_thread::sleep_for(std::chrono::microseconds(5000 + rng() % 20000));
+    arrived_ns.store(0, std::memory_order_relaxed);
+    const int64_t sent_ns = bench::nowNs();
+    if (::write(pty.master(), "x", 1) != 1) break;
+    while (arrived_ns.load(std::memory_order_acquire) == 0 && bench::nowNs() - sent_ns < 1000000000LL)
+    {
+      std::this_thread::yield();
+    }
+    const int64_t got_ns = arrived_ns.load(std::memory_order_acquire);
+    if (got_ns != 0) latency.push_back(got_ns - sent_ns);
+  }
+  bench::printPercentiles((std::string(name) + " first-byte latency").c_str(), latency, 1000.0, "us");
+
+  // 空闲唤醒：线路静默 1 秒，期间主线程只休眠一次
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  const uint64_t before = otherThreadSwitches();
+  const int64_t start_ns = bench::nowNs();
+  std::this_thread::sleep_for(std::chrono::seconds(1));
+  const double seconds = (bench::nowNs() - start_ns) / 1e9;
+  const uint64_t after = otherThreadSwitches();
+  std::printf("%-34s %.1f wakeups/s\n", (std::string(name) + " idle").c_str(), (after - before) / seconds);
+
+  sp.close();
+}
+}  // namespace
+
+int main(int argc, char** argv)
+{
+  const int rounds = argc > 1 ? std::atoi(argv[1]) : 100;
+  run(SerialPort::ReadMode::Polling, "polling", rounds);
+  run(SerialPort::ReadMode::Event, "event", rounds);
+  return 0;
+}
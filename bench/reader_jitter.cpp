@@ -0,0 +1,104 @@
+/// 说明：读线程抖动基准测试——后台 CPU 满载时，默认调度与实时线程配置下的交付延迟
+/// 用法：benchReaderJitter [样本数=2000] [负载线程数=2×CPU 数]
+/// 设备线程每 1ms 写 1 字节，测量写出到数据回调的延迟；设备线程尽量以 SCHED_FIFO 运行（需要 CAP_SYS_NICE），
+/// 使两种配置下只有读线程的调度不同。负载线程为默认优先级的忙循环
+
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+#include "bench_util.h"
+#include "serialport/serialport.h"
+
+namespace
+{
+/**
+ * @brief 测量一种配置
+ * @param label 标签
+ * @param profile 读线程配置
+ * @param hogs 负载线程数
+ * @param samples 样本数
+ */
+void run(const char* label, const SerialPort::ThreadProfile& profile, unsigned hogs, int samples)
+{
+  bench::PtyPair pty;
+  if (!pty.open()) return;
+
+  std::atomic<int64_t> arrived_ns{0};
+  SerialPort sp(pty.slave(), 115200);
+  sp.setReadMode(SerialPort::ReadMode::Event)
+      .setThreadProfile(profile)
+      .setLogCallback([](SerialPort::LogLevel level, const std::string& msg) {
+        if (level != SerialPort::LogLevel::Info) std::printf("  %s\n", msg.c_str());
+      })
+      .setDataViewCallback([&](const SerialPort::DataView&) { arrived_ns.store(bench::nowNs()); });
+  if (!sp.open()) return;
+
+  std::atomic<bool> quit{false};
+  std::vector<std::thread> load;
+  for (unsigned i = 0; i < hogs; ++i)
+  {
+    load.emplace_back([&] {
+      volatile uint64_t spin = 0;
+      while (!quit.load(std::memory_order_relaxed)) spin = spin + 1;
+    });
+  }
+
+  std::vector<int64_t> latency;
+  std::thread device([&] {
+    struct sched_param param;
+    param.sched_priority = 60;
+    if (::pthread_setschedparam(::pthread_self(), SCHED_FIFO, &param) != 0)
+    {
+      std::printf("  note: device thread runs without SCHED_FIFO (no CAP_SYS_NICE)\n");
+    }
+    // 前 100 个样本用于预热（读线程启动时应用配置、锁定内存），不计入结果
+    for (int i = -100; i < samples; ++i)
+    {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      arrived_ns.store(0);
+      const int64_t sent_ns = bench::nowNs();
+      if (::write(pty.master(), "x", 1) != 1) break;
+      // 最多等 100ms，期间让出 CPU，不与读线程争抢
+      while (arrived_ns.load() == 0 && bench::nowNs() - sent_ns < 100000000LL)
+      {
+        std::this_thread::sleep_for(std::chrono::microseconds(50));
+      }
+      const int64_t got_ns = arrived_ns.load();
+      if (i >= 0) latency.push_back(got_ns != 0 ? got_ns - sent_ns : 100000000LL);
+    }
+  });
+  device.join();
+  quit = true;
+  for (std::thread& t : load) t.join();
+  sp.close();
+
+  bench::printPercentiles(label, latency, 1000.0, "us");
+}
+}  // namespace
+
+int main(int argc, char** argv)
+{
+  const int samples = argc > 1 ? std::atoi(argv[1]) : 2000;
+  const unsigned cpus = std::max(1u, std::thread::hardware_concurrency());
+  const unsigned hogs = argc > 2 ? static_cast<unsigned>(std::atoi(argv[2])) : 2 * cpus;
+  std::printf("cpus %u, load threads %u, samples %d (latency: write -> data callback)\n", cpus, hogs, samples);
+
+  SerialPort::ThreadProfile realtime;
+  realtime.cpus = {0};
+  realtime.policy = SerialPort::SchedPolicy::Fifo;
+  realtime.priority = 50;
+  realtime.lock_memory = true;
+  realtime.prefault = true;
+
+  run("default, idle", SerialPort::ThreadProfile(), 0, samples);
+  run("default, cpu hog", SerialPort::ThreadProfile(), hogs, samples);
+  run("realtime, cpu hog", realtime, hogs, samples);
+  return 0;
+}
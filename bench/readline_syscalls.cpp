@@ -0,0 +1,150 @@
+/// 说明：逐行读取的系统调用次数基准测试——原逐字节 readline 与带预读缓冲的 readline
+/// 用法：benchReadlineSyscalls [行数=2000] [行长=64]
+/// 在本程序中替换 read/pselect/poll（dlsym 转发给 libc），只统计读线程发出的调用；
+/// "before" 在同一串口 fd 上复现原 Serial::readline 的做法：每字节一次非阻塞 read，读不到时 pselect 等待后再 read
+
+#include <dlfcn.h>
+#include <poll.h>
+#include <sys/select.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <thread>
+
+#include <serial/serial.h>
+
+#include "bench_util.h"
+
+namespace
+{
+thread_local bool t_counting = false;  ///< 当前线程是否计数
+thread_local uint64_t t_reads = 0;     ///< read 次数
+thread_local uint64_t t_waits = 0;     ///< pselect/select/poll 次数
+
+/// @brief 取得 libc 中被替换的函数
+template <typename Fn>
+Fn next(const char* name)
+{
+  return reinterpret_cast<Fn>(::dlsym(RTLD_NEXT, name));
+}
+}  // namespace
+
+extern "C" ssize_t read(int fd, void* buf, size_t count)
+{
+  static const auto real = next<ssize_t (*)(int, void*, size_t)>("read");
+  if (t_counting) ++t_reads;
+  return real(fd, buf, count);
+}
+
+extern "C" int pselect(int nfds, fd_set* readfds, fd_set* writefds, fd_set* exceptfds, const struct timespec* timeout,
+                       const sigset_t* sigmask)
+{
+  static const auto real =
+      next<int (*)(int, fd_set*, fd_set*, fd_set*, const struct timespec*, const sigset_t*)>("pselect");
+  if (t_counting) ++t_waits;
+  return real(nfds, readfds, writefds, exceptfds, timeout, sigmask);
+}
+
+extern "C" int select(int nfds, fd_set* readfds, fd_set* writefds, fd_set* exceptfds, struct timeval* timeout)
+{
+  static const auto real = next<int (*)(int, fd_set*, fd_set*, fd_set*, struct timeval*)>("select");
+  if (t_counting) ++t_waits;
+  return real(nfds, readfds, writefds, exceptfds, timeout);
+}
+
+extern "C" int poll(struct pollfd* fds, nfds_t nfds, int timeout)
+{
+  static const auto real = next<int (*)(struct pollfd*, nfds_t, int)>("poll");
+  if (t_counting) ++t_waits;
+  return real(fds, nfds, timeout);
+}
+
+namespace
+{
+/// @brief 原 SerialImpl::read(buf, 1)：先非阻塞读一次，读不到再等待可读后读取
+bool legacyReadByte(int fd, uint8_t* byte, uint32_t timeout_ms)
+{
+  if (::read(fd, byte, 1) == 1) return true;
+  fd_set readfds;
+  FD_ZERO(&readfds);
+  FD_SET(fd, &readfds);
+  struct timespec ts;
+  ts.tv_sec = timeout_ms / 1000;
+  ts.tv_nsec = (timeout_ms % 1000) * 1000000L;
+  if (::pselect(fd + 1, &readfds, nullptr, nullptr, &ts, nullptr) <= 0) return false;
+  return ::read(fd, byte, 1) == 1;
+}
+
+/// @brief 原 Serial::readline：逐字节读取，每字节构造临时字符串与 eol 比较
+std::string legacyReadline(int fd, size_t size, const std::string& eol)
+{
+  std::string line;
+  while (line.size() < size)
+  {
+    uint8_t byte;
+    if (!legacyReadByte(fd, &byte, 100)) break;
+    line.push_back(static_cast<char>(byte));
+    if (line.size() >= eol.size() && line.compare(line.size() - eol.size(), eol.size(), eol) == 0) break;
+  }
+  return line;
+}
+
+/**
+ * @brief 测量一种读法
+ * @param paced true 时设备每 200us 发一行（读者经常要等待），false 时设备尽快写出（读者面前总有积压）
+ */
+void run(bool legacy, bool paced, int lines, size_t line_len)
+{
+  bench::PtyPair pty;
+  if (!pty.open()) return;
+  serial::Serial port(pty.slave(), 115200, serial::Timeout::simpleTimeout(100));
+
+  // 设备端：写出 lines 行，每行 line_len 字节（含换行）
+  std::thread device([&] {
+    std::string line(line_len - 1, 'a');
+    line.push_back('\n');
+    for (int i = 0; i < lines; ++i)
+    {
+      for (size_t off = 0; off < line.size();)
+      {
+        ssize_t n = ::write(pty.master(), line.data() + off, line.size() - off);
+        if (n <= 0) return;
+        off += static_cast<size_t>(n);
+      }
+      if (paced) std::this_thread::sleep_for(std::chrono::microseconds(200));
+    }
+  });
+
+  int got = 0;
+  t_reads = t_waits = 0;
+  t_counting = true;
+  const int64_t start = bench::nowNs();
+  for (; got < lines; ++got)
+  {
+    const std::string line = legacy ? legacyReadline(port.getNativeHandle(), 65536, "\n") : port.readline(65536, "\n");
+    if (line.size() != line_len) break;
+  }
+  const int64_t elapsed = bench::nowNs() - start;
+  t_counting = false;
+  device.join();
+
+  std::printf("%-7s %-7s lines %5d  read/line %7.2f  wait/line %7.2f  syscalls/line %7.2f  %8.0f lines/s\n",
+              legacy ? "before" : "after", paced ? "paced" : "backlog", got, static_cast<double>(t_reads) / got,
+              static_cast<double>(t_waits) / got, static_cast<double>(t_reads + t_waits) / got, got / (elapsed / 1e9));
+}
+}  // namespace
+
+int main(int argc, char** argv)
+{
+  const int lines = argc > 1 ? std::atoi(argv[1]) : 2000;
+  const size_t line_len = argc > 2 ? static_cast<size_t>(std::atoi(argv[2])) : 64;
+  for (bool paced : {false, true})
+  {
+    run(true, paced, lines, line_len);
+    run(false, paced, lines, line_len);
+  }
+  return 0;
+}
@@ -0,0 +1,86 @@
+/// 说明：往返延迟基准测试——伪终端回显设备上 16 字节请求的往返时间，低延迟选项关闭与开启各测一次
+/// 用法：benchRoundTrip [次数=5000]
+/// 伪终端不支持 ASYNC_LOW_LATENCY，也没有 latency_timer，这里主要验证开启选项后在不支持的设备上不出错、不变慢；
+/// 在 USB 转换芯片（如 FTDI）上开启后，latency_timer 从默认 16ms 降到 1ms，往返时间的下降会大得多
+
+#include <poll.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "bench_util.h"
+#include "serialport/serialport.h"
+
+namespace
+{
+/**
+ * @brief 测量一种配置
+ * @param low_latency 是否调用 setLowLatency(true, 1)
+ */
+void run(bool low_latency, int count)
+{
+  bench::PtyPair pty;
+  if (!pty.open()) return;
+
+  // 设备端：收到什么就回写什么
+  std::atomic<bool> quit{false};
+  std::thread echo([&] {
+    char buf[256];
+    struct pollfd pfd;
+    pfd.fd = pty.master();
+    pfd.events = POLLIN;
+    while (!quit.load())
+    {
+      if (::poll(&pfd, 1, 50) <= 0) continue;
+      const ssize_t n = ::read(pty.master(), buf, sizeof(buf));
+      if (n <= 0) break;
+      ssize_t r = ::write(pty.master(), buf, static_cast<size_t>(n));
+      (void)r;
+    }
+  });
+
+  std::atomic<size_t> received{0};
+  SerialPort sp(pty.slave(), 115200);
+  sp.setReadMode(SerialPort::ReadMode::Event)
+      .setLogCallback([](SerialPort::LogLevel, const std::string& msg) { std::printf("  %s\n", msg.c_str()); })
+      .setDataViewCallback([&](const SerialPort::DataView& data) { received.fetch_add(data.size); });
+  if (low_latency) sp.setLowLatency(true, 1);
+  if (sp.open())
+  {
+    const SerialPort::LatencyTuning tuning = sp.latencyTuning();
+    std::printf("low latency %s: ASYNC_LOW_LATENCY %d, latency_timer %d ms (set %d), driver '%s'\n",
+                low_latency ? "on" : "off", tuning.low_latency, tuning.latency_timer_ms, tuning.latency_timer_set,
+                tuning.driver.c_str());
+
+    const std::string request(16, 'p');
+    std::vector<int64_t> rtt;
+    for (int i = 0; i < count; ++i)
+    {
+      const size_t want = received.load() + request.size();
+      const int64_t start = bench::nowNs();
+      if (sp.write(request) != request.size()) break;
+      while (received.load() < want && bench::nowNs() - start < 1000000000LL) std::this_thread::yield();
+      if (received.load() < want) break;
+      rtt.push_back(bench::nowNs() - start);
+    }
+    bench::printPercentiles(low_latency ? "round trip, low latency on" : "round trip, low latency off", rtt, 1000.0,
+                            "us");
+    sp.close();
+  }
+  quit = true;
+  echo.join();
+}
+}  // namespace
+
+int main(int argc, char** argv)
+{
+  const int count = argc > 1 ? std::atoi(argv[1]) : 5000;
+  run(false, count);
+  run(true, count);
+  return 0;
+}
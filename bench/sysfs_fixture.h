@@ -0,0 +1,273 @@
+#pragma once
+#ifndef SERIAL_PORT_BENCH_SYSFS_FIXTURE_H
+#define SERIAL_PORT_BENCH_SYSFS_FIXTURE_H
+
+/// 说明：枚举与查找基准测试共用的合成 sysfs 目录树，以及原 serial::list_ports() 做法的复现（仅 Linux）
+
+#include <fcntl.h>
+#include <ftw.h>
+#include <glob.h>
+#include <stdlib.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <serial/serial.h>
+
+namespace bench
+{
+/**
+ * @brief 临时目录下的合成 sysfs 与设备目录
+ *
+ * 布局与真实系统一致（class/tty 下为指向 devices 的相对链接）：
+ * - 虚拟终端 tty0.. 与 console/ptmx/tty，没有 device 链接；
+ * - 8250 串口 ttyS0..，前 4 个 type 为 4（存在），其余 type 为 0（占位节点）；
+ * - USB 串口 ttyUSB0..，每个挂在独立的 FTDI 设备 1-k 的接口 1-k:1.0 上，序列号为 serialOf(k)，驱动为 ftdi_sio。
+ * 析构时删除整个目录。
+ */
+class FakeSysfs
+{
+ public:
+  FakeSysfs() = default;
+  ~FakeSysfs()
+  {
+    remove();
+  }
+
+  // 禁止复制
+  FakeSysfs(const FakeSysfs&) = delete;
+  FakeSysfs& operator=(const FakeSysfs&) = delete;
+
+  /**
+   * @brief 在 /tmp 下新建目录树
+   * @param usb_ports USB 串口数
+   * @param virtual_ttys 虚拟终端数
+   * @param uarts 8250 串口数（含占位节点）
+   * @return 失败返回 false
+   */
+  bool create(size_t usb_ports, size_t virtual_ttys = 64, size_t uarts = 32)
+  {
+    remove();
+    char dir[] = "/tmp/benchSysfs-XXXXXX";
+    if (!::mkdtemp(dir)) return false;
+    root_ = dir;
+    ok_ = true;
+    makeDirs(devRoot());
+    makeDirs(sysfsRoot() + "/class/tty");
+
+    for (size_t i = 0; i < virtual_ttys; ++i)
+    {
+      const std::string name = "tty" + std::to_string(i);
+      addClass(name, "devices/virtual/tty/" + name);
+    }
+    for (const char* name : {"console", "ptmx", "tty"}) addClass(name, std::string("devices/virtual/tty/") + name);
+
+    for (size_t i = 0; i < uarts; ++i)
+    {
+      const std::string name = "ttyS" + std::to_string(i);
+      const std::string real = "devices/platform/serial8250/tty/" + name;
+      addClass(name, real);
+      writeFile(sysfsRoot() + "/" + real + "/type", i < 4 ? "4" : "0");
+      makeLink("../../..", sysfsRoot() + "/" + real + "/device");
+    }
+
+    makeDirs(sysfsRoot() + "/bus/usb-serial/drivers/ftdi_sio");
+    for (size_t k = 0; k < usb_ports; ++k)
+    {
+      const std::string n = std::to_string(k);
+      const std::string usb = "devices/pci0000:00/usb1/1-" + n;
+      writeFile(sysfsRoot() + "/" + usb + "/idVendor", "0403");
+      writeFile(sysfsRoot() + "/" + usb + "/idProduct", "6001");
+      writeFile(sysfsRoot() + "/" + usb + "/serial", serialOf(k));
+      writeFile(sysfsRoot() + "/" + usb + "/manufacturer", "FTDI");
+      writeFile(sysfsRoot() + "/" + usb + "/product", "FT232R USB UART");
+      writeFile(sysfsRoot() + "/" + usb + "/devnum", n);
+      writeFile(sysfsRoot() + "/" + usb + "/1-" + n + ":1.0/bInterfaceNumber", "00");
+
+      const std::string name = "ttyUSB" + n;
+      const std::string port = usb + "/" + interfaceOf(k) + "/" + name;
+      const std::string real = port + "/tty/" + name;
+      addClass(name, real);
+      makeLink("../../../" + name, sysfsRoot() + "/" + real + "/device");
+      // port 位于 sysfs 下 6 层深处
+      makeLink("../../../../../../bus/usb-serial/drivers/ftdi_sio", sysfsRoot() + "/" + port + "/driver");
+    }
+    return ok_;
+  }
+
+  /**
+   * @brief 删除目录树
+   */
+  void remove()
+  {
+    if (root_.empty()) return;
+    ::nftw(
+        root_.c_str(), [](const char* path, const struct stat*, int, struct FTW*) { return ::remove(path); }, 16,
+        FTW_DEPTH | FTW_PHYS);
+    root_.clear();
+  }
+
+  /// sysfs 挂载点（PortEnumerator::Config::sysfs_root）
+  std::string sysfsRoot() const
+  {
+    return root_ + "/sys";
+  }
+
+  /// 设备节点目录（PortEnumerator::Config::dev_root）
+  std::string devRoot() const
+  {
+    return root_ + "/dev";
+  }
+
+  /// 第 k 个 USB 串口的序列号
+  static std::string serialOf(size_t k)
+  {
+    char buf[32];
+    std::snprintf(buf, sizeof(buf), "SN%05zu", k);
+    return buf;
+  }
+
+  /// 第 k 个 USB 串口的接口目录名（物理路径的最后一段）
+  static std::string interfaceOf(size_t k)
+  {
+    return "1-" + std::to_string(k) + ":1.0";
+  }
+
+ private:
+  /// @brief 逐级创建目录
+  void makeDirs(const std::string& path)
+  {
+    for (size_t pos = root_.size() + 1; pos != std::string::npos;)
+    {
+      pos = path.find('/', pos + 1);
+      const std::string dir = path.substr(0, pos);
+      if (::mkdir(dir.c_str(), 0755) != 0 && errno != EEXIST) ok_ = false;
+    }
+  }
+
+  /// @brief 写入属性文件（带换行，与 sysfs 一致）
+  void writeFile(const std::string& path, const std::string& value)
+  {
+    makeDirs(path.substr(0, path.rfind('/')));
+    std::ofstream out(path.c_str());
+    out << value << "\n";
+    if (!out) ok_ = false;
+  }
+
+  /// @brief 创建符号链接
+  void makeLink(const std::string& target, const std::string& path)
+  {
+    if (::symlink(target.c_str(), path.c_str()) != 0) ok_ = false;
+  }
+
+  /// @brief 登记一个 tty：class/tty 下的链接、devices 下的目录与设备节点
+  void addClass(const std::string& name, const std::string& real)
+  {
+    makeDirs(sysfsRoot() + "/" + real);
+    makeLink("../../" + real, sysfsRoot() + "/class/tty/" + name);
+    writeFile(devRoot() + "/" + name, "");
+  }
+
+ private:
+  std::string root_;  ///< 临时根目录
+  bool ok_{true};     ///< 创建过程中是否全部成功
+};
+
+/// @brief 读文件第一行（原实现：ifstream + getline）
+inline std::string legacyReadLine(const std::string& file)
+{
+  std::ifstream ifs(file.c_str(), std::ifstream::in);
+  std::string line;
+  if (ifs) std::getline(ifs, line);
+  return line;
+}
+
+/// @brief 路径的上一级
+inline std::string legacyDirName(const std::string& path)
+{
+  const size_t pos = path.rfind('/');
+  if (pos == std::string::npos) return path;
+  return pos == 0 ? "/" : path.substr(0, pos);
+}
+
+/// @brief 解析链接后的绝对路径
+inline std::string legacyRealPath(const std::string& path)
+{
+  std::string result;
+  if (char* real = ::realpath(path.c_str(), nullptr))
+  {
+    result = real;
+    ::free(real);
+  }
+  return result;
+}
+
+/// @brief 原 usb_sysfs_friendly_name / usb_sysfs_hw_string：描述与硬件 ID
+inline void legacyUsbInfo(const std::string& usb, std::string& description, std::string& hardware_id)
+{
+  unsigned int devnum = 0;
+  std::istringstream(legacyReadLine(usb + "/devnum")) >> devnum;
+  const std::string manufacturer = legacyReadLine(usb + "/manufacturer");
+  const std::string product = legacyReadLine(usb + "/product");
+  const std::string serial = legacyReadLine(usb + "/serial");
+  if (!manufacturer.empty() || !product.empty() || !serial.empty())
+  {
+    description = manufacturer + " " + product + " " + serial;
+  }
+
+  const std::string serial_number = legacyReadLine(usb + "/serial");
+  const std::string snr = serial_number.empty() ? "" : "SNR=" + serial_number;
+  const std::string vid = legacyReadLine(usb + "/idVendor");
+  const std::string pid = legacyReadLine(usb + "/idProduct");
+  hardware_id = "USB VID:PID=" + vid + ":" + pid + " " + snr;
+}
+
+/**
+ * @brief 原 serial::list_ports()（Linux）的做法：在设备目录上 glob 候选名，逐个 realpath 并用 ifstream 读属性
+ *
+ * 不按 type 剔除 8250 占位节点，与原实现一致。
+ */
+inline std::vector<serial::PortInfo> legacyListPorts(const std::string& sysfs_root, const std::string& dev_root)
+{
+  glob_t found;
+  int flags = 0;
+  for (const char* pattern : {"/ttyACM*", "/ttyS*", "/ttyUSB*", "/tty.*", "/cu.*", "/rfcomm*"})
+  {
+    ::glob((dev_root + pattern).c_str(), flags, nullptr, &found);
+    flags = GLOB_APPEND;
+  }
+
+  std::vector<serial::PortInfo> ports;
+  for (size_t i = 0; i < found.gl_pathc; ++i)
+  {
+    serial::PortInfo info;
+    info.port = found.gl_pathv[i];
+    const std::string name = info.port.substr(info.port.rfind('/') + 1);
+    const std::string sys_device = sysfs_root + "/class/tty/" + name + "/device";
+    struct stat st;
+    if (name.compare(0, 6, "ttyUSB") == 0 || name.compare(0, 6, "ttyACM") == 0)
+    {
+      std::string usb = legacyDirName(legacyRealPath(sys_device));
+      if (name[3] == 'U') usb = legacyDirName(usb);
+      if (::stat(usb.c_str(), &st) == 0) legacyUsbInfo(usb, info.description, info.hardware_id);
+    }
+    else if (::stat((sys_device + "/id").c_str(), &st) == 0)
+    {
+      info.hardware_id = legacyReadLine(sys_device + "/id");
+    }
+    if (info.description.empty()) info.description = name;
+    if (info.hardware_id.empty()) info.hardware_id = "n/a";
+    ports.push_back(info);
+  }
+  ::globfree(&found);
+  return ports;
+}
+}  // namespace bench
+
+#endif  // SERIAL_PORT_BENCH_SYSFS_FIXTURE_H
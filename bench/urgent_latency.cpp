@@ -0,0 +1,111 @@
+/// 说明：紧急通道基准测试——批量发送进行中，紧急短命令从提交到到达设备端的延迟
+/// 用法：benchUrgentLatency [批量字节数=200000] [紧急命令数=20]
+/// 伪终端没有线路速率，设备线程按 921600 波特（约 10.85us/字节）的速度从 master 端读取，模拟线路逐字节排空；
+/// 分别测量不分片（整块写出）与按 1ms、5ms 分片写出时，紧急命令 "!" 被设备读到的延迟
+
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "bench_util.h"
+#include "serialport/serialport.h"
+
+namespace
+{
+const uint32_t kBaudRate = 921600;  ///< 模拟的波特率
+const int64_t kByteTimeNs = 10850;  ///< 每字节线路时间（10 位/字节）
+const char kUrgentByte = '!';       ///< 紧急命令（批量数据中不出现）
+
+/**
+ * @brief 测量一种分片配置
+ * @param slice_us 分片时长（微秒），0 表示不分片
+ */
+void run(uint32_t slice_us, size_t bulk_bytes, int urgent_count)
+{
+  bench::PtyPair pty;
+  if (!pty.open()) return;
+  SerialPort sp(pty.slave(), kBaudRate);
+  // 不分片时整块写出要等线路排空，写超时需覆盖整个批量；事件驱动读模式下读路径不受该超时影响
+  sp.setReadMode(SerialPort::ReadMode::Event).setTimeout(60000).setAsyncWrite(true).setTxSlice(slice_us);
+  if (!sp.open()) return;
+
+  // 设备端：按线路速率读取，记录每个紧急字节被读到的时间
+  const size_t total = bulk_bytes + urgent_count;
+  std::mutex mtx;
+  std::vector<int64_t> seen_ns;
+  std::thread device([&] {
+    char buf[4096];
+    size_t got = 0;
+    const int64_t start = bench::nowNs();
+    while (got < total)
+    {
+      std::this_thread::sleep_for(std::chrono::microseconds(200));
+      const size_t allowed = static_cast<size_t>((bench::nowNs() - start) / kByteTimeNs);
+      if (allowed <= got) continue;
+      const ssize_t n = ::read(pty.master(), buf, std::min(allowed - got, sizeof(buf)));
+      if (n <= 0) break;
+      const int64_t now = bench::nowNs();
+      for (ssize_t i = 0; i < n; ++i)
+      {
+        if (buf[i] != kUrgentByte) continue;
+        std::lock_guard<std::mutex> lock(mtx);
+        seen_ns.push_back(now);
+      }
+      got += static_cast<size_t>(n);
+    }
+  });
+
+  const int64_t start = bench::nowNs();
+  sp.writeAsync(std::string(bulk_bytes, 'b'));
+  // 紧急命令在批量数据写出期间均匀提交
+  const int64_t interval_ns = static_cast<int64_t>(bulk_bytes) * kByteTimeNs / (urgent_count + 1);
+  std::vector<int64_t> sent_ns;
+  for (int i = 0; i < urgent_count; ++i)
+  {
+    std::this_thread::sleep_for(std::chrono::nanoseconds(interval_ns));
+    {
+      std::lock_guard<std::mutex> lock(mtx);
+      sent_ns.push_back(bench::nowNs());
+    }
+    sp.writeAsync(std::string(1, kUrgentByte), nullptr, TxQueue::Priority::Urgent);
+  }
+  device.join();
+  const double elapsed_ms = (bench::nowNs() - start) / 1e6;
+
+  std::vector<int64_t> latency;
+  for (size_t i = 0; i < seen_ns.size() && i < sent_ns.size(); ++i) latency.push_back(seen_ns[i] - sent_ns[i]);
+  char label[64];
+  if (slice_us == 0)
+  {
+    std::snprintf(label, sizeof(label), "no slicing");
+  }
+  else
+  {
+    std::snprintf(label, sizeof(label), "slice %u us", slice_us);
+  }
+  bench::printPercentiles(label, latency, 1e6, "ms");
+
+  const TxQueue::Stats stats = sp.txStats();
+  std::printf("%-34s submit->write p99 %.3f ms, write calls %llu, total %.0f ms\n", "",
+              stats.urgent_latency.percentile(99) / 1e6, static_cast<unsigned long long>(stats.write_calls),
+              elapsed_ms);
+  sp.close();
+}
+}  // namespace
+
+int main(int argc, char** argv)
+{
+  const size_t bulk_bytes = argc > 1 ? static_cast<size_t>(std::atoi(argv[1])) : 200000;
+  const int urgent_count = argc > 2 ? std::atoi(argv[2]) : 20;
+  std::printf("bulk %zu bytes at %u baud (%.0f ms on the wire), %d urgent commands (latency: submit -> device read)\n",
+              bulk_bytes, kBaudRate, bulk_bytes * kByteTimeNs / 1e6, urgent_count);
+  for (uint32_t slice_us : {0u, 1000u, 5000u}) run(slice_us, bulk_bytes, urgent_count);
+  return 0;
+}
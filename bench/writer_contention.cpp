@@ -0,0 +1,133 @@
+/// 说明：多写线程争用基准测试——8 个线程同时调用 write() 的单次耗时
+/// 用法：benchWriterContention [写线程数=8] [每线程写次数=20000]
+/// 两种场景：串口正常打开、读线程同时在收数据；设备不存在、open() 正在重试退避时写线程持续写入（应快速失败，
+/// 而不是等在 open() 的退避睡眠上）
+
+#include <unistd.h>
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "bench_util.h"
+#include "serialport/serialport.h"
+
+namespace
+{
+/**
+ * @brief 启动 writers 个线程，每个线程循环调用 write_once 直到其返回 false，汇总单次耗时
+ * @param write_once 参数为线程序号与本线程已写次数，返回 false 时该线程结束
+ */
+template <typename Fn>
+std::vector<int64_t> runWriters(int writers, Fn write_once, int64_t* wall_ns)
+{
+  std::vector<std::vector<int64_t>> per_thread(writers);
+  std::vector<std::thread> threads;
+  const int64_t start = bench::nowNs();
+  for (int t = 0; t < writers; ++t)
+  {
+    threads.emplace_back([&, t] {
+      std::vector<int64_t>& samples = per_thread[t];
+      for (;;)
+      {
+        const int64_t begin = bench::nowNs();
+        if (!write_once(t, samples.size())) break;
+        samples.push_back(bench::nowNs() - begin);
+      }
+    });
+  }
+  for (std::thread& thread : threads) thread.join();
+  *wall_ns = bench::nowNs() - start;
+
+  std::vector<int64_t> all;
+  for (const std::vector<int64_t>& samples : per_thread) all.insert(all.end(), samples.begin(), samples.end());
+  return all;
+}
+
+/// @brief 串口正常打开、读线程同时收数据时的写入
+void steadyState(int writers, int writes)
+{
+  bench::PtyPair pty;
+  if (!pty.open()) return;
+  SerialPort sp(pty.slave(), 115200);
+  sp.setTimeout(100).setDataViewCallback([](const SerialPort::DataView&) {});
+  if (!sp.open()) return;
+
+  // 设备端：读走写线程的数据，同时回写一些数据让读线程保持忙碌
+  std::atomic<bool> quit{false};
+  std::thread device([&] {
+    char buf[65536];
+    while (!quit.load())
+    {
+      if (::read(pty.master(), buf, sizeof(buf)) <= 0) break;
+      ssize_t n = ::write(pty.master(), "0123456789abcdef", 16);
+      (void)n;
+    }
+  });
+
+  std::vector<std::string> frames;
+  for (int t = 0; t < writers; ++t) frames.emplace_back(16, static_cast<char>('a' + t % 26));
+  std::atomic<uint64_t> short_writes{0};
+  int64_t wall_ns = 0;
+  std::vector<int64_t> samples = runWriters(
+      writers,
+      [&](int t, size_t done) {
+        if (done >= static_cast<size_t>(writes)) return false;
+        if (sp.write(frames[t]) != frames[t].size()) short_writes.fetch_add(1);
+        return true;
+      },
+      &wall_ns);
+
+  char label[64];
+  std::snprintf(label, sizeof(label), "open, %d writers x %d", writers, writes);
+  bench::printPercentiles(label, samples, 1000.0, "us");
+  std::printf("%-34s %.0f writes/s, %llu short writes\n", "", samples.size() / (wall_ns / 1e9),
+              static_cast<unsigned long long>(short_writes.load()));
+
+  quit = true;
+  sp.close();
+  pty.close();  // master 端关闭后设备线程的 read 返回
+  device.join();
+}
+
+/// @brief 设备不存在、open() 正在重试退避时的写入
+void duringOpenBackoff(int writers)
+{
+  const std::string missing = "/tmp/benchWriterContention-" + std::to_string(::getpid()) + "-missing";
+  SerialPort sp(missing, 115200);
+  sp.setReconnectLimit(3).setLogCallback([](SerialPort::LogLevel, const std::string&) {});
+  std::thread opener([&] { sp.open(); });
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));  // 让 open() 进入第一次退避
+
+  int64_t wall_ns = 0;
+  const int64_t end = bench::nowNs() + 1000000000LL;
+  std::atomic<uint64_t> accepted{0};
+  std::vector<int64_t> samples = runWriters(
+      writers,
+      [&](int, size_t) {
+        if (bench::nowNs() >= end) return false;
+        if (sp.write("x") != 0) accepted.fetch_add(1);
+        return true;
+      },
+      &wall_ns);
+  opener.join();
+
+  char label[64];
+  std::snprintf(label, sizeof(label), "open() backoff, %d writers, 1 s", writers);
+  bench::printPercentiles(label, samples, 1000.0, "us");
+  std::printf("%-34s %zu writes, %llu accepted (expected 0: link is down)\n", "", samples.size(),
+              static_cast<unsigned long long>(accepted.load()));
+}
+}  // namespace
+
+int main(int argc, char** argv)
+{
+  const int writers = argc > 1 ? std::atoi(argv[1]) : 8;
+  const int writes = argc > 2 ? std::atoi(argv[2]) : 20000;
+  steadyState(writers, writes);
+  duringOpenBackoff(writers);
+  return 0;
+}
@@ -91,7 +91,7 @@ int main()
 
     if (line == "exit") break;
 
-    sp.write(line + "\r\n");  // 发送回车换行，可按需要调整
+    sp.write({{line.data(), line.size()}, {"\r\n", 2}});  // 发送回车换行（聚集写，不拼接），可按需要调整
   }
 
   // 关闭串口
@@ -0,0 +1,86 @@
+/*!
+ * \file serial/delimiter_scanner.h
+ *
+ * \section DESCRIPTION
+ *
+ * This provides a vectorized scanner for one or more delimiters (single
+ * bytes or short byte sequences). Candidate positions are located with
+ * SSE2/AVX2 on x86-64 or NEON on aarch64, and verified with memcmp. The
+ * vector kernel is chosen once at runtime; other platforms use a scalar
+ * lookup-table fallback.
+ */
+
+#ifndef SERIAL_DELIMITER_SCANNER_H
+#define SERIAL_DELIMITER_SCANNER_H
+
+#include <string>
+#include <vector>
+#include <serial/v8stdint.h>
+
+namespace serial {
+
+/*!
+ * Finds the first occurrence of any of a set of delimiters in a buffer.
+ *
+ * A scanner is immutable after construction and may be shared between
+ * threads.
+ */
+class DelimiterScanner {
+public:
+  /*! Value returned by find when no delimiter was found. */
+  static const size_t npos = static_cast<size_t>(-1);
+
+  /*!
+   * Creates a scanner for a single delimiter.
+   *
+   * \param delimiter A non empty byte sequence, e.g. "\n" or "\r\n".
+   *
+   * \throw std::invalid_argument
+   */
+  explicit DelimiterScanner (const std::string &delimiter);
+
+  /*!
+   * Creates a scanner matching any of several delimiters. When more than
+   * one delimiter matches at the same position the longest one wins.
+   *
+   * \param delimiters A non empty list of non empty byte sequences.
+   *
+   * \throw std::invalid_argument
+   */
+  explicit DelimiterScanner (const std::vector<std::string> &delimiters);
+
+  /*!
+   * Finds the first delimiter that lies completely within the buffer.
+   *
+   * \param data The buffer to scan.
+   * \param size The number of bytes in the buffer.
+   * \param match_length If not NULL, receives the length of the matched
+   * delimiter.
+   *
+   * \return The offset of the first byte of the match, or npos.
+   */
+  size_t
+  find (const uint8_t *data, size_t size, size_t *match_length = NULL) const;
+
+  /*! Returns the length of the longest delimiter. */
+  size_t
+  maxLength () const { return max_length_; }
+
+  /*! Returns the name of the kernel selected at runtime: "avx2", "sse2",
+   *  "neon" or "scalar". */
+  static const char *
+  kernelName ();
+
+private:
+  void
+  init ();
+
+  std::vector<std::string> delimiters_; // Sorted longest first
+  std::string first_bytes_;             // Distinct leading bytes
+  bool first_table_[256];               // Leading byte lookup table
+  size_t max_length_;
+};
+
+} // namespace serial
+
+#endif // SERIAL_DELIMITER_SCANNER_H
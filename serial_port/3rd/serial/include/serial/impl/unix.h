@@ -92,12 +92,32 @@ public:
   void
   waitByteTimes (size_t count);
 
+  uint32_t
+  getByteTimeNs () const;
+
+  void
+  setLowLatency (bool enabled);
+
+  bool
+  getLowLatency () const;
+
+  int
+  getNativeHandle () const;
+
   size_t
   read (uint8_t *buf, size_t size = 1);
 
+  // Waits for at least size bytes (honouring the read timeouts) but takes
+  // up to capacity bytes if they are already available.
+  size_t
+  read (uint8_t *buf, size_t size, size_t capacity);
+
   size_t
   write (const uint8_t *data, size_t length);
 
+  size_t
+  write (const IoVec *buffers, size_t count);
+
   void
   flush ();
 
@@ -207,6 +227,7 @@ private:
   bytesize_t bytesize_;       // Size of the bytes
   stopbits_t stopbits_;       // Stop Bits
   flowcontrol_t flowcontrol_; // Flow Control
+  int low_latency_;           // Requested ASYNC_LOW_LATENCY: -1 untouched, 0 clear, 1 set
 
   // Mutex used to lock the read functions
   pthread_mutex_t read_mutex;
@@ -81,12 +81,29 @@ public:
   void
   waitByteTimes (size_t count);
 
+  uint32_t
+  getByteTimeNs () const;
+
+  void
+  setLowLatency (bool enabled);
+
+  bool
+  getLowLatency () const;
+
   size_t
   read (uint8_t *buf, size_t size = 1);
 
+  // Waits for at least size bytes (honouring the read timeouts) but takes
+  // up to capacity bytes if they are already available.
+  size_t
+  read (uint8_t *buf, size_t size, size_t capacity);
+
   size_t
   write (const uint8_t *data, size_t length);
 
+  size_t
+  write (const IoVec *buffers, size_t count);
+
   void
   flush ();
 
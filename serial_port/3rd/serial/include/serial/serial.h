@@ -50,6 +50,8 @@ __LINE__, (message) )
 
 namespace serial {
 
+class DelimiterScanner;
+
 /*!
  * Enumeration defines the possible bytesizes for the serial port.
  */
@@ -89,6 +91,19 @@ typedef enum {
   flowcontrol_hardware
 } flowcontrol_t;
 
+/*!
+ * Describes one buffer of a scatter-gather write, like struct iovec.
+ *
+ * The memory is only borrowed for the duration of the write call.
+ */
+struct IoVec {
+  /*! Start of the buffer. */
+  const void *data;
+
+  /*! Number of bytes in the buffer. */
+  size_t size;
+};
+
 /*!
  * Structure for setting the timeout of the serial port, times are
  * in milliseconds.
@@ -233,6 +248,75 @@ public:
   void
   waitByteTimes (size_t count);
 
+  /*! Gets the time it takes to transmit a single character at the present
+   * serial settings (start, data, parity and stop bits), in nanoseconds.
+   *
+   * On POSIX this is updated whenever the port is (re)configured, so it is
+   * only meaningful once the port has been opened; 0 is returned before.
+   *
+   * \return Nanoseconds per character on the wire.
+   */
+  uint32_t
+  getByteTimeNs () const;
+
+  /*! Skips the internal read and/or write mutexes.
+   *
+   * Every call normally takes a read mutex, a write mutex or both, so that
+   * several threads may share one Serial object.  When the caller already
+   * guarantees that only one thread ever reads (and, for writes, that
+   * writes are serialized externally) and that open, close and
+   * reconfiguration never race with I/O, the locks are pure overhead on
+   * the hot path and can be elided.
+   *
+   * Must be called while no other thread is using the object.
+   *
+   * \param reads Skip the read mutex.
+   * \param writes Skip the write mutex.
+   */
+  void
+  setLockElision (bool reads, bool writes);
+
+#if !defined(_WIN32)
+  /*! Gets the native file descriptor of the serial port.
+   *
+   * The descriptor stays owned by the Serial object and must not be closed
+   * by the caller. It is meant to be registered with poll/epoll style
+   * multiplexers so the caller can block until the port becomes readable.
+   * Reads smaller than 4096 bytes may leave extra bytes in the read-ahead
+   * buffer, which the descriptor does not report; check available () first,
+   * or read with a buffer of at least 4096 bytes.
+   *
+   * \return The file descriptor, or -1 if the port is not open.
+   */
+  int
+  getNativeHandle () const;
+#endif
+
+  /*! Requests low latency handling from the serial driver.
+   *
+   * On Linux this sets ASYNC_LOW_LATENCY through TIOCSSERIAL each time the
+   * port is opened or reconfigured, so the tty layer pushes received data to
+   * readers immediately instead of deferring it to a work queue.  Drivers
+   * that do not implement TIOCGSERIAL (ptys, many virtual ports) are left
+   * untouched and no error is raised; use getLowLatency to see whether the
+   * flag took effect.  The flag is only touched once this has been called,
+   * the driver default is kept otherwise.  No effect on other platforms.
+   *
+   * \param enabled Set (true) or clear (false) the low latency flag.
+   */
+  void
+  setLowLatency (bool enabled);
+
+  /*! Gets the low latency flag as currently reported by the driver.
+   *
+   * \return true if the port is open and the driver reports
+   * ASYNC_LOW_LATENCY, false otherwise.
+   *
+   * \see Serial::setLowLatency
+   */
+  bool
+  getLowLatency () const;
+
   /*! Read a given amount of bytes from the serial port into a given buffer.
    *
    * The read function will return in one of three cases:
@@ -401,6 +485,27 @@ public:
   size_t
   write (const std::string &data);
 
+  /*! Write several buffers to the serial port as one contiguous stream.
+   *
+   * The buffers are written in order without being copied into a
+   * temporary, on POSIX systems using writev(2).  The write timeout applies
+   * to the total size of all buffers, exactly as if they had been
+   * concatenated and passed to write (const uint8_t *, size_t).
+   *
+   * \param buffers Array of buffer descriptors.
+   *
+   * \param count Number of entries in buffers.
+   *
+   * \return A size_t representing the total number of bytes actually
+   * written; on timeout this may end in the middle of any buffer.
+   *
+   * \throw serial::PortNotOpenedException
+   * \throw serial::SerialException
+   * \throw serial::IOException
+   */
+  size_t
+  write (const IoVec *buffers, size_t count);
+
   /*! Sets the serial port identifier.
    *
    * \param port A const std::string reference containing the address of the
@@ -660,9 +765,30 @@ private:
   class ScopedReadLock;
   class ScopedWriteLock;
 
-  // Read common function
+  // Read-ahead buffer, lets readline and small reads be served from user
+  // space instead of making one read syscall per byte. Only accessed with
+  // the read lock held.
+  std::vector<uint8_t> read_ahead_;
+  size_t read_ahead_begin_;
+  size_t read_ahead_end_;
+
+  // Set by setLockElision, skip the read/write mutexes on every call
+  bool elide_read_lock_;
+  bool elide_write_lock_;
+
+  // Read common function, serves small reads from the read-ahead buffer
   size_t
   read_ (uint8_t *buffer, size_t size);
+  // Copies up to size buffered bytes out of the read-ahead buffer
+  size_t
+  takeReadAhead_ (uint8_t *buffer, size_t size);
+  // Bulk-fills the read-ahead buffer, waiting for at least min_size bytes
+  size_t
+  fillReadAhead_ (size_t min_size);
+  // Reads one line into buffer, appending, see Serial::readline
+  size_t
+  readline_ (std::string &buffer, size_t size, const std::string &eol,
+             const DelimiterScanner &scanner, bool &eol_found);
   // Write common function
   size_t
   write_ (const uint8_t *data, size_t length);
@@ -0,0 +1,256 @@
+/* Vectorized delimiter scanner, see serial/delimiter_scanner.h */
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+#include "serial/delimiter_scanner.h"
+
+#if defined(__x86_64__) || defined(_M_X64)
+# define SERIAL_SCAN_SSE2 1
+# include <emmintrin.h>
+# if defined(__GNUC__)
+#  define SERIAL_SCAN_AVX2 1
+#  include <immintrin.h>
+# endif
+#elif defined(__aarch64__) || defined(_M_ARM64)
+# define SERIAL_SCAN_NEON 1
+# include <arm_neon.h>
+#endif
+
+using std::string;
+using std::vector;
+using serial::DelimiterScanner;
+
+const size_t DelimiterScanner::npos;
+
+namespace {
+
+// Vector kernels handle up to this many distinct leading bytes, larger
+// sets use the lookup table.
+const size_t kMaxVectorNeedles = 8;
+
+// Returns the offset of the first byte that is one of the needles, or size.
+typedef size_t (*candidate_fn) (const uint8_t *data, size_t size,
+                                const uint8_t *needles, size_t count,
+                                const bool *table);
+
+inline unsigned
+count_trailing_zeros (uint64_t mask)
+{
+#if defined(__GNUC__)
+  return static_cast<unsigned> (__builtin_ctzll (mask));
+#else
+  unsigned n = 0;
+  while ((mask & 1) == 0) {
+    mask >>= 1;
+    ++n;
+  }
+  return n;
+#endif
+}
+
+size_t
+scalar_candidate (const uint8_t *data, size_t size, const uint8_t *needles,
+                  size_t count, const bool *table)
+{
+  if (count == 1) {
+    const void *p = std::memchr (data, needles[0], size);
+    return p ? static_cast<size_t> (static_cast<const uint8_t*> (p) - data)
+             : size;
+  }
+  for (size_t i = 0; i < size; ++i) {
+    if (table[data[i]]) {
+      return i;
+    }
+  }
+  return size;
+}
+
+#if defined(SERIAL_SCAN_SSE2)
+size_t
+sse2_candidate (const uint8_t *data, size_t size, const uint8_t *needles,
+                size_t count, const bool *table)
+{
+  __m128i vneedles[kMaxVectorNeedles];
+  for (size_t k = 0; k < count; ++k) {
+    vneedles[k] = _mm_set1_epi8 (static_cast<char> (needles[k]));
+  }
+  size_t i = 0;
+  for (; i + 16 <= size; i += 16) {
+    __m128i block = _mm_loadu_si128 (reinterpret_cast<const __m128i*> (data + i));
+    __m128i hits = _mm_cmpeq_epi8 (block, vneedles[0]);
+    for (size_t k = 1; k < count; ++k) {
+      hits = _mm_or_si128 (hits, _mm_cmpeq_epi8 (block, vneedles[k]));
+    }
+    int mask = _mm_movemask_epi8 (hits);
+    if (mask != 0) {
+      return i + count_trailing_zeros (static_cast<uint64_t> (mask));
+    }
+  }
+  return i + scalar_candidate (data + i, size - i, needles, count, table);
+}
+#endif
+
+#if defined(SERIAL_SCAN_AVX2)
+__attribute__ ((target ("avx2"))) size_t
+avx2_candidate (const uint8_t *data, size_t size, const uint8_t *needles,
+                size_t count, const bool *table)
+{
+  __m256i vneedles[kMaxVectorNeedles];
+  for (size_t k = 0; k < count; ++k) {
+    vneedles[k] = _mm256_set1_epi8 (static_cast<char> (needles[k]));
+  }
+  size_t i = 0;
+  for (; i + 32 <= size; i += 32) {
+    __m256i block = _mm256_loadu_si256 (reinterpret_cast<const __m256i*> (data + i));
+    __m256i hits = _mm256_cmpeq_epi8 (block, vneedles[0]);
+    for (size_t k = 1; k < count; ++k) {
+      hits = _mm256_or_si256 (hits, _mm256_cmpeq_epi8 (block, vneedles[k]));
+    }
+    uint32_t mask = static_cast<uint32_t> (_mm256_movemask_epi8 (hits));
+    if (mask != 0) {
+      return i + count_trailing_zeros (mask);
+    }
+  }
+  return i + sse2_candidate (data + i, size - i, needles, count, table);
+}
+#endif
+
+#if defined(SERIAL_SCAN_NEON)
+size_t
+neon_candidate (const uint8_t *data, size_t size, const uint8_t *needles,
+                size_t count, const bool *table)
+{
+  uint8x16_t vneedles[kMaxVectorNeedles];
+  for (size_t k = 0; k < count; ++k) {
+    vneedles[k] = vdupq_n_u8 (needles[k]);
+  }
+  size_t i = 0;
+  for (; i + 16 <= size; i += 16) {
+    uint8x16_t block = vld1q_u8 (data + i);
+    uint8x16_t hits = vceqq_u8 (block, vneedles[0]);
+    for (size_t k = 1; k < count; ++k) {
+      hits = vorrq_u8 (hits, vceqq_u8 (block, vneedles[k]));
+    }
+    // Narrow each 8-bit lane to 4 bits, giving a 64-bit mask with one
+    // nibble per input byte.
+    uint8x8_t nibbles = vshrn_n_u16 (vreinterpretq_u16_u8 (hits), 4);
+    uint64_t mask = vget_lane_u64 (vreinterpret_u64_u8 (nibbles), 0);
+    if (mask != 0) {
+      return i + (count_trailing_zeros (mask) >> 2);
+    }
+  }
+  return i + scalar_candidate (data + i, size - i, needles, count, table);
+}
+#endif
+
+struct Kernel {
+  candidate_fn fn;
+  const char *name;
+};
+
+Kernel
+select_kernel ()
+{
+  Kernel kernel = { scalar_candidate, "scalar" };
+#if defined(SERIAL_SCAN_SSE2)
+  kernel.fn = sse2_candidate;
+  kernel.name = "sse2";
+#endif
+#if defined(SERIAL_SCAN_AVX2)
+  __builtin_cpu_init ();
+  if (__builtin_cpu_supports ("avx2")) {
+    kernel.fn = avx2_candidate;
+    kernel.name = "avx2";
+  }
+#endif
+#if defined(SERIAL_SCAN_NEON)
+  kernel.fn = neon_candidate;
+  kernel.name = "neon";
+#endif
+  return kernel;
+}
+
+const Kernel &
+active_kernel ()
+{
+  static const Kernel kernel = select_kernel ();
+  return kernel;
+}
+
+bool
+longer_first (const string &a, const string &b)
+{
+  return a.size () > b.size ();
+}
+
+} // namespace
+
+DelimiterScanner::DelimiterScanner (const string &delimiter)
+  : delimiters_ (1, delimiter), max_length_ (0)
+{
+  init ();
+}
+
+DelimiterScanner::DelimiterScanner (const vector<string> &delimiters)
+  : delimiters_ (delimiters), max_length_ (0)
+{
+  init ();
+}
+
+void
+DelimiterScanner::init ()
+{
+  if (delimiters_.empty ()) {
+    throw std::invalid_argument ("DelimiterScanner needs at least one delimiter");
+  }
+  std::stable_sort (delimiters_.begin (), delimiters_.end (), longer_first);
+  std::fill (first_table_, first_table_ + 256, false);
+  for (size_t i = 0; i < delimiters_.size (); ++i) {
+    if (delimiters_[i].empty ()) {
+      throw std::invalid_argument ("DelimiterScanner does not accept an empty delimiter");
+    }
+    uint8_t first = static_cast<uint8_t> (delimiters_[i][0]);
+    if (!first_table_[first]) {
+      first_table_[first] = true;
+      first_bytes_.push_back (static_cast<char> (first));
+    }
+    max_length_ = std::max (max_length_, delimiters_[i].size ());
+  }
+}
+
+size_t
+DelimiterScanner::find (const uint8_t *data, size_t size,
+                        size_t *match_length) const
+{
+  const uint8_t *needles = reinterpret_cast<const uint8_t*> (first_bytes_.data ());
+  const size_t count = first_bytes_.size ();
+  candidate_fn candidate = count <= kMaxVectorNeedles ? active_kernel ().fn
+                                                      : scalar_candidate;
+  size_t pos = 0;
+  while (pos < size) {
+    pos += candidate (data + pos, size - pos, needles, count, first_table_);
+    if (pos >= size) {
+      break;
+    }
+    // Verify the candidate against every delimiter, longest first.
+    for (size_t i = 0; i < delimiters_.size (); ++i) {
+      const string &d = delimiters_[i];
+      if (d.size () <= size - pos &&
+          std::memcmp (data + pos, d.data (), d.size ()) == 0) {
+        if (match_length) {
+          *match_length = d.size ();
+        }
+        return pos;
+      }
+    }
+    ++pos;
+  }
+  return npos;
+}
+
+const char *
+DelimiterScanner::kernelName ()
+{
+  return active_kernel ().name;
+}
@@ -24,6 +24,7 @@
 #endif
 
 #include <sys/select.h>
+#include <sys/uio.h>
 #include <sys/time.h>
 #include <time.h>
 #ifdef __MACH__
@@ -110,8 +111,9 @@ Serial::SerialImpl::SerialImpl (const string &port, unsigned long baudrate,
                                 parity_t parity, stopbits_t stopbits,
                                 flowcontrol_t flowcontrol)
   : port_ (port), fd_ (-1), is_open_ (false), xonxoff_ (false), rtscts_ (false),
-    baudrate_ (baudrate), parity_ (parity),
-    bytesize_ (bytesize), stopbits_ (stopbits), flowcontrol_ (flowcontrol)
+    baudrate_ (baudrate), byte_time_ns_ (0), parity_ (parity),
+    bytesize_ (bytesize), stopbits_ (stopbits), flowcontrol_ (flowcontrol),
+    low_latency_ (-1)
 {
   pthread_mutex_init(&this->read_mutex, NULL);
   pthread_mutex_init(&this->write_mutex, NULL);
@@ -448,6 +450,21 @@ Serial::SerialImpl::reconfigurePort ()
 #endif
   }
 
+  // apply the low latency flag, if requested; drivers without TIOCSSERIAL
+  // support (ptys, most virtual ports) simply keep their default
+#if defined(__linux__) && defined (TIOCSSERIAL) && defined (ASYNC_LOW_LATENCY)
+  if (low_latency_ != -1) {
+    struct serial_struct ser;
+    if (-1 != ioctl (fd_, TIOCGSERIAL, &ser)) {
+      if (low_latency_)
+        ser.flags |= ASYNC_LOW_LATENCY;
+      else
+        ser.flags &= ~ASYNC_LOW_LATENCY;
+      ioctl (fd_, TIOCSSERIAL, &ser);
+    }
+  }
+#endif
+
   // Update byte_time_ based on the new settings.
   uint32_t bit_time_ns = 1e9 / baudrate_;
   byte_time_ns_ = bit_time_ns * (1 + bytesize_ + parity_ + stopbits_);
@@ -534,8 +551,45 @@ Serial::SerialImpl::waitByteTimes (size_t count)
   pselect (0, NULL, NULL, NULL, &wait_time, NULL);
 }
 
+uint32_t
+Serial::SerialImpl::getByteTimeNs () const
+{
+  return byte_time_ns_;
+}
+
+int
+Serial::SerialImpl::getNativeHandle () const
+{
+  return is_open_ ? fd_ : -1;
+}
+
+void
+Serial::SerialImpl::setLowLatency (bool enabled)
+{
+  low_latency_ = enabled ? 1 : 0;
+  if (is_open_)
+    reconfigurePort ();
+}
+
+bool
+Serial::SerialImpl::getLowLatency () const
+{
+#if defined(__linux__) && defined (TIOCGSERIAL) && defined (ASYNC_LOW_LATENCY)
+  struct serial_struct ser;
+  if (is_open_ && -1 != ioctl (fd_, TIOCGSERIAL, &ser))
+    return (ser.flags & ASYNC_LOW_LATENCY) != 0;
+#endif
+  return false;
+}
+
 size_t
 Serial::SerialImpl::read (uint8_t *buf, size_t size)
+{
+  return read (buf, size, size);
+}
+
+size_t
+Serial::SerialImpl::read (uint8_t *buf, size_t size, size_t capacity)
 {
   // If the port is not open, throw
   if (!is_open_) {
@@ -550,7 +604,7 @@ Serial::SerialImpl::read (uint8_t *buf, size_t size)
 
   // Pre-fill buffer with available bytes
   {
-    ssize_t bytes_read_now = ::read (fd_, buf, size);
+    ssize_t bytes_read_now = ::read (fd_, buf, capacity);
     if (bytes_read_now > 0) {
       bytes_read = bytes_read_now;
     }
@@ -580,7 +634,7 @@ Serial::SerialImpl::read (uint8_t *buf, size_t size)
       // This should be non-blocking returning only what is available now
       //  Then returning so that select can block again.
       ssize_t bytes_read_now =
-        ::read (fd_, buf + bytes_read, size - bytes_read);
+        ::read (fd_, buf + bytes_read, capacity - bytes_read);
       // read should always return some data as select reported it was
       // ready to read when we get to this point.
       if (bytes_read_now < 1) {
@@ -592,20 +646,17 @@ Serial::SerialImpl::read (uint8_t *buf, size_t size)
       }
       // Update bytes_read
       bytes_read += static_cast<size_t> (bytes_read_now);
-      // If bytes_read == size then we have read everything we need
-      if (bytes_read == size) {
-        break;
-      }
-      // If bytes_read < size then we have more to read
-      if (bytes_read < size) {
-        continue;
-      }
-      // If bytes_read > size then we have over read, which shouldn't happen
-      if (bytes_read > size) {
+      // If bytes_read > capacity then we have over read, which shouldn't happen
+      if (bytes_read > capacity) {
         throw SerialException ("read over read, too many bytes where "
                                "read, this shouldn't happen, might be "
                                "a logical error!");
       }
+      // If bytes_read >= size then we have read everything we need, any
+      // extra bytes up to capacity were already available
+      if (bytes_read >= size) {
+        break;
+      }
     }
   }
   return bytes_read;
@@ -613,12 +664,30 @@ Serial::SerialImpl::read (uint8_t *buf, size_t size)
 
 size_t
 Serial::SerialImpl::write (const uint8_t *data, size_t length)
+{
+  IoVec buffer = { data, length };
+  return write (&buffer, 1);
+}
+
+size_t
+Serial::SerialImpl::write (const IoVec *buffers, size_t count)
 {
   if (is_open_ == false) {
     throw PortNotOpenedException ("Serial::write");
   }
   fd_set writefds;
   size_t bytes_written = 0;
+  size_t length = 0;
+  for (size_t i = 0; i < count; ++i) {
+    length += buffers[i].size;
+  }
+
+  // Position of the first unwritten byte: buffers[index] at offset
+  size_t index = 0;
+  size_t offset = 0;
+  // Gather at most this many buffers per writev call, on the stack
+  const size_t max_iov = 64;
+  struct iovec iov[max_iov];
 
   // Calculate total timeout in milliseconds t_c + (t_m * N)
   long total_timeout_ms = timeout_.write_timeout_constant;
@@ -662,9 +731,22 @@ Serial::SerialImpl::write (const uint8_t *data, size_t length)
     if (r > 0) {
       // Make sure our file descriptor is in the ready to write list
       if (FD_ISSET (fd_, &writefds)) {
+        // Gather the remaining buffers, starting inside the partially
+        // written one, skipping empty ones
+        int iov_count = 0;
+        for (size_t i = index; i < count && static_cast<size_t> (iov_count) < max_iov; ++i) {
+          const size_t skip = (i == index) ? offset : 0;
+          if (buffers[i].size == skip) {
+            continue;
+          }
+          iov[iov_count].iov_base = const_cast<uint8_t*> (
+            static_cast<const uint8_t*> (buffers[i].data) + skip);
+          iov[iov_count].iov_len = buffers[i].size - skip;
+          ++iov_count;
+        }
+
         // This will write some
-        ssize_t bytes_written_now =
-          ::write (fd_, data + bytes_written, length - bytes_written);
+        ssize_t bytes_written_now = ::writev (fd_, iov, iov_count);
 
         // even though pselect returned readiness the call might still be 
         // interrupted. In that case simply retry.
@@ -689,6 +771,14 @@ Serial::SerialImpl::write (const uint8_t *data, size_t length)
         }
         // Update bytes_written
         bytes_written += static_cast<size_t> (bytes_written_now);
+        // Advance the position past the bytes just written
+        size_t advance = static_cast<size_t> (bytes_written_now);
+        while (index < count && advance >= buffers[index].size - offset) {
+          advance -= buffers[index].size - offset;
+          offset = 0;
+          ++index;
+        }
+        offset += advance;
         // If bytes_written == size then we have written everything we need to
         if (bytes_written == length) {
           break;
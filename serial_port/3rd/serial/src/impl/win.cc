@@ -327,6 +327,31 @@ Serial::SerialImpl::waitByteTimes (size_t /*count*/)
   THROW (IOException, "waitByteTimes is not implemented on Windows.");
 }
 
+uint32_t
+Serial::SerialImpl::getByteTimeNs () const
+{
+  if (baudrate_ == 0) {
+    return 0;
+  }
+  // Same as the POSIX implementation: start bit + data + parity + stop bits
+  double bit_time_ns = 1e9 / baudrate_;
+  double bits = 1 + bytesize_ + (parity_ != parity_none ? 1 : 0);
+  bits += (stopbits_ == stopbits_one_point_five) ? 1.5 : stopbits_;
+  return static_cast<uint32_t> (bits * bit_time_ns);
+}
+
+void
+Serial::SerialImpl::setLowLatency (bool /*enabled*/)
+{
+  // Windows drivers have no equivalent of ASYNC_LOW_LATENCY
+}
+
+bool
+Serial::SerialImpl::getLowLatency () const
+{
+  return false;
+}
+
 size_t
 Serial::SerialImpl::read (uint8_t *buf, size_t size)
 {
@@ -342,6 +367,18 @@ Serial::SerialImpl::read (uint8_t *buf, size_t size)
   return (size_t) (bytes_read);
 }
 
+size_t
+Serial::SerialImpl::read (uint8_t *buf, size_t size, size_t capacity)
+{
+  // Take whatever the driver has already queued, up to capacity, without
+  // waiting for more than size bytes.
+  size_t available_now = available ();
+  if (available_now > size) {
+    size = available_now < capacity ? available_now : capacity;
+  }
+  return read (buf, size);
+}
+
 size_t
 Serial::SerialImpl::write (const uint8_t *data, size_t length)
 {
@@ -357,6 +394,24 @@ Serial::SerialImpl::write (const uint8_t *data, size_t length)
   return (size_t) (bytes_written);
 }
 
+size_t
+Serial::SerialImpl::write (const IoVec *buffers, size_t count)
+{
+  // WriteFile has no gather form for serial handles, write the buffers in
+  // order and stop at the first short write (timeout).  Note that every
+  // WriteFile call gets its own write timeout budget here.
+  size_t total = 0;
+  for (size_t i = 0; i < count; ++i) {
+    const size_t written = write (static_cast<const uint8_t*> (buffers[i].data),
+                                  buffers[i].size);
+    total += written;
+    if (written < buffers[i].size) {
+      break;
+    }
+  }
+  return total;
+}
+
 void
 Serial::SerialImpl::setPort (const string &port)
 {
@@ -1,15 +1,9 @@
 /* Copyright 2012 William Woodall and John Harrison */
 #include <algorithm>
-
-#if !defined(_WIN32) && !defined(__OpenBSD__) && !defined(__FreeBSD__)
-# include <alloca.h>
-#endif
-
-#if defined (__MINGW32__)
-# define alloca __builtin_alloca
-#endif
+#include <cstring>
 
 #include "serial/serial.h"
+#include "serial/delimiter_scanner.h"
 
 #ifdef _WIN32
 #include "serial/impl/win.h"
@@ -25,6 +19,7 @@ using std::size_t;
 using std::string;
 
 using serial::Serial;
+using serial::DelimiterScanner;
 using serial::SerialException;
 using serial::IOException;
 using serial::bytesize_t;
@@ -32,13 +27,20 @@ using serial::parity_t;
 using serial::stopbits_t;
 using serial::flowcontrol_t;
 
+namespace {
+// Size of the read-ahead buffer. Reads at least this large bypass it and go
+// straight into the caller's buffer.
+const size_t kReadAheadSize = 4096;
+}
+
 class Serial::ScopedReadLock {
 public:
-  ScopedReadLock(SerialImpl *pimpl) : pimpl_(pimpl) {
-    this->pimpl_->readLock();
+  ScopedReadLock(SerialImpl *pimpl, bool elide = false)
+    : pimpl_(elide ? NULL : pimpl) {
+    if (this->pimpl_) this->pimpl_->readLock();
   }
   ~ScopedReadLock() {
-    this->pimpl_->readUnlock();
+    if (this->pimpl_) this->pimpl_->readUnlock();
   }
 private:
   // Disable copy constructors
@@ -50,11 +52,12 @@ private:
 
 class Serial::ScopedWriteLock {
 public:
-  ScopedWriteLock(SerialImpl *pimpl) : pimpl_(pimpl) {
-    this->pimpl_->writeLock();
+  ScopedWriteLock(SerialImpl *pimpl, bool elide = false)
+    : pimpl_(elide ? NULL : pimpl) {
+    if (this->pimpl_) this->pimpl_->writeLock();
   }
   ~ScopedWriteLock() {
-    this->pimpl_->writeUnlock();
+    if (this->pimpl_) this->pimpl_->writeUnlock();
   }
 private:
   // Disable copy constructors
@@ -67,7 +70,9 @@ Serial::Serial (const string &port, uint32_t baudrate, serial::Timeout timeout,
                 bytesize_t bytesize, parity_t parity, stopbits_t stopbits,
                 flowcontrol_t flowcontrol)
  : pimpl_(new SerialImpl (port, baudrate, bytesize, parity,
-                                           stopbits, flowcontrol))
+                                           stopbits, flowcontrol)),
+   read_ahead_begin_ (0), read_ahead_end_ (0),
+   elide_read_lock_ (false), elide_write_lock_ (false)
 {
   pimpl_->setTimeout(timeout);
 }
@@ -81,12 +86,14 @@ void
 Serial::open ()
 {
   pimpl_->open ();
+  read_ahead_begin_ = read_ahead_end_ = 0;
 }
 
 void
 Serial::close ()
 {
   pimpl_->close ();
+  read_ahead_begin_ = read_ahead_end_ = 0;
 }
 
 bool
@@ -98,12 +105,17 @@ Serial::isOpen () const
 size_t
 Serial::available ()
 {
-  return pimpl_->available ();
+  ScopedReadLock lock(this->pimpl_, elide_read_lock_);
+  return (read_ahead_end_ - read_ahead_begin_) + pimpl_->available ();
 }
 
 bool
 Serial::waitReadable ()
 {
+  ScopedReadLock lock(this->pimpl_, elide_read_lock_);
+  if (read_ahead_end_ != read_ahead_begin_) {
+    return true;
+  }
   serial::Timeout timeout(pimpl_->getTimeout ());
   return pimpl_->waitReadable(timeout.read_timeout_constant);
 }
@@ -114,54 +126,131 @@ Serial::waitByteTimes (size_t count)
   pimpl_->waitByteTimes(count);
 }
 
+uint32_t
+Serial::getByteTimeNs () const
+{
+  return pimpl_->getByteTimeNs ();
+}
+
+void
+Serial::setLockElision (bool reads, bool writes)
+{
+  elide_read_lock_ = reads;
+  elide_write_lock_ = writes;
+}
+
+#if !defined(_WIN32)
+int
+Serial::getNativeHandle () const
+{
+  return pimpl_->getNativeHandle ();
+}
+#endif
+
+void
+Serial::setLowLatency (bool enabled)
+{
+  pimpl_->setLowLatency (enabled);
+}
+
+bool
+Serial::getLowLatency () const
+{
+  return pimpl_->getLowLatency ();
+}
+
+size_t
+Serial::takeReadAhead_ (uint8_t *buffer, size_t size)
+{
+  size_t n = min (size, read_ahead_end_ - read_ahead_begin_);
+  if (n > 0) {
+    memcpy (buffer, &read_ahead_[read_ahead_begin_], n);
+    read_ahead_begin_ += n;
+  }
+  return n;
+}
+
+size_t
+Serial::fillReadAhead_ (size_t min_size)
+{
+  if (read_ahead_.empty ()) {
+    read_ahead_.resize (kReadAheadSize);
+  }
+  // Move any leftover bytes to the front so the whole tail can be filled
+  if (read_ahead_begin_ == read_ahead_end_) {
+    read_ahead_begin_ = read_ahead_end_ = 0;
+  } else if (read_ahead_begin_ > 0) {
+    memmove (&read_ahead_[0], &read_ahead_[read_ahead_begin_],
+             read_ahead_end_ - read_ahead_begin_);
+    read_ahead_end_ -= read_ahead_begin_;
+    read_ahead_begin_ = 0;
+  }
+  size_t space = read_ahead_.size () - read_ahead_end_;
+  size_t bytes_read = this->pimpl_->read (&read_ahead_[read_ahead_end_],
+                                          min (min_size, space), space);
+  read_ahead_end_ += bytes_read;
+  return bytes_read;
+}
+
 size_t
 Serial::read_ (uint8_t *buffer, size_t size)
 {
-  return this->pimpl_->read (buffer, size);
+  size_t bytes_read = takeReadAhead_ (buffer, size);
+  if (bytes_read == size) {
+    return bytes_read;
+  }
+  size_t remaining = size - bytes_read;
+  if (remaining >= kReadAheadSize) {
+    // Large reads gain nothing from an extra copy
+    return bytes_read + this->pimpl_->read (buffer + bytes_read, remaining);
+  }
+  // Wait for the remaining bytes as before, but also pick up whatever else
+  // has already arrived so later small reads need no syscall.
+  fillReadAhead_ (remaining);
+  return bytes_read + takeReadAhead_ (buffer + bytes_read, remaining);
 }
 
 size_t
 Serial::read (uint8_t *buffer, size_t size)
 {
-  ScopedReadLock lock(this->pimpl_);
-  return this->pimpl_->read (buffer, size);
+  ScopedReadLock lock(this->pimpl_, elide_read_lock_);
+  return this->read_ (buffer, size);
 }
 
 size_t
 Serial::read (std::vector<uint8_t> &buffer, size_t size)
 {
-  ScopedReadLock lock(this->pimpl_);
-  uint8_t *buffer_ = new uint8_t[size];
+  ScopedReadLock lock(this->pimpl_, elide_read_lock_);
+  size_t old_size = buffer.size ();
+  buffer.resize (old_size + size);
   size_t bytes_read = 0;
-
   try {
-    bytes_read = this->pimpl_->read (buffer_, size);
+    bytes_read = this->read_ (size ? &buffer[old_size] : NULL, size);
   }
   catch (const std::exception &e) {
-    delete[] buffer_;
+    buffer.resize (old_size);
     throw;
   }
-
-  buffer.insert (buffer.end (), buffer_, buffer_+bytes_read);
-  delete[] buffer_;
+  buffer.resize (old_size + bytes_read);
   return bytes_read;
 }
 
 size_t
 Serial::read (std::string &buffer, size_t size)
 {
-  ScopedReadLock lock(this->pimpl_);
-  uint8_t *buffer_ = new uint8_t[size];
+  ScopedReadLock lock(this->pimpl_, elide_read_lock_);
+  size_t old_size = buffer.size ();
+  buffer.resize (old_size + size);
   size_t bytes_read = 0;
   try {
-    bytes_read = this->pimpl_->read (buffer_, size);
+    bytes_read = this->read_ (
+      size ? reinterpret_cast<uint8_t*> (&buffer[old_size]) : NULL, size);
   }
   catch (const std::exception &e) {
-    delete[] buffer_;
+    buffer.resize (old_size);
     throw;
   }
-  buffer.append (reinterpret_cast<const char*>(buffer_), bytes_read);
-  delete[] buffer_;
+  buffer.resize (old_size + bytes_read);
   return bytes_read;
 }
 
@@ -174,33 +263,61 @@ Serial::read (size_t size)
 }
 
 size_t
-Serial::readline (string &buffer, size_t size, string eol)
+Serial::readline_ (string &buffer, size_t size, const string &eol,
+                   const DelimiterScanner &scanner, bool &eol_found)
 {
-  ScopedReadLock lock(this->pimpl_);
   size_t eol_len = eol.length ();
-  uint8_t *buffer_ = static_cast<uint8_t*>
-                              (alloca (size * sizeof (uint8_t)));
+  size_t base = buffer.size ();
   size_t read_so_far = 0;
-  while (true)
+  eol_found = false;
+  while (read_so_far < size)
   {
-    size_t bytes_read = this->read_ (buffer_ + read_so_far, 1);
-    read_so_far += bytes_read;
-    if (bytes_read == 0) {
-      break; // Timeout occured on reading 1 byte
+    if (read_ahead_begin_ == read_ahead_end_ && fillReadAhead_ (1) == 0) {
+      break; // Timeout occured while waiting for the next byte
     }
-    if(read_so_far < eol_len) continue;
-    if (string (reinterpret_cast<const char*>
-         (buffer_ + read_so_far - eol_len), eol_len) == eol) {
-      break; // EOL found
+    size_t take = min (read_ahead_end_ - read_ahead_begin_, size - read_so_far);
+    buffer.append (reinterpret_cast<const char*>
+                     (&read_ahead_[read_ahead_begin_]), take);
+
+    size_t line_end = 0; // Length of the line including the EOL, if found
+    if (eol_len == 0) {
+      line_end = read_so_far + 1; // An empty EOL matches after every byte
+    } else {
+      // The bytes scanned before held no EOL, so only one that ends in the
+      // new data can match. It may start up to eol_len - 1 bytes earlier.
+      size_t scan_from = read_so_far >= eol_len ? read_so_far - eol_len + 1 : 0;
+      size_t pos = scanner.find (
+        reinterpret_cast<const uint8_t*> (buffer.data ()) + base + scan_from,
+        read_so_far + take - scan_from);
+      if (pos != DelimiterScanner::npos) {
+        line_end = scan_from + pos + eol_len;
+      }
     }
-    if (read_so_far == size) {
-      break; // Reached the maximum read length
+
+    if (line_end != 0) {
+      // Give the bytes after the EOL back to the read-ahead buffer
+      buffer.resize (base + line_end);
+      read_ahead_begin_ += line_end - read_so_far;
+      read_so_far = line_end;
+      eol_found = true;
+      break; // EOL found
     }
+    read_ahead_begin_ += take;
+    read_so_far += take;
   }
-  buffer.append(reinterpret_cast<const char*> (buffer_), read_so_far);
   return read_so_far;
 }
 
+size_t
+Serial::readline (string &buffer, size_t size, string eol)
+{
+  ScopedReadLock lock(this->pimpl_, elide_read_lock_);
+  // An empty EOL matches after every byte, the scanner itself needs one.
+  DelimiterScanner scanner (eol.empty () ? string (1, '\0') : eol);
+  bool eol_found = false;
+  return this->readline_ (buffer, size, eol, scanner, eol_found);
+}
+
 string
 Serial::readline (size_t size, string eol)
 {
@@ -212,40 +329,23 @@ Serial::readline (size_t size, string eol)
 vector<string>
 Serial::readlines (size_t size, string eol)
 {
-  ScopedReadLock lock(this->pimpl_);
+  ScopedReadLock lock(this->pimpl_, elide_read_lock_);
   std::vector<std::string> lines;
-  size_t eol_len = eol.length ();
-  uint8_t *buffer_ = static_cast<uint8_t*>
-    (alloca (size * sizeof (uint8_t)));
+  // An empty EOL matches after every byte, the scanner itself needs one.
+  DelimiterScanner scanner (eol.empty () ? string (1, '\0') : eol);
   size_t read_so_far = 0;
-  size_t start_of_line = 0;
   while (read_so_far < size) {
-    size_t bytes_read = this->read_ (buffer_+read_so_far, 1);
-    read_so_far += bytes_read;
+    std::string line;
+    bool eol_found = false;
+    size_t bytes_read = this->readline_ (line, size - read_so_far, eol,
+                                         scanner, eol_found);
     if (bytes_read == 0) {
-      if (start_of_line != read_so_far) {
-        lines.push_back (
-          string (reinterpret_cast<const char*> (buffer_ + start_of_line),
-            read_so_far - start_of_line));
-      }
-      break; // Timeout occured on reading 1 byte
-    }
-    if(read_so_far < eol_len) continue;
-    if (string (reinterpret_cast<const char*>
-         (buffer_ + read_so_far - eol_len), eol_len) == eol) {
-      // EOL found
-      lines.push_back(
-        string(reinterpret_cast<const char*> (buffer_ + start_of_line),
-          read_so_far - start_of_line));
-      start_of_line = read_so_far;
+      break; // Timeout occured with no partial line pending
     }
-    if (read_so_far == size) {
-      if (start_of_line != read_so_far) {
-        lines.push_back(
-          string(reinterpret_cast<const char*> (buffer_ + start_of_line),
-            read_so_far - start_of_line));
-      }
-      break; // Reached the maximum read length
+    lines.push_back (line);
+    read_so_far += bytes_read;
+    if (!eol_found) {
+      break; // Timeout occured or reached the maximum read length
     }
   }
   return lines;
@@ -254,7 +354,7 @@ Serial::readlines (size_t size, string eol)
 size_t
 Serial::write (const string &data)
 {
-  ScopedWriteLock lock(this->pimpl_);
+  ScopedWriteLock lock(this->pimpl_, elide_write_lock_);
   return this->write_ (reinterpret_cast<const uint8_t*>(data.c_str()),
                        data.length());
 }
@@ -262,17 +362,24 @@ Serial::write (const string &data)
 size_t
 Serial::write (const std::vector<uint8_t> &data)
 {
-  ScopedWriteLock lock(this->pimpl_);
+  ScopedWriteLock lock(this->pimpl_, elide_write_lock_);
   return this->write_ (&data[0], data.size());
 }
 
 size_t
 Serial::write (const uint8_t *data, size_t size)
 {
-  ScopedWriteLock lock(this->pimpl_);
+  ScopedWriteLock lock(this->pimpl_, elide_write_lock_);
   return this->write_(data, size);
 }
 
+size_t
+Serial::write (const IoVec *buffers, size_t count)
+{
+  ScopedWriteLock lock(this->pimpl_, elide_write_lock_);
+  return pimpl_->write (buffers, count);
+}
+
 size_t
 Serial::write_ (const uint8_t *data, size_t length)
 {
@@ -282,8 +389,8 @@ Serial::write_ (const uint8_t *data, size_t length)
 void
 Serial::setPort (const string &port)
 {
-  ScopedReadLock rlock(this->pimpl_);
-  ScopedWriteLock wlock(this->pimpl_);
+  ScopedReadLock rlock(this->pimpl_, elide_read_lock_);
+  ScopedWriteLock wlock(this->pimpl_, elide_write_lock_);
   bool was_open = pimpl_->isOpen ();
   if (was_open) close();
   pimpl_->setPort (port);
@@ -369,20 +476,22 @@ Serial::getFlowcontrol () const
 
 void Serial::flush ()
 {
-  ScopedReadLock rlock(this->pimpl_);
-  ScopedWriteLock wlock(this->pimpl_);
+  ScopedReadLock rlock(this->pimpl_, elide_read_lock_);
+  ScopedWriteLock wlock(this->pimpl_, elide_write_lock_);
+  read_ahead_begin_ = read_ahead_end_ = 0;
   pimpl_->flush ();
 }
 
 void Serial::flushInput ()
 {
-  ScopedReadLock lock(this->pimpl_);
+  ScopedReadLock lock(this->pimpl_, elide_read_lock_);
+  read_ahead_begin_ = read_ahead_end_ = 0;
   pimpl_->flushInput ();
 }
 
 void Serial::flushOutput ()
 {
-  ScopedWriteLock lock(this->pimpl_);
+  ScopedWriteLock lock(this->pimpl_, elide_write_lock_);
   pimpl_->flushOutput ();
 }
 
@@ -0,0 +1,46 @@
+#pragma once
+#ifndef SERIAL_PORT_CACHE_ALIGNED_H
+#define SERIAL_PORT_CACHE_ALIGNED_H
+
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+#if defined(_WIN32)
+#include <malloc.h>
+#endif
+
+/**
+ * @brief 按缓存行对齐堆分配的基类
+ *
+ * C++11 的全局 operator new 只保证基本对齐（通常 16 字节），带缓存行填充的类用 new 创建时，
+ * 填充只相对于对象起始地址，首尾成员仍可能与相邻的堆数据共享缓存行；
+ * 继承本类后 new/delete 改用按缓存行对齐的分配函数（posix_memalign / _aligned_malloc）。
+ */
+struct CacheAligned
+{
+  static constexpr size_t kCacheLine = 64;  ///< 缓存行大小
+
+  static void* operator new(size_t size)
+  {
+#if defined(_WIN32)
+    void* p = ::_aligned_malloc(size, kCacheLine);
+#else
+    void* p = nullptr;
+    if (::posix_memalign(&p, kCacheLine, size) != 0) p = nullptr;
+#endif
+    if (!p) throw std::bad_alloc();
+    return p;
+  }
+
+  static void operator delete(void* p) noexcept
+  {
+#if defined(_WIN32)
+    ::_aligned_free(p);
+#else
+    ::free(p);
+#endif
+  }
+};
+
+#endif  // SERIAL_PORT_CACHE_ALIGNED_H
@@ -0,0 +1,127 @@
+#pragma once
+#ifndef SERIAL_PORT_COALESCER_H
+#define SERIAL_PORT_COALESCER_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#include "serialport/rx_timestamp.h"
+
+/**
+ * @brief 回调合并器（类似网卡的中断合并）
+ *
+ * 小数据块先暂存，累计达到 min_bytes 字节，或距第一个未交付字节到达已超过 max_delay_us 微秒时，
+ * 一次性交付全部暂存数据；暂存为空且单块已达到 min_bytes 时直接交付，不做复制。
+ * 时间条件只在 feed()/poll() 时检查，调用方需按 deadlineNs() 安排空闲时的唤醒。
+ *
+ * feed()/poll()/flush() 只能在同一个线程中调用；统计计数可在任意线程读取。
+ */
+class CallbackCoalescer
+{
+ public:
+  /// 交付回调类型（参数为合并后数据的只读视图，仅在回调期间有效，以及其中第一块数据的接收时间戳）
+  using DeliverCallback = std::function<void(const uint8_t*, size_t, const RxTimestamp&)>;
+
+  /**
+   * @brief 合并统计信息
+   *
+   * 回调频率可由两次快照之间 callbacks 的差值除以时间间隔得到，
+   * input_chunks / callbacks 即平均合并倍数。
+   */
+  struct Stats
+  {
+    uint64_t input_chunks{0};    ///< 输入的数据块数
+    uint64_t input_bytes{0};     ///< 输入的字节数
+    uint64_t callbacks{0};       ///< 实际交付（回调）次数
+    uint64_t flush_by_size{0};   ///< 因达到字节数交付的次数（含直接交付）
+    uint64_t flush_by_time{0};   ///< 因超过时间窗口交付的次数
+    uint64_t flush_by_close{0};  ///< 停止时交付剩余数据的次数
+    uint64_t total_delay_ns{0};  ///< 累计附加延迟（每次交付时第一个暂存字节的等待时间）
+    uint64_t max_delay_ns{0};    ///< 最大附加延迟
+  };
+
+  /**
+   * @brief 设置合并条件（需在交付线程启动前设置）
+   * @param min_bytes 累计达到该字节数时交付，0 表示关闭合并
+   * @param max_delay_us 第一个未交付字节最多等待的微秒数
+   */
+  void configure(size_t min_bytes, uint32_t max_delay_us);
+
+  /// 是否启用合并
+  bool enabled() const
+  {
+    return min_bytes_ > 0;
+  }
+
+  /**
+   * @brief 输入一段数据，满足条件时交付
+   * @param data 数据起始地址
+   * @param size 数据长度
+   * @param stamp 数据的接收时间戳，随合并后的数据一起交付
+   * @param now_ns 当前时间（steady_clock 纳秒），用于计算附加延迟
+   * @param cb 交付回调
+   */
+  void feed(const uint8_t* data, size_t size, const RxTimestamp& stamp, int64_t now_ns, const DeliverCallback& cb);
+
+  /**
+   * @brief 时间窗口已到时交付暂存数据
+   * @return 发生交付返回 true
+   */
+  bool poll(int64_t now_ns, const DeliverCallback& cb);
+
+  /**
+   * @brief 无条件交付全部暂存数据（交付线程退出前调用）
+   */
+  void flush(int64_t now_ns, const DeliverCallback& cb);
+
+  /**
+   * @brief 暂存数据的交付截止时间
+   * @return steady_clock 纳秒；没有暂存数据时返回 -1
+   */
+  int64_t deadlineNs() const
+  {
+    return pending_.empty() ? -1 : first_ns_ + window_ns_;
+  }
+
+  /**
+   * @brief 获取合并统计信息
+   */
+  Stats stats() const;
+
+  /**
+   * @brief 当前 steady_clock 时间（纳秒）
+   */
+  static int64_t nowNs();
+
+ private:
+  /**
+   * @brief 交付暂存数据并清空
+   */
+  void deliverPending(int64_t now_ns, const DeliverCallback& cb);
+
+  /**
+   * @brief 记录一次交付的附加延迟
+   */
+  void noteDelay(int64_t delay_ns);
+
+ private:
+  size_t min_bytes_{0};           ///< 字节数条件
+  int64_t window_ns_{0};          ///< 时间窗口（纳秒）
+  std::vector<uint8_t> pending_;  ///< 暂存数据（复用，不缩容）
+  int64_t first_ns_{0};           ///< 第一个暂存字节的到达时间
+  RxTimestamp first_stamp_;       ///< 第一个暂存数据块的接收时间戳
+
+  std::atomic<uint64_t> input_chunks_{0};    ///< 输入的数据块数
+  std::atomic<uint64_t> input_bytes_{0};     ///< 输入的字节数
+  std::atomic<uint64_t> callbacks_{0};       ///< 交付次数
+  std::atomic<uint64_t> flush_by_size_{0};   ///< 因字节数交付次数
+  std::atomic<uint64_t> flush_by_time_{0};   ///< 因时间交付次数
+  std::atomic<uint64_t> flush_by_close_{0};  ///< 停止时交付次数
+  std::atomic<uint64_t> total_delay_ns_{0};  ///< 累计附加延迟
+  std::atomic<uint64_t> max_delay_ns_{0};    ///< 最大附加延迟
+};
+
+#endif  // SERIAL_PORT_COALESCER_H
@@ -0,0 +1,389 @@
+#pragma once
+#ifndef SERIAL_PORT_CORO_H
+#define SERIAL_PORT_CORO_H
+
+/**
+ * ================= C++20 协程接口（可选，仅 POSIX） =================
+ *
+ * 需要以 -DSERIALPORT_BUILD_CORO=ON 构建并链接 serialport_coro（C++20），核心库仍为 C++11。
+ *
+ * 顺序式协议代码（发命令、等应答、分支）不必再拆成回调状态机：
+ *    CoExecutor ex;
+ *    SerialPort sp("/dev/ttyUSB0", 115200);
+ *    AsyncSerialPort port(ex, sp);  // 切换为外部事件循环模式，需在 open() 之前构造
+ *    sp.open();
+ *
+ *    CoTask<bool> handshake(AsyncSerialPort &port) {
+ *        co_await port.write("AT\r\n");
+ *        std::string reply = co_await port.readUntil("\r\n", CoExecutor::after(std::chrono::milliseconds(200)));
+ *        co_return reply == "OK\r\n";
+ *    }
+ *    bool ok = ex.run(handshake(port));
+ *
+ * 所有协程都在调用 CoExecutor::run() 的线程中执行；等待由执行器的 poll 循环完成，
+ * 数据到达后直接在同一线程恢复协程，没有每个操作一个线程，也没有线程切换。
+ * ==================================================================
+ */
+
+#include <poll.h>
+
+#include <chrono>
+#include <coroutine>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "serialport/serialport.h"
+
+template <typename T>
+class CoTask;
+
+namespace coro_detail
+{
+/**
+ * @brief 协程结束时恢复等待者（对称转移，不增加调用栈深度）
+ */
+struct FinalAwaiter
+{
+  bool await_ready() const noexcept { return false; }
+
+  template <typename Promise>
+  std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> h) noexcept
+  {
+    std::coroutine_handle<> next = h.promise().continuation;
+    return next ? next : std::noop_coroutine();
+  }
+
+  void await_resume() const noexcept {}
+};
+
+/**
+ * @brief CoTask promise 的公共部分
+ */
+struct PromiseBase
+{
+  std::coroutine_handle<> continuation;  ///< co_await 本任务的协程
+  std::exception_ptr error;              ///< 任务抛出的异常
+
+  std::suspend_always initial_suspend() const noexcept { return {}; }
+  FinalAwaiter final_suspend() const noexcept { return {}; }
+  void unhandled_exception() noexcept { error = std::current_exception(); }
+};
+
+template <typename T>
+struct Promise : PromiseBase
+{
+  std::optional<T> value;  ///< co_return 的结果
+
+  CoTask<T> get_return_object();
+  template <typename U>
+  void return_value(U&& v)
+  {
+    value.emplace(std::forward<U>(v));
+  }
+};
+
+template <>
+struct Promise<void> : PromiseBase
+{
+  CoTask<void> get_return_object();
+  void return_void() const noexcept {}
+};
+
+/**
+ * @brief 启动即运行、结束自动销毁的协程（用于执行器托管的任务）
+ */
+struct Detached
+{
+  struct promise_type
+  {
+    Detached get_return_object() { return Detached{std::coroutine_handle<promise_type>::from_promise(*this)}; }
+    std::suspend_always initial_suspend() const noexcept { return {}; }
+    std::suspend_never final_suspend() const noexcept { return {}; }
+    void return_void() const noexcept {}
+    void unhandled_exception() const noexcept { std::terminate(); }
+  };
+
+  std::coroutine_handle<> handle;  ///< 挂起在起点的协程，交给执行器恢复
+};
+}  // namespace coro_detail
+
+/**
+ * @brief 惰性协程任务：被 co_await（或交给 CoExecutor）时才开始执行
+ *
+ * 结果与异常在 co_await 处取回；任务对象独占协程帧，析构时销毁。
+ */
+template <typename T>
+class CoTask
+{
+ public:
+  using promise_type = coro_detail::Promise<T>;
+
+  CoTask() = default;
+  explicit CoTask(std::coroutine_handle<promise_type> h) : handle_(h) {}
+  CoTask(CoTask&& other) noexcept : handle_(std::exchange(other.handle_, nullptr)) {}
+  CoTask& operator=(CoTask&& other) noexcept
+  {
+    if (this != &other)
+    {
+      if (handle_) handle_.destroy();
+      handle_ = std::exchange(other.handle_, nullptr);
+    }
+    return *this;
+  }
+  CoTask(const CoTask&) = delete;
+  CoTask& operator=(const CoTask&) = delete;
+
+  ~CoTask()
+  {
+    if (handle_) handle_.destroy();
+  }
+
+  bool await_ready() const noexcept { return !handle_ || handle_.done(); }
+
+  std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) noexcept
+  {
+    handle_.promise().continuation = awaiting;
+    return handle_;
+  }
+
+  T await_resume()
+  {
+    if (!handle_) throw std::logic_error("CoTask: awaiting an empty task");
+    promise_type& p = handle_.promise();
+    if (p.error) std::rethrow_exception(p.error);
+    if constexpr (std::is_void_v<T>)
+    {
+      return;
+    }
+    else
+    {
+      return std::move(*p.value);
+    }
+  }
+
+ private:
+  std::coroutine_handle<promise_type> handle_;
+};
+
+template <typename T>
+CoTask<T> coro_detail::Promise<T>::get_return_object()
+{
+  return CoTask<T>(std::coroutine_handle<Promise<T>>::from_promise(*this));
+}
+
+inline CoTask<void> coro_detail::Promise<void>::get_return_object()
+{
+  return CoTask<void>(std::coroutine_handle<Promise<void>>::from_promise(*this));
+}
+
+/**
+ * @brief 单线程协程执行器（poll 循环）
+ *
+ * 维护就绪队列与 fd/定时等待者：run() 依次恢复就绪协程，没有就绪协程时阻塞在 poll 上，
+ * 直到某个 fd 就绪或最早的截止时间到达。执行器本身不是线程安全的，所有调用都应在运行它的线程中进行。
+ */
+class CoExecutor
+{
+ public:
+  using Clock = std::chrono::steady_clock;
+  using Deadline = Clock::time_point;
+
+  /**
+   * @brief 等待 fd 就绪或截止时间的可等待对象，co_await 结果为 true 表示就绪、false 表示超时
+   */
+  class IoAwaiter
+  {
+   public:
+    IoAwaiter(CoExecutor& executor, int fd, short events, Deadline deadline) :
+      executor_(executor), fd_(fd), events_(events), deadline_(deadline)
+    {
+    }
+
+    bool await_ready() const noexcept { return false; }
+    void await_suspend(std::coroutine_handle<> h);
+    bool await_resume() const noexcept { return ready_; }
+
+   private:
+    friend class CoExecutor;
+    CoExecutor& executor_;            ///< 所属执行器
+    int fd_;                          ///< 等待的 fd，-1 表示只等待截止时间
+    short events_;                    ///< 关注的 poll 事件位
+    Deadline deadline_;               ///< 截止时间
+    std::coroutine_handle<> handle_;  ///< 挂起的协程
+    bool ready_{false};               ///< 是否因 fd 就绪而恢复
+  };
+
+  CoExecutor() = default;
+  CoExecutor(const CoExecutor&) = delete;
+  CoExecutor& operator=(const CoExecutor&) = delete;
+
+  /**
+   * @brief 托管一个任务，下次循环时开始执行（任务中未捕获的异常会终止程序）
+   */
+  void spawn(CoTask<void> task);
+
+  /**
+   * @brief 运行事件循环直到任务完成，返回其结果（或重新抛出其异常）
+   *
+   * 期间其他托管任务照常推进；所有任务都在等待而没有任何可等待的事件时抛出 std::logic_error。
+   */
+  template <typename T>
+  T run(CoTask<T> task)
+  {
+    std::optional<std::conditional_t<std::is_void_v<T>, bool, T>> result;
+    std::exception_ptr error;
+    bool done = false;
+    post(runAndStore(std::move(task), result, error, done).handle);
+    while (!done)
+    {
+      if (!runOnce()) throw std::logic_error("CoExecutor: task can never complete");
+    }
+    if (error) std::rethrow_exception(error);
+    if constexpr (std::is_void_v<T>)
+    {
+      return;
+    }
+    else
+    {
+      return std::move(*result);
+    }
+  }
+
+  /**
+   * @brief 运行事件循环直到没有就绪协程也没有等待者
+   */
+  void run();
+
+  /**
+   * @brief 等待 fd 可读（或报告错误/挂断）
+   */
+  IoAwaiter readable(int fd, Deadline deadline = Deadline::max()) { return IoAwaiter(*this, fd, POLLIN, deadline); }
+
+  /**
+   * @brief 等待 fd 可写
+   */
+  IoAwaiter writable(int fd, Deadline deadline = Deadline::max()) { return IoAwaiter(*this, fd, POLLOUT, deadline); }
+
+  /**
+   * @brief 挂起到指定时间
+   */
+  IoAwaiter sleepUntil(Deadline deadline) { return IoAwaiter(*this, -1, 0, deadline); }
+
+  /**
+   * @brief 从现在起经过指定时长后的截止时间
+   */
+  template <typename Rep, typename Period>
+  static Deadline after(std::chrono::duration<Rep, Period> timeout)
+  {
+    return Clock::now() + std::chrono::duration_cast<Clock::duration>(timeout);
+  }
+
+ private:
+  /**
+   * @brief 把协程放入就绪队列
+   */
+  void post(std::coroutine_handle<> h) { ready_.push_back(h); }
+
+  /**
+   * @brief 执行一轮：恢复全部就绪协程，或阻塞等待一次事件
+   * @return 没有任何可推进的工作时返回 false
+   */
+  bool runOnce();
+
+  template <typename T, typename R>
+  static coro_detail::Detached runAndStore(CoTask<T> task, std::optional<R>& result, std::exception_ptr& error,
+                                           bool& done)
+  {
+    try
+    {
+      if constexpr (std::is_void_v<T>)
+      {
+        co_await task;
+        result.emplace(true);
+      }
+      else
+      {
+        result.emplace(co_await task);
+      }
+    }
+    catch (...)
+    {
+      error = std::current_exception();
+    }
+    done = true;
+  }
+
+  static coro_detail::Detached runDetached(CoTask<void> task);
+
+ private:
+  std::deque<std::coroutine_handle<>> ready_;  ///< 就绪队列
+  std::vector<IoAwaiter*> waiters_;            ///< 等待 fd 或截止时间的协程
+};
+
+/**
+ * @brief SerialPort 的协程读写接口
+ *
+ * 构造时把 SerialPort 切换为外部事件循环模式并接管其数据回调，由 CoExecutor 等待串口 fd；
+ * 收到的数据暂存在内部缓冲区中，直到被读取。同一时刻只应有一个协程在读、一个协程在写。
+ * write() 直接以非阻塞方式写 fd，不要与 SerialPort::write() 在其他线程中同时使用；
+ * 数据回调需在执行器线程中执行，因此不要为该串口启用环形缓冲或接收队列。
+ */
+class AsyncSerialPort
+{
+ public:
+  using Deadline = CoExecutor::Deadline;
+
+  /**
+   * @brief 绑定执行器与串口（需在 port.open() 之前构造）
+   */
+  AsyncSerialPort(CoExecutor& executor, SerialPort& port);
+
+  /**
+   * @brief 读取当前可用的数据，没有数据时等待
+   * @param deadline 截止时间
+   * @return 至少 1 字节的数据；超时或串口断开时返回空串
+   */
+  CoTask<std::string> readSome(Deadline deadline = Deadline::max());
+
+  /**
+   * @brief 读取直到遇到分隔符（含分隔符）
+   * @param delim 分隔符，不能为空
+   * @param deadline 截止时间
+   * @return 以分隔符结尾的数据；超时或串口断开时返回空串，已收到的数据留待下次读取
+   */
+  CoTask<std::string> readUntil(std::string delim, Deadline deadline = Deadline::max());
+
+  /**
+   * @brief 写入全部数据，内核缓冲满时等待 fd 可写
+   * @param data 要写入的数据（协程持有其副本）
+   * @param deadline 截止时间
+   * @return 实际写入的字节数；超时或出错时小于 data.size()
+   */
+  CoTask<size_t> write(std::string data, Deadline deadline = Deadline::max());
+
+  /**
+   * @brief 内部缓冲区中尚未读取的字节数
+   */
+  size_t buffered() const { return rx_.size(); }
+
+ private:
+  /**
+   * @brief 等待串口可读并取走数据（含合并缓冲的截止时间）
+   * @return 超时或串口断开时返回 false
+   */
+  CoTask<bool> fill(Deadline deadline);
+
+ private:
+  CoExecutor& executor_;  ///< 执行器
+  SerialPort& port_;      ///< 串口
+  std::string rx_;        ///< 已收到、尚未读取的数据
+};
+
+#endif  // SERIAL_PORT_CORO_H
@@ -0,0 +1,157 @@
+#pragma once
+#ifndef SERIAL_PORT_DEVICE_WATCHER_H
+#define SERIAL_PORT_DEVICE_WATCHER_H
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief USB 串口的稳定身份（插拔后设备节点名可能变化，如 ttyUSB0 -> ttyUSB1，身份不变）
+ */
+struct DeviceIdentity
+{
+  uint16_t vid{0};     ///< USB 厂商号（idVendor），0 表示未设置身份
+  uint16_t pid{0};     ///< USB 产品号（idProduct）
+  std::string serial;  ///< USB 序列号，为空时匹配任意序列号
+  int interface{-1};   ///< USB 接口号（多口转换器的各口共用同一序列号），-1 时匹配任意接口
+
+  /// 是否设置了身份
+  bool valid() const
+  {
+    return vid != 0;
+  }
+
+  /// 另一个设备的身份是否满足本身份的要求
+  bool matches(const DeviceIdentity& other) const
+  {
+    return vid == other.vid && pid == other.pid && (serial.empty() || serial == other.serial) &&
+           (interface < 0 || interface == other.interface);
+  }
+};
+
+/**
+ * @brief 串口设备热插拔监视器（仅 Linux）
+ *
+ * - 监听内核 uevent（netlink），同时用 inotify 监视设备目录（默认 /dev 与 /dev/serial/by-id），
+ *   设备节点出现或消失时在监视线程中通知订阅者；容器等收不到 uevent 的环境下仍可依靠 inotify。
+ * - 内核 uevent 到达时设备节点已由 devtmpfs 创建，但 udev 可能尚未设置权限；
+ *   by-id 链接由 udev 处理完毕后才创建，因此同一次插入通常会收到多个事件。
+ * - 多个串口可共用一个监视器，线程在第一次 subscribe() 时启动：
+ *    auto watcher = std::make_shared<DeviceWatcher>();
+ *    sp.setDeviceWatcher(watcher).setDeviceIdentity(identity).open();
+ *
+ * 按身份查找设备节点由 PortEnumerator::find()/metadata() 完成，监视器只负责事件。
+ * 非 Linux 平台上 subscribe() 总是失败。
+ */
+class DeviceWatcher
+{
+ public:
+  /**
+   * @brief 设备节点事件
+   */
+  struct Event
+  {
+    bool added{false};    ///< true 表示节点出现，false 表示节点消失
+    std::string devnode;  ///< 设备节点路径（如 /dev/ttyUSB1 或 /dev/serial/by-id/... 下的链接）
+  };
+
+  /// 事件回调类型（在监视线程中调用，不应阻塞）
+  using Callback = std::function<void(const Event& event)>;
+
+  /**
+   * @brief 监视器配置
+   */
+  struct Config
+  {
+    bool netlink{true};                                                ///< 是否监听内核 uevent
+    std::vector<std::string> watch_dirs{"/dev", "/dev/serial/by-id"};  ///< inotify 监视的目录（不存在的被忽略）
+    std::string dev_root{"/dev"};                                      ///< uevent 中 DEVNAME 所在的设备目录
+    std::string sysfs_root{"/sys"};                                    ///< sysfs 挂载点
+  };
+
+  DeviceWatcher();
+  explicit DeviceWatcher(const Config& config);
+
+  /**
+   * @brief 析构时停止监视线程
+   */
+  ~DeviceWatcher();
+
+  // 禁止复制与移动
+  DeviceWatcher(const DeviceWatcher&) = delete;
+  DeviceWatcher& operator=(const DeviceWatcher&) = delete;
+
+  /**
+   * @brief 订阅设备节点事件
+   * @param cb 事件回调，在监视线程中调用
+   * @return 订阅号，失败（非 Linux 或 netlink 与 inotify 都不可用）返回 0
+   */
+  uint64_t subscribe(Callback cb);
+
+  /**
+   * @brief 取消订阅
+   *
+   * 返回时保证该回调不再运行，也不会再被调用；不能在事件回调中调用。
+   *
+   * @param id subscribe() 返回的订阅号，未知的订阅号被忽略
+   */
+  void unsubscribe(uint64_t id);
+
+  /// 监视器配置
+  const Config& config() const
+  {
+    return config_;
+  }
+
+ private:
+  /**
+   * @brief 打开 netlink 与 inotify 并启动线程（需持锁）
+   */
+  bool startLocked();
+
+  /**
+   * @brief 停止监视线程
+   */
+  void stop();
+
+  /**
+   * @brief 监视线程主循环
+   */
+  void threadLoop();
+
+  /**
+   * @brief 解析一条 uevent 消息
+   */
+  void handleUevent(const char* msg, size_t size);
+
+  /**
+   * @brief 解析 inotify 事件
+   */
+  void handleInotify(const char* buf, size_t size);
+
+  /**
+   * @brief 通知所有订阅者
+   */
+  void publish(const Event& event);
+
+ private:
+  const Config config_;  ///< 配置
+
+  int netlink_fd_{-1};                        ///< uevent 套接字
+  int inotify_fd_{-1};                        ///< inotify 实例
+  int wakeup_fd_{-1};                         ///< 停止时唤醒监视线程的 eventfd
+  std::map<int, std::string> watch_dirs_;     ///< inotify 监视号 -> 目录
+  std::atomic_bool running_{false};           ///< 线程运行标志
+  std::thread thread_;                        ///< 监视线程
+  uint64_t next_id_{1};                       ///< 下一个订阅号
+  std::map<uint64_t, Callback> subscribers_;  ///< 订阅者
+  std::mutex mtx_;                            ///< 订阅表互斥锁（通知期间持有）
+};
+
+#endif  // SERIAL_PORT_DEVICE_WATCHER_H
@@ -0,0 +1,213 @@
+#pragma once
+#ifndef SERIAL_PORT_FRAME_DECODER_H
+#define SERIAL_PORT_FRAME_DECODER_H
+
+/**
+ * ================= FrameDecoder 使用说明 =================
+ *
+ * 串口读取得到的是任意切分的数据块，帧解码器负责把数据块流还原成完整的帧：
+ *
+ *    - DelimiterFrameDecoder     : 以分隔符结尾的帧（如 "\r\n" 结尾的文本行）
+ *    - FixedLengthFrameDecoder   : 定长帧
+ *    - LengthPrefixedFrameDecoder: 带长度字段的帧（支持 1/2/4 字节大小端与 varint）
+ *
+ * 帧尽量不做复制：完整落在输入数据块内的帧直接以视图交付；
+ * 只有跨数据块的帧才会拼接到解码器内部复用的缓冲区中，缓冲区容量只增不减。
+ *
+ * 一般通过 SerialPort::setFrameDecoder() 使用：
+ *    sp.setFrameDecoder(std::unique_ptr<FrameDecoder>(new DelimiterFrameDecoder("\r\n")))
+ *      .setFrameCallback([](const SerialPort::DataView &frame){ ... });
+ *
+ * =============================================================
+ */
+
+#include <serial/delimiter_scanner.h>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+/**
+ * @brief 流式帧解码器抽象基类
+ *
+ * feed() 与 reset() 只能在同一个线程中调用；统计计数可在任意线程读取。
+ */
+class FrameDecoder
+{
+ public:
+  /// 帧回调函数类型（参数为完整帧的只读视图，仅在回调期间有效）
+  using FrameCallback = std::function<void(const uint8_t*, size_t)>;
+
+  /**
+   * @brief 解码统计信息
+   */
+  struct Stats
+  {
+    uint64_t frames{0};         ///< 已解出的帧数
+    uint64_t dropped_bytes{0};  ///< 因超长或格式错误被丢弃的字节数
+  };
+
+  virtual ~FrameDecoder() = default;
+
+  /**
+   * @brief 输入一段数据，每解析出一帧调用一次回调
+   * @param data 数据起始地址
+   * @param size 数据长度
+   * @param cb 帧回调
+   */
+  virtual void feed(const uint8_t* data, size_t size, const FrameCallback& cb) = 0;
+
+  /**
+   * @brief 丢弃尚未完成的半帧（例如重连之后）
+   */
+  virtual void reset();
+
+  /**
+   * @brief 获取解码统计信息
+   */
+  Stats stats() const;
+
+ protected:
+  /**
+   * @brief 交付一帧并计数
+   */
+  void emit(const uint8_t* data, size_t size, const FrameCallback& cb);
+
+  /**
+   * @brief 记录被丢弃的字节
+   */
+  void drop(size_t size);
+
+ protected:
+  std::vector<uint8_t> pending_;  ///< 跨数据块的半帧拼接缓冲区（复用，不缩容）
+
+ private:
+  std::atomic<uint64_t> frames_{0};         ///< 已解出的帧数
+  std::atomic<uint64_t> dropped_bytes_{0};  ///< 被丢弃的字节数
+};
+
+/**
+ * @brief 分隔符帧解码器
+ *
+ * 以一个分隔符（单字节或多字节序列）作为帧结尾，超过 max_frame 仍未遇到分隔符的数据被丢弃。
+ * 分隔符查找使用 serial::DelimiterScanner（SSE2/AVX2/NEON 向量化，运行时选择）。
+ */
+class DelimiterFrameDecoder : public FrameDecoder
+{
+ public:
+  /**
+   * @brief 构造分隔符帧解码器
+   * @param delimiter 分隔符，不能为空
+   * @param include_delimiter 交付的帧是否包含分隔符本身
+   * @param max_frame 最大帧长（含分隔符），超出后丢弃当前半帧重新同步
+   */
+  explicit DelimiterFrameDecoder(const std::string& delimiter, bool include_delimiter = true,
+                                 size_t max_frame = 65536);
+
+  void feed(const uint8_t* data, size_t size, const FrameCallback& cb) override;
+
+ private:
+  /**
+   * @brief 交付以 end 结尾（含分隔符）的帧
+   */
+  void emitFrame(const uint8_t* data, size_t end, const FrameCallback& cb);
+
+ private:
+  std::string delimiter_;             ///< 分隔符
+  serial::DelimiterScanner scanner_;  ///< 向量化分隔符扫描器
+  bool include_delimiter_;            ///< 交付时是否包含分隔符
+  size_t max_frame_;                  ///< 最大帧长
+};
+
+/**
+ * @brief 基于帧头计算帧长的解码器基类
+ *
+ * 子类只需根据帧头给出整帧长度，拼接、重同步与零拷贝交付由基类完成。
+ */
+class HeaderFrameDecoder : public FrameDecoder
+{
+ public:
+  void feed(const uint8_t* data, size_t size, const FrameCallback& cb) override;
+
+ protected:
+  static constexpr size_t kInvalid = static_cast<size_t>(-1);  ///< 帧头非法，需要丢弃一个字节重新同步
+
+  /**
+   * @brief 根据已有数据计算整帧长度
+   * @param data 从帧起始处开始的数据
+   * @param size 已有数据长度
+   * @param need 当返回 0 时写入继续解析所需的最少总字节数
+   * @return 整帧长度；0 表示数据不足；kInvalid 表示帧头非法
+   */
+  virtual size_t frameLength(const uint8_t* data, size_t size, size_t& need) const = 0;
+
+  explicit HeaderFrameDecoder(size_t max_frame) : max_frame_(max_frame) {}
+
+ private:
+  size_t max_frame_;  ///< 最大帧长
+};
+
+/**
+ * @brief 定长帧解码器
+ */
+class FixedLengthFrameDecoder : public HeaderFrameDecoder
+{
+ public:
+  /**
+   * @brief 构造定长帧解码器
+   * @param frame_size 每帧字节数，必须大于 0
+   */
+  explicit FixedLengthFrameDecoder(size_t frame_size);
+
+ protected:
+  size_t frameLength(const uint8_t* data, size_t size, size_t& need) const override;
+
+ private:
+  size_t frame_size_;  ///< 帧长
+};
+
+/**
+ * @brief 长度前缀帧解码器
+ *
+ * 帧格式：[length_offset 字节的前导头][长度字段][长度值 + length_adjust 字节的剩余部分]
+ * 交付的帧包含前导头与长度字段，调用方可按需跳过。
+ */
+class LengthPrefixedFrameDecoder : public HeaderFrameDecoder
+{
+ public:
+  /**
+   * @brief 长度字段编码方式
+   */
+  enum class LengthField
+  {
+    Uint8,     ///< 1 字节无符号
+    Uint16LE,  ///< 2 字节小端
+    Uint16BE,  ///< 2 字节大端
+    Uint32LE,  ///< 4 字节小端
+    Uint32BE,  ///< 4 字节大端
+    Varint     ///< LEB128 变长整数（protobuf 风格，最多 5 字节）
+  };
+
+  /**
+   * @brief 构造长度前缀帧解码器
+   * @param field 长度字段编码方式
+   * @param length_offset 长度字段之前的前导字节数（如同步头、类型字节）
+   * @param length_adjust 长度值的修正量：长度字段之后剩余字节数 = 长度值 + length_adjust（如 CRC 尾）
+   * @param max_frame 最大帧长，超出视为非法帧头并重新同步
+   */
+  explicit LengthPrefixedFrameDecoder(LengthField field, size_t length_offset = 0, int64_t length_adjust = 0,
+                                      size_t max_frame = 65536);
+
+ protected:
+  size_t frameLength(const uint8_t* data, size_t size, size_t& need) const override;
+
+ private:
+  LengthField field_;      ///< 长度字段编码方式
+  size_t length_offset_;   ///< 长度字段偏移
+  int64_t length_adjust_;  ///< 长度修正量
+};
+
+#endif  // SERIAL_PORT_FRAME_DECODER_H
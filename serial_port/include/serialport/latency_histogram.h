@@ -0,0 +1,95 @@
+#pragma once
+#ifndef SERIAL_PORT_LATENCY_HISTOGRAM_H
+#define SERIAL_PORT_LATENCY_HISTOGRAM_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief 对数-线性延迟直方图（纳秒）
+ *
+ * 每个 2 的幂区间再线性等分为 16 个桶，相对误差不超过 1/16，覆盖 0 ~ 2^48 ns（约 78 小时），
+ * 更大的值计入最后一个桶。记录只做几次无锁原子加法，可在热路径中调用；
+ * snapshot() 可在任意线程随时调用，无需停止记录（快照内各计数之间不保证严格一致）。
+ */
+class LatencyHistogram
+{
+ public:
+  static constexpr size_t kSubBuckets = 16;                             ///< 每个 2 的幂区间的线性桶数
+  static constexpr size_t kMaxExponent = 47;                            ///< 最大区间指数
+  static constexpr size_t kBuckets = (kMaxExponent - 2) * kSubBuckets;  ///< 桶总数
+
+  /**
+   * @brief 直方图快照
+   */
+  struct Snapshot
+  {
+    uint64_t count{0};              ///< 样本数
+    uint64_t sum_ns{0};             ///< 样本总和
+    uint64_t min_ns{0};             ///< 最小值
+    uint64_t max_ns{0};             ///< 最大值
+    std::vector<uint64_t> buckets;  ///< 各桶计数（下标含义见 bucketLowerBound）
+
+    /// 平均值（纳秒）
+    double mean() const
+    {
+      return count ? static_cast<double>(sum_ns) / static_cast<double>(count) : 0.0;
+    }
+
+    /**
+     * @brief 估算分位数
+     * @param p 分位（0 ~ 100，如 99.9）
+     * @return 所在桶的上界（不超过 max_ns），无样本时返回 0
+     */
+    uint64_t percentile(double p) const;
+  };
+
+  LatencyHistogram();
+
+  // 禁止复制与移动
+  LatencyHistogram(const LatencyHistogram&) = delete;
+  LatencyHistogram& operator=(const LatencyHistogram&) = delete;
+
+  /**
+   * @brief 记录一个样本
+   * @param value_ns 样本值（纳秒），负数按 0 记录
+   */
+  void record(int64_t value_ns);
+
+  /**
+   * @brief 清空所有样本（与 record() 并发时可能漏掉少量样本）
+   */
+  void reset();
+
+  /**
+   * @brief 获取快照
+   */
+  Snapshot snapshot() const;
+
+  /**
+   * @brief 桶下标对应的下界（纳秒，含）
+   */
+  static uint64_t bucketLowerBound(size_t index);
+
+  /**
+   * @brief 桶下标对应的上界（纳秒，不含）
+   */
+  static uint64_t bucketUpperBound(size_t index);
+
+ private:
+  /**
+   * @brief 计算样本所在的桶下标
+   */
+  static size_t bucketIndex(uint64_t value);
+
+ private:
+  std::atomic<uint64_t> buckets_[kBuckets];  ///< 各桶计数
+  std::atomic<uint64_t> count_{0};           ///< 样本数
+  std::atomic<uint64_t> sum_{0};             ///< 样本总和
+  std::atomic<uint64_t> min_{UINT64_MAX};    ///< 最小值
+  std::atomic<uint64_t> max_{0};             ///< 最大值
+};
+
+#endif  // SERIAL_PORT_LATENCY_HISTOGRAM_H
@@ -0,0 +1,239 @@
+#pragma once
+#ifndef SERIAL_PORT_PORT_ENUMERATOR_H
+#define SERIAL_PORT_PORT_ENUMERATOR_H
+
+#include <serial/serial.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "serialport/device_watcher.h"
+
+/**
+ * @brief 结构化的串口元数据（数值字段直接取自 sysfs，无需解析 hardware_id 字符串）
+ */
+struct PortMetadata
+{
+  std::string port;           ///< 设备节点路径（如 /dev/ttyUSB0）
+  std::string description;    ///< 描述（与 serial::PortInfo 相同）
+  std::string hardware_id;    ///< 硬件 ID 字符串（与 serial::PortInfo 相同）
+  uint16_t vid{0};            ///< USB 厂商号，非 USB 串口为 0
+  uint16_t pid{0};            ///< USB 产品号
+  std::string serial;         ///< USB 序列号
+  int interface{-1};          ///< USB 接口号，非 USB 串口为 -1
+  std::string manufacturer;   ///< USB 厂商名
+  std::string product;        ///< USB 产品名
+  std::string driver;         ///< 驱动名（如 ftdi_sio、cdc_acm、serial8250）
+  std::string physical_path;  ///< 物理路径：sysfs 中相对 devices 的路径（USB 串口为接口目录），插拔后不变
+  int latency_timer_ms{-1};   ///< usb-serial 转换芯片的 latency_timer（毫秒），没有该属性时为 -1
+
+  /// 对应的设备身份
+  DeviceIdentity identity() const
+  {
+    DeviceIdentity id;
+    id.vid = vid;
+    id.pid = pid;
+    id.serial = serial;
+    id.interface = interface;
+    return id;
+  }
+
+  /// 转换为 serial 库的端口信息
+  serial::PortInfo toPortInfo() const
+  {
+    serial::PortInfo info;
+    info.port = port;
+    info.description = description;
+    info.hardware_id = hardware_id;
+    return info;
+  }
+};
+
+/**
+ * @brief 基于 sysfs 的串口枚举器（仅 Linux）
+ *
+ * - 从 /sys/class/tty 出发，只处理带 device 链接的 tty（虚拟终端没有），
+ *   并在做任何逐口工作之前按 type 属性剔除不存在的 8250 端口（大量的 ttyS 占位节点）。
+ * - 逐口属性以 openat/readlinkat 等系统调用相对于已打开的目录读取，不经过 ifstream 与 realpath；
+ *   端口较多时分给多个线程并行读取。结果与 serial::list_ports() 的格式相同。
+ * - 调用 watch() 后结果被缓存，设备节点出现或消失时只增量更新对应条目，之后的 list() 不再访问 sysfs；
+ *   未启用监视时每次 list() 都重新枚举。
+ * - 按序列号、VID:PID 与物理路径维护索引，find()/findByPath() 不做完整枚举：
+ *   启用监视时直接查索引；未启用时查上次枚举建立的索引，并对命中的端口做一次定点探测确认，
+ *   查不到或已失效时才重新枚举一次。
+ *
+ * 非 Linux 平台上 list() 直接调用 serial::list_ports()。
+ */
+class PortEnumerator
+{
+ public:
+  /**
+   * @brief 枚举器配置
+   */
+  struct Config
+  {
+    std::string sysfs_root{"/sys"};  ///< sysfs 挂载点
+    std::string dev_root{"/dev"};    ///< 设备节点目录
+    size_t threads{0};               ///< 并行读取属性的线程数，0 表示按 CPU 数（最多 8）
+    size_t parallel_min_ports{64};   ///< 候选端口数达到该值才并行读取
+  };
+
+  /**
+   * @brief 枚举统计信息
+   */
+  struct Stats
+  {
+    uint64_t full_scans{0};    ///< 完整枚举次数
+    uint64_t cache_hits{0};    ///< 直接由缓存返回的次数
+    uint64_t incremental{0};   ///< 由设备事件增量更新的次数
+    int64_t last_scan_ns{0};   ///< 最近一次完整枚举耗时
+    size_t candidates{0};      ///< 最近一次完整枚举中经过筛选、需要读取属性的端口数
+    uint64_t lookups{0};       ///< 按身份或物理路径查找的次数
+    uint64_t lookup_scans{0};  ///< 查找时因索引过期或未命中而完整枚举的次数
+  };
+
+  PortEnumerator();
+  explicit PortEnumerator(const Config& config);
+
+  /**
+   * @brief 析构时取消对设备事件的订阅
+   */
+  ~PortEnumerator();
+
+  // 禁止复制与移动
+  PortEnumerator(const PortEnumerator&) = delete;
+  PortEnumerator& operator=(const PortEnumerator&) = delete;
+
+  /**
+   * @brief 列出当前可用串口（按端口路径排序）
+   */
+  std::vector<serial::PortInfo> list();
+
+  /**
+   * @brief 列出当前可用串口的元数据（按端口路径排序）
+   */
+  std::vector<PortMetadata> listMetadata();
+
+  /**
+   * @brief 按身份查找串口（索引查找，不做完整枚举）
+   * @param identity 设备身份，序列号为空时按 VID:PID 查找
+   * @param meta 输出：找到的端口（多个满足时取端口路径最小的一个）
+   * @return 找不到时返回 false
+   */
+  bool find(const DeviceIdentity& identity, PortMetadata& meta);
+
+  /**
+   * @brief 按物理路径查找串口（索引查找，不做完整枚举）
+   * @param physical_path 完整的物理路径，或其最后一段（如 USB 接口 1-1.2:1.0）
+   * @param meta 输出：找到的端口
+   * @return 找不到时返回 false
+   */
+  bool findByPath(const std::string& physical_path, PortMetadata& meta);
+
+  /**
+   * @brief 读取单个设备节点的元数据（定点探测 sysfs，不使用也不更新缓存）
+   * @param port 设备节点路径，可以是指向它的链接（如 by-id 链接）
+   * @param meta 输出：端口元数据
+   * @return 不是可用串口时返回 false
+   */
+  bool metadata(const std::string& port, PortMetadata& meta) const;
+
+  /**
+   * @brief 设置 usb-serial 转换芯片的 latency_timer（写 sysfs，需要相应权限）
+   * @param port 设备节点路径，可以是指向它的链接（如 by-id 链接）
+   * @param ms 目标值（毫秒）
+   * @return 没有该属性或写入失败时返回 false，errno 为失败原因
+   */
+  bool setLatencyTimer(const std::string& port, uint32_t ms) const;
+
+  /**
+   * @brief 订阅设备事件并启用缓存
+   * @param watcher 热插拔监视器，其设备目录应与本枚举器的 dev_root 一致
+   * @return 订阅失败（监视器不可用）时返回 false，此时不启用缓存
+   */
+  bool watch(std::shared_ptr<DeviceWatcher> watcher);
+
+  /**
+   * @brief 丢弃缓存，下次 list() 重新完整枚举
+   */
+  void invalidate();
+
+  /**
+   * @brief 获取统计信息
+   */
+  Stats stats() const;
+
+ private:
+  /**
+   * @brief 完整枚举（需持锁）
+   */
+  void scanLocked();
+
+  /**
+   * @brief 读取单个端口的元数据
+   * @param class_fd 已打开的 class/tty 目录
+   * @param dev_fd 已打开的设备节点目录
+   * @param name tty 名称（如 ttyUSB0）
+   * @param meta 输出：端口元数据
+   * @return 不是可用串口时返回 false
+   */
+  bool probe(int class_fd, int dev_fd, const std::string& name, PortMetadata& meta) const;
+
+  /**
+   * @brief 打开所需目录后读取单个端口的元数据
+   */
+  bool probeName(const std::string& name, PortMetadata& meta) const;
+
+  /**
+   * @brief 设备节点对应的 tty 名称（节点本身不在 class/tty 中时按链接目标查找），找不到时返回空字符串
+   */
+  std::string ttyName(const std::string& port) const;
+
+  /**
+   * @brief 按索引查找（需持锁）：取得候选端口名后逐个确认，未启用监视时必要时重新枚举
+   * @param candidates 从索引中取出候选端口名
+   * @param match 端口是否满足查找条件
+   * @param meta 输出：找到的端口
+   */
+  bool lookupLocked(const std::function<void(std::vector<std::string>&)>& candidates,
+                    const std::function<bool(const PortMetadata&)>& match, PortMetadata& meta);
+
+  /**
+   * @brief 加入或更新缓存条目并维护索引（需持锁）
+   */
+  void storeLocked(const std::string& name, PortMetadata meta);
+
+  /**
+   * @brief 删除缓存条目及其索引（需持锁）
+   */
+  void eraseLocked(const std::string& name);
+
+  /**
+   * @brief 监视线程中处理设备事件
+   */
+  void onEvent(const DeviceWatcher::Event& event);
+
+ private:
+  const Config config_;  ///< 配置
+
+  std::shared_ptr<DeviceWatcher> watcher_;                       ///< 热插拔监视器（未启用缓存时为空）
+  uint64_t watch_id_{0};                                         ///< 订阅号
+  bool cached_{false};                                           ///< 缓存是否有效（由设备事件维护）
+  bool indexed_{false};                                          ///< 是否已有一次完整枚举建立的索引
+  std::map<std::string, PortMetadata> ports_;                    ///< 缓存：tty 名称 -> 端口元数据
+  std::unordered_multimap<std::string, std::string> by_serial_;  ///< 索引：USB 序列号 -> tty 名称
+  std::unordered_multimap<uint32_t, std::string> by_vidpid_;     ///< 索引：(VID << 16 | PID) -> tty 名称
+  std::unordered_map<std::string, std::string> by_path_;         ///< 索引：物理路径及其最后一段 -> tty 名称
+  Stats stats_;                                                  ///< 统计信息
+  mutable std::mutex mtx_;                                       ///< 缓存互斥锁
+  std::mutex watch_mtx_;                                         ///< 串行化 watch()，保证只订阅一次
+};
+
+#endif  // SERIAL_PORT_PORT_ENUMERATOR_H
@@ -0,0 +1,134 @@
+#pragma once
+#ifndef SERIAL_PORT_PORT_REACTOR_H
+#define SERIAL_PORT_PORT_REACTOR_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief 多串口共享的 I/O 反应器（仅 Linux，基于 epoll）
+ *
+ * 所有注册的 fd 位于同一个 epoll 集合中，由 N 个反应器线程共同等待；
+ * 每个 fd 以 EPOLLONESHOT 注册，同一时刻只会有一个线程处理它，处理完毕后重新布防，
+ * 因此同一个串口的回调始终是串行的。每个反应器线程持有一块复用的接收缓冲区，
+ * 不再需要每个串口各自一个线程和一块缓冲区。
+ *
+ * 一般通过 SerialPort::setReactor() 使用：
+ *    auto reactor = std::make_shared<PortReactor>(4);
+ *    for (auto &sp : ports) sp->setReactor(reactor).open();
+ *
+ * 非 Linux 平台上 attach() 总是失败，SerialPort 会自动回退为独立读线程。
+ */
+class PortReactor
+{
+ public:
+  /**
+   * @brief fd 事件处理函数类型
+   *
+   * 参数为 epoll 事件位与当前反应器线程的复用接收缓冲区；
+   * 返回 false 表示不再关注该 fd（反应器随即注销它）。
+   */
+  using Handler = std::function<bool(uint32_t events, std::vector<uint8_t>& buffer)>;
+
+  /**
+   * @brief 反应器统计信息
+   */
+  struct Stats
+  {
+    size_t threads{0};     ///< 反应器线程数
+    size_t registered{0};  ///< 当前注册的 fd 数
+    uint64_t wakeups{0};   ///< epoll_wait 返回次数
+    uint64_t events{0};    ///< 处理的 fd 事件数
+  };
+
+  /**
+   * @brief 构造反应器（线程在第一次 attach() 时启动）
+   * @param threads 反应器线程数，0 按 1 处理
+   * @param buffer_size 每个反应器线程的接收缓冲区大小（字节）
+   */
+  explicit PortReactor(size_t threads = 1, size_t buffer_size = 64 * 1024);
+
+  /**
+   * @brief 析构时停止所有反应器线程
+   */
+  ~PortReactor();
+
+  // 禁止复制与移动
+  PortReactor(const PortReactor&) = delete;
+  PortReactor& operator=(const PortReactor&) = delete;
+
+  /**
+   * @brief 注册一个 fd，关注可读事件
+   * @param fd 文件描述符（所有权不转移）
+   * @param handler 事件处理函数，在反应器线程中调用
+   * @return 注册号，失败返回 0
+   */
+  uint64_t attach(int fd, Handler handler);
+
+  /**
+   * @brief 注销一个 fd
+   *
+   * 返回时保证该 fd 的处理函数不再运行，也不会再被调用；
+   * 在该 fd 自己的处理函数中调用时不等待（处理函数返回后即注销），
+   * 此时其他线程对同一注册号的调用仍会等待处理函数返回。
+   *
+   * @param id attach() 返回的注册号，未知的注册号被忽略
+   */
+  void detach(uint64_t id);
+
+  /**
+   * @brief 停止所有反应器线程（已注册的 fd 不再被处理）
+   */
+  void stop();
+
+  /**
+   * @brief 获取统计信息
+   */
+  Stats stats() const;
+
+ private:
+  /**
+   * @brief 一个已注册的 fd
+   */
+  struct Registration
+  {
+    int fd{-1};           ///< 文件描述符
+    Handler handler;      ///< 事件处理函数
+    int in_flight{0};     ///< 正在执行处理函数的线程数（EPOLLONESHOT 下至多为 1）
+    bool removed{false};  ///< 是否已注销（处理函数仍在运行时保留在注册表中）
+  };
+
+  /**
+   * @brief 创建 epoll 集合并启动线程（需持锁）
+   */
+  bool startLocked();
+
+  /**
+   * @brief 反应器线程主循环
+   */
+  void threadLoop();
+
+ private:
+  size_t thread_count_;                                               ///< 反应器线程数
+  size_t buffer_size_;                                                ///< 每线程接收缓冲区大小
+  int epoll_fd_{-1};                                                  ///< epoll 集合
+  int wakeup_fd_{-1};                                                 ///< 停止时唤醒所有线程的 eventfd
+  std::atomic_bool running_{false};                                   ///< 线程运行标志
+  std::vector<std::thread> threads_;                                  ///< 反应器线程
+  uint64_t next_id_{1};                                               ///< 下一个注册号
+  std::unordered_map<uint64_t, std::shared_ptr<Registration>> regs_;  ///< 注册表
+  mutable std::mutex mtx_;                                            ///< 注册表互斥锁
+  std::condition_variable cv_;                                        ///< 等待处理函数结束
+  std::atomic<uint64_t> wakeups_{0};                                  ///< epoll_wait 返回次数
+  std::atomic<uint64_t> events_{0};                                   ///< 处理的事件数
+};
+
+#endif  // SERIAL_PORT_PORT_REACTOR_H
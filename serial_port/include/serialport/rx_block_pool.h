@@ -0,0 +1,235 @@
+#pragma once
+#ifndef SERIAL_PORT_RX_BLOCK_POOL_H
+#define SERIAL_PORT_RX_BLOCK_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "serialport/rx_timestamp.h"
+
+class RxBlockPool;
+
+/**
+ * @brief 接收块句柄（引用计数）
+ *
+ * 指向接收块池中的一块数据，复制句柄只增加引用计数，不复制数据；
+ * 最后一个句柄析构时数据块自动归还到池中，不经过全局分配器。
+ * 句柄可以跨线程传递、排队或长期保存，同一个句柄对象不能被多个线程同时修改。
+ */
+class RxBlock
+{
+ public:
+  RxBlock() = default;
+  RxBlock(const RxBlock& other);
+  RxBlock(RxBlock&& other) noexcept;
+  RxBlock& operator=(const RxBlock& other);
+  RxBlock& operator=(RxBlock&& other) noexcept;
+  ~RxBlock();
+
+  /// 数据起始地址（空句柄返回 nullptr）
+  const uint8_t* data() const
+  {
+    return block_ ? block_->data : nullptr;
+  }
+
+  /// 有效数据长度（字节）
+  size_t size() const
+  {
+    return block_ ? block_->size : 0;
+  }
+
+  /// 数据块容量（字节）
+  size_t capacity() const
+  {
+    return block_ ? block_->capacity : 0;
+  }
+
+  /// 接收时间戳（空句柄返回全 0）
+  RxTimestamp timestamp() const
+  {
+    return block_ ? block_->stamp : RxTimestamp();
+  }
+
+  /// 是否来自池内存（false 表示池耗尽时从堆上临时分配）
+  bool pooled() const
+  {
+    return block_ && block_->owner != nullptr;
+  }
+
+  /// 是否持有数据块
+  explicit operator bool() const
+  {
+    return block_ != nullptr;
+  }
+
+  /**
+   * @brief 可写数据地址（仅供填充方在交出句柄之前使用）
+   */
+  uint8_t* mutableData()
+  {
+    return block_ ? block_->data : nullptr;
+  }
+
+  /**
+   * @brief 设置有效数据长度（超过容量时截断为容量）
+   */
+  void setSize(size_t size);
+
+  /**
+   * @brief 设置接收时间戳（仅供填充方在交出句柄之前使用）
+   */
+  void setTimestamp(const RxTimestamp& stamp);
+
+  /**
+   * @brief 释放持有的数据块，句柄变为空
+   */
+  void reset();
+
+ private:
+  friend class RxBlockPool;
+
+  /**
+   * @brief 数据块头部
+   */
+  struct Block
+  {
+    std::atomic<uint32_t> refs{0};       ///< 引用计数
+    uint8_t* data{nullptr};              ///< 数据地址
+    size_t size{0};                      ///< 有效数据长度
+    size_t capacity{0};                  ///< 容量
+    RxTimestamp stamp;                   ///< 接收时间戳
+    std::shared_ptr<RxBlockPool> owner;  ///< 借出期间持有所属池，保证池晚于所有句柄销毁；堆块为空
+  };
+
+  explicit RxBlock(Block* block) : block_(block) {}
+
+  /**
+   * @brief 减少引用计数，归零时归还到池中或释放堆块
+   */
+  static void release(Block* block);
+
+ private:
+  Block* block_{nullptr};  ///< 持有的数据块
+};
+
+/**
+ * @brief 固定大小的接收块池
+ *
+ * 构造时一次性分配 block_count 个 block_size 字节的数据块（单块连续内存），
+ * 读线程从池中取出空闲块直接填充，交给使用者的是引用计数句柄，句柄全部释放后块回到空闲链表。
+ * 池耗尽时的行为由 Exhaustion 决定。
+ *
+ * 必须通过 std::shared_ptr 持有（借出的块会延长池的生命周期），各接口线程安全。
+ */
+class RxBlockPool : public std::enable_shared_from_this<RxBlockPool>
+{
+ public:
+  /**
+   * @brief 池耗尽时的处理策略
+   */
+  enum class Exhaustion
+  {
+    HeapFallback,  ///< 临时从堆上分配一块，释放时直接归还堆（默认）
+    Drop,          ///< 不分配，由调用方丢弃本次数据
+    Block          ///< 等待其他句柄释放数据块
+  };
+
+  /**
+   * @brief 池统计信息
+   */
+  struct Stats
+  {
+    size_t block_count{0};         ///< 池中数据块总数
+    size_t block_size{0};          ///< 单块容量（字节）
+    size_t free_blocks{0};         ///< 当前空闲块数
+    uint64_t acquired{0};          ///< 成功取出的块数（含堆上分配）
+    uint64_t misses{0};            ///< 取块时池已耗尽的次数
+    uint64_t heap_allocations{0};  ///< HeapFallback 策略下的堆分配次数
+    uint64_t waits{0};             ///< Block 策略下发生等待的次数
+    uint64_t dropped_bytes{0};     ///< Drop 策略下调用方报告丢弃的字节数
+  };
+
+  /**
+   * @brief 构造接收块池
+   * @param block_count 数据块数量，必须大于 0
+   * @param block_size 单块容量（字节），必须大于 0
+   * @param policy 池耗尽时的处理策略
+   */
+  RxBlockPool(size_t block_count, size_t block_size, Exhaustion policy = Exhaustion::HeapFallback);
+
+  // 禁止复制与移动
+  RxBlockPool(const RxBlockPool&) = delete;
+  RxBlockPool& operator=(const RxBlockPool&) = delete;
+
+  /**
+   * @brief 取出一个空闲数据块
+   *
+   * 返回的句柄有效长度为 0，由调用方填充后调用 setSize()。
+   * 池耗尽时：HeapFallback 返回堆上分配的块；Drop 返回空句柄；
+   * Block 最多等待 wait_ms 毫秒（负数表示一直等待），超时返回空句柄。
+   *
+   * @param wait_ms Block 策略下的最长等待时间
+   * @return 数据块句柄，可能为空
+   */
+  RxBlock acquire(int64_t wait_ms = -1);
+
+  /**
+   * @brief 预先触碰全部池内存，使其在运行期间不再产生缺页
+   */
+  void prefault();
+
+  /**
+   * @brief 记录调用方因池耗尽而丢弃的字节数
+   */
+  void noteDropped(size_t size);
+
+  /// 池耗尽时的处理策略
+  Exhaustion policy() const
+  {
+    return policy_;
+  }
+
+  /// 单块容量（字节）
+  size_t blockSize() const
+  {
+    return block_size_;
+  }
+
+  /**
+   * @brief 获取池统计信息
+   */
+  Stats stats() const;
+
+ private:
+  friend class RxBlock;
+
+  /**
+   * @brief 数据块引用归零后放回空闲链表
+   */
+  void recycle(RxBlock::Block* block);
+
+ private:
+  size_t block_count_;                        ///< 数据块数量
+  size_t slab_size_;                          ///< 池内存总字节数
+  size_t block_size_;                         ///< 单块容量
+  Exhaustion policy_;                         ///< 耗尽策略
+  std::unique_ptr<uint8_t[]> slab_;           ///< 全部数据块的连续存储
+  std::unique_ptr<RxBlock::Block[]> blocks_;  ///< 数据块头部
+  std::vector<RxBlock::Block*> free_;         ///< 空闲块（容量预留为块数，运行期间不再分配）
+  mutable std::mutex mtx_;                    ///< 空闲链表互斥锁
+  std::condition_variable cv_;                ///< Block 策略下等待空闲块
+  size_t waiters_{0};                         ///< 正在等待空闲块的线程数
+
+  std::atomic<uint64_t> acquired_{0};          ///< 成功取出的块数
+  std::atomic<uint64_t> misses_{0};            ///< 池耗尽次数
+  std::atomic<uint64_t> heap_allocations_{0};  ///< 堆分配次数
+  std::atomic<uint64_t> waits_{0};             ///< 等待次数
+  std::atomic<uint64_t> dropped_bytes_{0};     ///< 丢弃字节数
+};
+
+#endif  // SERIAL_PORT_RX_BLOCK_POOL_H
@@ -0,0 +1,167 @@
+#pragma once
+#ifndef SERIAL_PORT_RX_QUEUE_H
+#define SERIAL_PORT_RX_QUEUE_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+#include "serialport/rx_block_pool.h"
+
+/**
+ * @brief 有界接收队列（读线程与交付线程之间）
+ *
+ * 以数据块句柄为单位排队，同时限制块数与字节数；队列满时按 Overflow 策略处理，
+ * 每一个被丢弃的字节与数据块都精确计数，并记录最近一次丢弃发生的时间。
+ * 队列占用字节数向上越过阈值时触发一次慢消费者回调，回落到阈值一半以下后重新布防。
+ *
+ * 槽位在构造时一次性分配，运行期间入队出队不分配内存。各接口线程安全。
+ */
+class RxQueue
+{
+ public:
+  /**
+   * @brief 队列满时的处理策略
+   */
+  enum class Overflow
+  {
+    Block,       ///< 阻塞生产者直到有空间（背压传递到驱动缓冲）
+    DropOldest,  ///< 丢弃队首最旧的数据块，保留最新数据
+    DropNewest   ///< 丢弃新到达的数据块，保留已排队数据
+  };
+
+  /**
+   * @brief 队列统计信息
+   */
+  struct Stats
+  {
+    size_t max_chunks{0};              ///< 块数上限
+    size_t max_bytes{0};               ///< 字节数上限（0 表示不限）
+    size_t chunks{0};                  ///< 当前排队块数
+    size_t bytes{0};                   ///< 当前排队字节数
+    size_t high_water_chunks{0};       ///< 历史最高排队块数
+    size_t high_water_bytes{0};        ///< 历史最高排队字节数
+    uint64_t enqueued_chunks{0};       ///< 累计入队块数
+    uint64_t enqueued_bytes{0};        ///< 累计入队字节数（含之后被挤出丢弃的）
+    uint64_t dropped_chunks{0};        ///< 累计丢弃块数
+    uint64_t dropped_bytes{0};         ///< 累计丢弃字节数
+    uint64_t loss_events{0};           ///< 发生丢弃的次数（一次入队丢弃若干块计一次）
+    int64_t last_loss_ns{0};           ///< 最近一次丢弃的时间（steady_clock 纳秒，0 表示从未丢弃）
+    uint64_t block_waits{0};           ///< Block 策略下生产者等待的次数
+    uint64_t blocked_ns{0};            ///< Block 策略下生产者累计等待时间（纳秒）
+    uint64_t slow_consumer_events{0};  ///< 慢消费者回调触发次数
+  };
+
+  /// 慢消费者回调类型（在入队线程中调用，参数为触发时的统计快照）
+  using SlowConsumerCallback = std::function<void(const Stats&)>;
+
+  /**
+   * @brief 构造有界接收队列
+   * @param max_chunks 最多排队的数据块数，必须大于 0
+   * @param max_bytes 最多排队的字节数，0 表示只限制块数
+   * @param policy 队列满时的处理策略
+   */
+  RxQueue(size_t max_chunks, size_t max_bytes, Overflow policy);
+
+  // 禁止复制与移动
+  RxQueue(const RxQueue&) = delete;
+  RxQueue& operator=(const RxQueue&) = delete;
+
+  /**
+   * @brief 设置慢消费者回调
+   * @param threshold_bytes 触发阈值（排队字节数），0 表示关闭
+   * @param cb 回调函数，不应阻塞
+   */
+  void setSlowConsumer(size_t threshold_bytes, SlowConsumerCallback cb);
+
+  /**
+   * @brief 数据块入队
+   *
+   * 队列为空时无论大小都接受，避免单个超大块永远无法入队。
+   * Block 策略下最多等待 wait_ms 毫秒（负数表示一直等待）；等待超时返回 false，
+   * 此时 block 保持不变且不计为丢弃，由调用方重试或调用 discard() 放弃。
+   * 队列已关闭时数据块计为丢弃。
+   *
+   * @param block 数据块句柄，入队成功或被丢弃后所有权转移给队列
+   * @param wait_ms Block 策略下的最长等待时间
+   * @return 入队成功返回 true
+   */
+  bool push(RxBlock&& block, int64_t wait_ms = -1);
+
+  /**
+   * @brief 放弃一个未能入队的数据块并计入丢弃
+   */
+  void discard(RxBlock&& block);
+
+  /**
+   * @brief 数据块出队
+   * @param out 输出的数据块句柄
+   * @param wait_us 队列为空时最多等待的微秒数，负数表示一直等待直到有数据或队列关闭
+   * @return 取到数据块返回 true
+   */
+  bool pop(RxBlock& out, int64_t wait_us = -1);
+
+  /**
+   * @brief 重新打开已关闭的队列（统计计数保留）
+   */
+  void open();
+
+  /**
+   * @brief 关闭队列：唤醒所有等待者，之后入队失败，出队取完剩余数据后返回 false
+   */
+  void close();
+
+  /**
+   * @brief 队列是否已关闭
+   */
+  bool closed() const;
+
+  /**
+   * @brief 获取统计信息
+   */
+  Stats stats() const;
+
+ private:
+  /**
+   * @brief 是否还能放入 size 字节的数据块（需持锁）
+   */
+  bool hasRoom(size_t size) const;
+
+  /**
+   * @brief 取出队首数据块（需持锁）
+   */
+  RxBlock takeFront();
+
+  /**
+   * @brief 记录一次丢弃（需持锁）
+   */
+  void noteLoss(uint64_t chunks, uint64_t bytes);
+
+  /**
+   * @brief 生成统计快照（需持锁）
+   */
+  Stats snapshot() const;
+
+ private:
+  size_t max_chunks_;           ///< 块数上限
+  size_t max_bytes_;            ///< 字节数上限
+  Overflow policy_;             ///< 队列满时的处理策略
+  std::vector<RxBlock> slots_;  ///< 环形槽位
+  size_t head_{0};              ///< 队首槽位
+  size_t count_{0};             ///< 排队块数
+  size_t bytes_{0};             ///< 排队字节数
+  bool closed_{false};          ///< 是否已关闭
+
+  size_t slow_threshold_{0};           ///< 慢消费者阈值
+  bool slow_armed_{true};              ///< 慢消费者回调是否已布防
+  SlowConsumerCallback slow_cb_;       ///< 慢消费者回调
+  Stats stats_;                        ///< 累计统计（容量与当前占用在快照时填充）
+  mutable std::mutex mtx_;             ///< 队列互斥锁
+  std::condition_variable not_empty_;  ///< 有数据可取
+  std::condition_variable not_full_;   ///< 有空间可放
+};
+
+#endif  // SERIAL_PORT_RX_QUEUE_H
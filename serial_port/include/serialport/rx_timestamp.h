@@ -0,0 +1,31 @@
+#pragma once
+#ifndef SERIAL_PORT_RX_TIMESTAMP_H
+#define SERIAL_PORT_RX_TIMESTAMP_H
+
+#include <chrono>
+#include <cstdint>
+
+/**
+ * @brief 接收时间戳（在 read 系统调用返回后立即记录）
+ */
+struct RxTimestamp
+{
+  int64_t mono_ns{0};  ///< 单调时钟（steady_clock）纳秒，0 表示未知
+  int64_t real_ns{0};  ///< 墙上时钟（system_clock，Unix 纪元）纳秒，未启用时为 0
+
+  /// 当前单调时钟（纳秒）
+  static int64_t monoNow()
+  {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+  }
+
+  /// 当前墙上时钟（纳秒）
+  static int64_t realNow()
+  {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch())
+      .count();
+  }
+};
+
+#endif  // SERIAL_PORT_RX_TIMESTAMP_H
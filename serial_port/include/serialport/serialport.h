@@ -23,6 +23,12 @@
  *            // 处理接收到的数据
  *        });
  *
+ *    - 高吞吐场景可改用零拷贝的视图回调，数据直接指向读线程的复用缓冲区，
+ *      仅在回调期间有效，需要保留时显式调用 toString()/toBytes() 复制：
+ *        sp.setDataViewCallback([](const SerialPort::DataView &view){
+ *            parse(view.data, view.size);
+ *        });
+ *
  *    - 设置日志回调用于调试和错误信息输出：
  *        sp.setLogCallback([](SerialPort::LogLevel level, const std::string &msg){
  *            std::cout << msg << std::endl;
@@ -40,13 +46,20 @@
  *
  *
  * 4. 数据发送
- *    - write() 是线程安全的：
+ *    - write() 是线程安全的，连接不可用时立即返回 0（见第 23 节）：
  *        sp.write("Hello World");
  *
  *
  * 5. 线程与重连
  *    - 内部使用单独线程读串口数据，自动触发数据回调。
- *    - 当串口断开时，会根据 reconnect_limit 尝试自动重连。
+ *    - 当串口断开时，由独立的重连线程按指数退避（带抖动与上限）最多重试 reconnect_limit 次，
+ *      等待期间设备节点重新出现（如 USB 重新枚举完成）时立即重试，读路径在重新打开后随即恢复：
+ *        SerialPort::ReconnectPolicy policy;
+ *        policy.initial_delay_ms = 20;
+ *        policy.max_delay_ms = 2000;
+ *        sp.setReconnectLimit(100).setReconnectPolicy(policy);
+ *        sp.setStateCallback([](SerialPort::LinkState from, SerialPort::LinkState to){ ... });
+ *        sp.reconnectStats().recovery.percentile(99);         // 断开到恢复的耗时
  *    - 注意：readLoop 在内部处理异常，无需用户手动管理线程。
  *
  *
@@ -56,6 +69,15 @@
  *        for (const auto &p : ports) {
  *            std::cout << p.port << " : " << p.description << std::endl;
  *        }
+ *    - Linux 上由 PortEnumerator 直接读取 sysfs：跳过虚拟终端与不存在的 ttyS 占位端口，端口多时并行读取属性。
+ *    - 需要频繁枚举时可让枚举器订阅热插拔事件，结果被缓存并按设备增减增量更新：
+ *        PortEnumerator enumerator;
+ *        enumerator.watch(std::make_shared<DeviceWatcher>());
+ *        auto ports = enumerator.list();                      // 之后的调用直接返回缓存
+ *    - 按身份或物理路径查找单个串口时查索引，不做完整枚举，也不必解析 hardware_id 字符串：
+ *        PortMetadata meta;
+ *        if (enumerator.find(id, meta)) sp.setPort(meta.port);  // id 为 DeviceIdentity，见第 24 节
+ *        enumerator.findByPath("1-1.2:1.0", meta);            // USB 接口所在的物理端口，插拔后不变
  *
  *
  * 7. 注意事项
@@ -64,17 +86,211 @@
  *    - setTimeout 影响串口读超时时间，建议根据实际设备调整。
  *
  *
+ * 8. 环形缓冲解耦（慢消费者）
+ *    - 默认数据回调直接在读线程中执行，慢回调会拖慢读取甚至导致内核缓冲溢出。
+ *    - 启用环形缓冲后，读线程只把数据写入无锁 SPSC 环，由消费线程批量取出：
+ *        sp.setRingBuffer(1 << 20);                                     // 库内部创建消费线程
+ *        sp.setRingBuffer(1 << 20, SerialPort::RingConsumer::External);  // 用户线程自行消费
+ *        sp.consumeRing([](const SerialPort::DataView &v){ ... }, 100);   // External 模式下取数据
+ *    - 通过 ringStats() 获取高水位与溢出计数，用于评估环的容量。
+ *
+ *
+ * 9. 帧解码
+ *    - 在最底层把数据块流还原为完整帧，避免每个使用者各自拼接字符串：
+ *        sp.setFrameDecoder(std::unique_ptr<FrameDecoder>(new DelimiterFrameDecoder("\r\n")))
+ *          .setFrameCallback([](const SerialPort::DataView &frame){ ... });
+ *    - 内置分隔符、定长、长度前缀（含 varint）三种解码器，详见 frame_decoder.h。
+ *    - 帧回调与数据回调可同时设置，帧回调在数据回调之后于同一线程执行。
+ *
+ *
+ * 10. 事件驱动读取（仅 POSIX）
+ *    - 默认的轮询模式在空闲时每秒唤醒约 100 次，首字节最多额外延迟 5ms。
+ *    - 事件驱动模式下读线程阻塞在 poll(串口 fd + 唤醒 fd) 上，空闲时零唤醒：
+ *        sp.setReadMode(SerialPort::ReadMode::Event);
+ *    - Windows 下该设置会自动回退为轮询模式。
+ *
+ *
+ * 11. 接收块池（保留数据不复制）
+ *    - 视图回调中的数据在回调返回后即失效，需要排队、转发或长期保存时只能复制。
+ *    - 启用接收块池后读线程直接读入池中的数据块，块回调拿到的是引用计数句柄，
+ *      复制句柄即可保存，最后一个句柄释放时数据块回到池中，不经过全局分配器：
+ *        sp.setBlockPool(64, 4096, RxBlockPool::Exhaustion::HeapFallback)
+ *          .setBlockCallback([&queue](const RxBlock &block){ queue.push(block); });
+ *    - 池耗尽时可选择临时堆分配、丢弃数据或阻塞读线程，poolStats() 提供未命中计数。
+ *
+ *
+ * 12. 有界接收队列（溢出策略与丢失统计）
+ *    - 读线程把数据块放入有界队列，由库内部的交付线程取出后执行回调；
+ *      队列满时按策略阻塞读线程、丢弃最旧或丢弃最新数据块，丢失的块数与字节数精确计数：
+ *        sp.setRxQueue(256, 1 << 20, RxQueue::Overflow::DropOldest)
+ *          .setSlowConsumerCallback(512 * 1024, [](const RxQueue::Stats &st){ alarm(st.bytes); });
+ *    - queueStats() 提供当前占用、高水位、丢弃计数与最近一次丢弃的时间。
+ *    - 启用队列后环形缓冲不再生效；未设置接收块池时自动创建一个（max_chunks + 2 块，每块 4KB）。
+ *
+ *
+ * 13. 回调合并（类似网卡中断合并）
+ *    - 高波特率下读线程可能每秒数千次以很小的数据块调用数据回调，调用开销占主导。
+ *    - 启用合并后数据先暂存，累计满 N 字节或距第一个未交付字节超过 T 微秒时才回调一次：
+ *        sp.setCoalescing(4096, 2000);  // 满 4KB 或最多延迟 2ms
+ *    - coalesceStats() 提供回调次数与附加延迟统计，用于权衡延迟与回调频率。
+ *    - 只作用于数据回调（含 setDataCallback），帧解码与块回调不受影响；
+ *      轮询模式下时间窗口的精度受读超时限制，事件驱动、环形缓冲与接收队列模式按截止时间精确唤醒。
+ *
+ *
+ * 14. 接收时间戳与延迟直方图
+ *    - 每个数据块在 read 返回后立即打上单调时钟时间戳，随 DataView/RxBlock 交给回调；
+ *      墙上时钟时间戳需显式开启：sp.setRealtimeTimestamps(true);
+ *    - 经过环形缓冲的数据不再保留块边界，其视图时间戳为 0（未知）；合并后的视图带第一块数据的时间戳。
+ *    - 内置三个对数-线性直方图，运行期间随时查询，不影响读取：
+ *        auto st = sp.latencyStats();
+ *        st.inter_chunk_gap.percentile(99);   // 相邻数据块到达间隔
+ *        st.callback_time.percentile(99.9);   // 数据回调与帧回调的执行时间
+ *        st.queue_dwell.percentile(99);       // 接收队列中的停留时间（读取到出队）
+ *
+ *
+ * 15. 读线程实时配置（CPU 亲和性 / 实时调度 / 内存锁定）
+ *    - 默认调度下读线程在负载高时可能被抢占数毫秒。可为读线程指定线程配置：
+ *        SerialPort::ThreadProfile profile;
+ *        profile.cpus = {3};                                   // 绑定到 CPU 3（仅 Linux）
+ *        profile.policy = SerialPort::SchedPolicy::Fifo;       // SCHED_FIFO
+ *        profile.priority = 80;
+ *        profile.lock_memory = true;                           // mlockall，避免换页
+ *        profile.prefault = true;                              // 预先触碰读缓冲区、接收块池与线程栈
+ *        sp.setThreadProfile(profile);
+ *    - 实时调度与 mlockall 通常需要 root 或 CAP_SYS_NICE / CAP_IPC_LOCK（或相应的 rlimit），
+ *      失败时只输出警告日志，读线程照常以默认配置运行。
+ *
+ *
+ * 16. 共享反应器（大量串口，仅 Linux）
+ *    - 默认每个串口一个读线程和一块 64KB 缓冲区，数百个串口时大部分线程处于空闲。
+ *    - 多个串口可共用一个 epoll 反应器，由少量线程按就绪事件读取并执行各自的回调：
+ *        auto reactor = std::make_shared<PortReactor>(4);  // 4 个反应器线程
+ *        for (auto &sp : ports) sp->setReactor(reactor).open();
+ *    - 同一串口的回调仍是串行的，但回调会占用共享线程，阻塞的回调会拖慢其他串口，
+ *      此时应配合环形缓冲或接收队列使用。线程配置（ThreadProfile）不作用于反应器线程。
+ *    - 反应器模式下设备断开时串口先从反应器注销，由重连线程重新打开后再注册，不在共享线程中阻塞重连。
+ *    - 非 Linux 平台自动回退为每个串口独立的读线程。
+ *
+ *
+ * 17. 接入已有事件循环（仅 POSIX）
+ *    - 外部事件循环模式下 open() 不创建读线程，由用户把串口 fd 加入自己的 epoll/poll/libuv 等循环：
+ *        sp.setReadMode(SerialPort::ReadMode::External).open();
+ *        epoll_add(sp.nativeHandle(), sp.pollEvents());      // POLLIN 与 EPOLLIN 取值相同
+ *        // fd 可读（或报告错误）时：
+ *        sp.onReadable();                                     // 非阻塞读取并在当前线程执行回调
+ *        // 循环超时设为 sp.nextTimeoutUs()，到期时：
+ *        sp.pump();                                           // 交付到期的合并数据
+ *    - onReadable() 在可读却读不到数据时认为设备已断开，此时需从循环中移除 fd；设置了重连次数时
+ *      重连成功会在状态回调中收到 Reconnecting -> Open，再注册新的 nativeHandle()，否则需重新 open()。
+ *    - 回调在调用 onReadable()/pump() 的线程中执行，这两个函数不能在多个线程中同时调用。
+ *    - 同时设置了共享反应器时以反应器为准；Windows 下回退为轮询模式。
+ *
+ *
+ * 18. C++20 协程接口（可选）
+ *    - 以 -DSERIALPORT_BUILD_CORO=ON 构建 serialport_coro，基于外部事件循环模式与单线程执行器：
+ *        std::string reply = co_await port.readUntil("\r\n", CoExecutor::after(std::chrono::milliseconds(200)));
+ *    - 详见 coro.h。
+ *
+ *
+ * 19. 请求/应答关联（流水线）
+ *    - 设备支持多个未完成请求时，由 TransactionEngine 统一完成发送、按关联键匹配应答、超时与统计：
+ *        TransactionEngine engine(sp, extract_seq, 8);         // 最多 8 个请求同时在途
+ *        auto resp = engine.submit(req).get();                 // 或 submit(req, callback)
+ *        engine.stats()["read_reg"].rtt.percentile(99);       // 按事务类型统计往返时延
+ *    - 引擎接管帧回调，需先设置帧解码器，详见 transaction.h。
+ *
+ *
+ * 20. 异步发送（多生产者不再互相阻塞）
+ *    - write() 在持锁期间等待数据写出，多个发送线程会串行排队，每个都阻塞整个发送时间。
+ *    - 启用异步发送后 writeAsync() 只把数据放入无锁队列立即返回，由内部写线程按提交顺序写出，
+ *      相邻的多条数据合并为一次写调用，写完后逐条回调结果：
+ *        sp.setAsyncWrite(true);
+ *        sp.writeAsync(frame, [](bool ok, size_t written){ if (!ok) retry(); });
+ *    - txStats() 提供排队深度、待发送字节数与写调用次数；close() 会先写完已提交的数据。
+ *    - write() 仍为同步写，与 writeAsync() 混用时两者之间不保证顺序。
+ *    - 急停、心跳等命令走紧急通道，批量数据按时长分片，紧急命令只需等待约一个分片时间：
+ *        sp.setAsyncWrite(true).setTxSlice(2000);              // 2ms 一片，按波特率换算字节数
+ *        sp.writeAsync(firmware_image);                        // 普通通道
+ *        sp.writeAsync(estop, nullptr, TxQueue::Priority::Urgent);
+ *        sp.txStats().urgent_latency.percentile(99);           // 紧急命令从提交到写出的时延
+ *
+ *
+ * 21. 聚集写（帧头与负载分开存放时）
+ *    - 不必先拼接成一个字符串，直接按顺序传入各段，POSIX 下映射为一次 writev()：
+ *        uint8_t header[4] = {0xAA, 0x55, len_lo, len_hi};
+ *        sp.write({{header, sizeof(header)}, {payload.data(), payload.size()}});
+ *    - 部分写出时从中断处继续，超时按总字节数计算；异步发送的合并写出也走这一路径。
+ *
+ *
+ * 22. 发送节拍（接收 FIFO 很小、没有流控的设备）
+ *    - 按波特率换算的令牌桶控制写出节拍，块之间在锁外以微秒精度等待，帧之间插入帧间隔：
+ *        TxPacer::Config pacing;
+ *        pacing.burst_bytes = 16;      // 设备 FIFO 大小
+ *        pacing.rate_percent = 95;     // 略低于线路速率，给设备留处理余量
+ *        pacing.frame_gap_us = 2000;   // 帧间隔
+ *        sp.setTxPacing(true, pacing);
+ *    - 启用后 write() 与 writeAsync() 都由写线程按节拍写出，每次调用的数据为一帧；
+ *      pacingStats() 提供等待次数与实际睡眠精度（max_late_ns）。
+ *
+ *
+ * 23. 连接状态与并发
+ *    - linkState() 返回 Closed/Opening/Open/Reconnecting/Closing，读写路径只做原子读取：
+ *      打开或重连期间（包括重试间隔）write() 立即返回 0，writeAsync() 的数据留在队列中，连接恢复后写出。
+ *    - 读路径与写路径互不加锁（全双工）；写出之间由发送锁串行化，open()/close() 另用一把锁，
+ *      重试等待不持有任何读写路径会用到的锁，close() 会立即打断重试等待。
+ *    - 读只发生在唯一的读路径上（读线程、反应器或外部事件循环），因此省去了 serial 库每次调用的读写锁。
+ *
+ *
+ * 24. 热插拔与稳定身份（仅 Linux）
+ *    - USB 串口重新插入后节点名可能变化（ttyUSB0 -> ttyUSB1），可按 VID:PID:序列号绑定串口：
+ *        DeviceIdentity id;
+ *        id.vid = 0x0403;
+ *        id.pid = 0x6001;
+ *        id.serial = "A50285BI";                               // 为空时匹配任意序列号
+ *        id.interface = 1;                                     // 多口转换器的第 2 口，-1 时匹配任意接口
+ *        auto watcher = std::make_shared<DeviceWatcher>();     // 可由多个串口共用
+ *        sp.setDeviceWatcher(watcher).setDeviceIdentity(id).setReconnectLimit(100).open();
+ *    - 绑定身份后 setPort() 可省略，每次打开前都由 PortEnumerator 按身份查索引得到当前的设备节点。
+ *    - 监视器监听内核 uevent 与设备目录的 inotify 事件：打开重试或重连等待期间，
+ *      满足身份（未绑定身份时为路径等于 port）的节点一出现就立即重试，不再等待退避间隔。
+ *    - 只设置身份时自动创建一个私有监视器；未启用监视器时重连仍按退避策略与节点探测进行。
+ *
+ *
+ * 25. 驱动与转换芯片的延迟调优（仅 Linux）
+ *    - FTDI 等 USB 转串口芯片默认 latency_timer 为 16ms，未满包的少量数据要等计时器到期才上报；
+ *      短帧一问一答的场景下往返延迟主要来自这里：
+ *        sp.setLowLatency(true, 1).open();                     // ASYNC_LOW_LATENCY + latency_timer=1ms
+ *        auto t = sp.latencyTuning();                          // 实际生效的设置与驱动名
+ *    - 每次打开与重连后重新设置（重新插入后芯片恢复默认值）；写 latency_timer 需要 sysfs 权限
+ *      （root 或 udev 规则），无权限时 latency_timer_set 为 false，latency_timer_ms 为当前值。
+ *
+ *
  * =============================================================
  */
 
 #include <serial/serial.h>
 
 #include <atomic>
+#include <condition_variable>
 #include <functional>
+#include <initializer_list>
+#include <memory>
 #include <mutex>
 #include <string>
 #include <thread>
 
+#include "serialport/coalescer.h"
+#include "serialport/device_watcher.h"
+#include "serialport/frame_decoder.h"
+#include "serialport/port_enumerator.h"
+#include "serialport/latency_histogram.h"
+#include "serialport/port_reactor.h"
+#include "serialport/rx_block_pool.h"
+#include "serialport/rx_queue.h"
+#include "serialport/spsc_ring.h"
+#include "serialport/tx_pacer.h"
+#include "serialport/tx_queue.h"
+
 /**
  * @brief 串口通信封装类（基于 serial 库）
  *
@@ -94,12 +310,162 @@ class SerialPort
     Error     ///< 错误信息
   };
 
-  /// 数据接收回调函数类型（参数为接收到的字符串数据）
+  /**
+   * @brief 读线程工作模式枚举
+   */
+  enum class ReadMode
+  {
+    Polling,  ///< 轮询模式：带超时读取，无数据时短暂休眠（默认）
+    Event,    ///< 事件驱动模式：阻塞在 poll 上等待数据或唤醒，空闲零唤醒（仅 POSIX）
+    External  ///< 外部事件循环模式：不创建读线程，由用户的事件循环调用 onReadable()/pump()（仅 POSIX）
+  };
+
+  /**
+   * @brief 连接状态（原子变量，读写路径据此快速判断，不获取任何锁）
+   */
+  enum class LinkState
+  {
+    Closed,        ///< 未打开（包括打开失败、放弃重连、检测到断开后已关闭）
+    Opening,       ///< open() 正在打开或在重试间隔中等待
+    Open,          ///< 已打开，读写可用
+    Reconnecting,  ///< 检测到断开，重连线程正在重连
+    Closing        ///< close() 正在停止各线程并关闭串口
+  };
+
+  /**
+   * @brief 读线程调度策略
+   */
+  enum class SchedPolicy
+  {
+    Default,    ///< 保持系统默认（SCHED_OTHER）
+    Fifo,       ///< SCHED_FIFO 实时调度
+    RoundRobin  ///< SCHED_RR 实时调度
+  };
+
+  /**
+   * @brief 读线程配置（仅 POSIX；CPU 亲和性仅 Linux）
+   */
+  struct ThreadProfile
+  {
+    std::vector<int> cpus;                     ///< 允许运行的 CPU 编号，为空表示不限制
+    SchedPolicy policy{SchedPolicy::Default};  ///< 调度策略
+    int priority{0};                           ///< 实时优先级（Fifo/RoundRobin 时有效，通常为 1~99）
+    bool lock_memory{false};                   ///< 调用 mlockall(MCL_CURRENT | MCL_FUTURE) 锁定进程内存
+    bool prefault{false};                      ///< 读线程启动时预先触碰读缓冲区、接收块池与线程栈
+  };
+
+  /**
+   * @brief 环形缓冲的消费方式
+   */
+  enum class RingConsumer
+  {
+    Internal,  ///< 库内部创建消费线程，批量取出后调用数据回调
+    External   ///< 由用户线程调用 consumeRing() 自行取出
+  };
+
+  /**
+   * @brief 延迟统计（各直方图的快照）
+   */
+  struct LatencyStats
+  {
+    LatencyHistogram::Snapshot inter_chunk_gap;  ///< 相邻数据块到达间隔
+    LatencyHistogram::Snapshot callback_time;    ///< 数据回调与帧回调的单次执行时间
+    LatencyHistogram::Snapshot queue_dwell;      ///< 数据块在接收队列中的停留时间
+  };
+
+  /**
+   * @brief 驱动与转换芯片的延迟调优结果（每次打开或重连后更新）
+   */
+  struct LatencyTuning
+  {
+    bool requested{false};          ///< 是否启用了低延迟选项
+    bool low_latency{false};        ///< 驱动报告的 ASYNC_LOW_LATENCY 标志（驱动不支持 TIOCGSERIAL 时为 false）
+    int latency_timer_ms{-1};       ///< 转换芯片 latency_timer 的当前值（毫秒），没有该属性时为 -1
+    bool latency_timer_set{false};  ///< 本次打开是否写入了 latency_timer（无权限时为 false）
+    std::string driver;             ///< 检测到的驱动名（如 ftdi_sio、cp210x、cdc_acm），未知（如 pty）时为空
+  };
+
+  /**
+   * @brief 重连退避策略：第 n 次重试前等待 min(max_delay_ms, initial_delay_ms * multiplier^(n-1))，再加上随机抖动
+   */
+  struct ReconnectPolicy
+  {
+    uint32_t initial_delay_ms{50};  ///< 第一次重试前的等待（毫秒）
+    uint32_t max_delay_ms{5000};    ///< 等待上限（毫秒）
+    double multiplier{2.0};         ///< 每次失败后等待时间的放大倍数
+    double jitter{0.2};             ///< 随机抖动比例（0 ~ 1），等待时间在 ±jitter 范围内随机，避免多个串口同时重试
+    uint32_t probe_interval_ms{5};  ///< 未启用热插拔监视时，等待期间检查设备节点是否出现的间隔（仅 POSIX，0 表示不检查）
+  };
+
+  /**
+   * @brief 重连统计信息
+   */
+  struct ReconnectStats
+  {
+    uint64_t disconnects{0};              ///< 检测到的断开次数
+    uint64_t recoveries{0};               ///< 重连成功次数
+    uint64_t give_ups{0};                 ///< 达到重试上限后放弃的次数
+    uint64_t attempts{0};                 ///< 累计重试次数
+    int64_t last_recovery_ns{0};          ///< 最近一次恢复耗时（检测到断开到重新打开）
+    LatencyHistogram::Snapshot recovery;  ///< 恢复耗时直方图
+  };
+
+  /**
+   * @brief 环形缓冲统计信息
+   */
+  struct RingStats
+  {
+    size_t capacity{0};           ///< 容量（字节）
+    size_t used{0};               ///< 当前占用（字节）
+    size_t high_water_mark{0};    ///< 历史最高占用（字节）
+    uint64_t pushed_bytes{0};     ///< 累计写入字节数
+    uint64_t overflow_bytes{0};   ///< 因空间不足被丢弃的字节数
+    uint64_t overflow_events{0};  ///< 发生溢出的次数
+  };
+
+  /**
+   * @brief 接收数据视图
+   *
+   * 指向读线程内部复用的接收缓冲区，不做任何拷贝，仅在回调执行期间有效。
+   * 如需在回调结束后继续使用数据，请调用 toString() 或 toBytes() 显式复制。
+   */
+  struct DataView
+  {
+    const uint8_t* data{nullptr};  ///< 数据起始地址
+    size_t size{0};                ///< 数据长度（字节）
+    RxTimestamp stamp;             ///< 接收时间戳（read 返回时刻；经环形缓冲交付时为 0）
+
+    /// 复制为 std::string
+    std::string toString() const
+    {
+      return std::string(reinterpret_cast<const char*>(data), size);
+    }
+
+    /// 复制为字节数组
+    std::vector<uint8_t> toBytes() const
+    {
+      return std::vector<uint8_t>(data, data + size);
+    }
+  };
+
+  /// 数据接收回调函数类型（参数为接收到的字符串数据，每次回调都会分配并复制一次）
   using DataCallback = std::function<void(const std::string&)>;
 
+  /// 零拷贝数据接收回调函数类型（参数为指向接收缓冲区的只读视图）
+  using DataViewCallback = std::function<void(const DataView&)>;
+
+  /// 帧回调函数类型（参数为完整帧的只读视图，仅在回调期间有效）
+  using FrameCallback = std::function<void(const DataView&)>;
+
+  /// 接收块回调函数类型（参数为引用计数句柄，复制句柄即可在回调之后继续持有数据）
+  using BlockCallback = std::function<void(const RxBlock&)>;
+
   /// 日志回调函数类型（参数为日志级别与消息内容）
   using LogCallback = std::function<void(SerialPort::LogLevel, const std::string&)>;
 
+  /// 连接状态变化回调函数类型（参数为原状态与新状态，在引起变化的线程中调用）
+  using StateCallback = std::function<void(LinkState from, LinkState to)>;
+
  public:
   /**
    * @brief 默认构造函数
@@ -160,13 +526,292 @@ class SerialPort
    */
   SerialPort& setReconnectLimit(size_t limit);
 
+  /**
+   * @brief 设置重连退避策略（需在 open() 之前设置）
+   * @param policy 退避策略，同样用于 open() 首次打开失败后的重试
+   * @return 返回自身引用以支持链式调用
+   */
+  SerialPort& setReconnectPolicy(const ReconnectPolicy& policy);
+
+  /**
+   * @brief 设置连接状态变化回调（需在 open() 之前设置）
+   *
+   * 外部事件循环模式下，收到 Reconnecting -> Open 时应把新的 nativeHandle() 重新注册到循环中。
+   * @param cb 回调函数，不应阻塞，也不能在其中调用 open()/close()
+   * @return 返回自身引用以支持链式调用
+   */
+  SerialPort& setStateCallback(StateCallback cb);
+
+  /**
+   * @brief 获取重连统计信息（任意线程可调用）
+   */
+  ReconnectStats reconnectStats() const;
+
+  /**
+   * @brief 设置读线程工作模式
+   * @param mode 读取模式，需在 open() 之前设置
+   * @return 返回自身引用以支持链式调用
+   */
+  SerialPort& setReadMode(ReadMode mode);
+
+  /**
+   * @brief 设置读线程配置（需在 open() 之前设置，读线程启动时生效）
+   * @param profile 线程配置
+   * @return 返回自身引用以支持链式调用
+   */
+  SerialPort& setThreadProfile(const ThreadProfile& profile);
+
+  /**
+   * @brief 使用共享反应器代替独立读线程（需在 open() 之前设置）
+   * @param reactor 反应器，可由多个串口共用；为空时恢复独立读线程
+   * @return 返回自身引用以支持链式调用
+   */
+  SerialPort& setReactor(std::shared_ptr<PortReactor> reactor);
+
+  /**
+   * @brief 设置热插拔监视器（需在 open() 之前设置，仅 Linux）
+   * @param watcher 监视器，可由多个串口共用；设备节点出现时立即重试打开或重连
+   * @return 返回自身引用以支持链式调用
+   */
+  SerialPort& setDeviceWatcher(std::shared_ptr<DeviceWatcher> watcher);
+
+  /**
+   * @brief 按 USB 身份绑定设备（需在 open() 之前设置，仅 Linux）
+   * @param identity 设备身份，每次打开前按身份查找当前设备节点，vid 为 0 时取消绑定
+   * @return 返回自身引用以支持链式调用
+   */
+  SerialPort& setDeviceIdentity(const DeviceIdentity& identity);
+
   /**
    * @brief 设置数据接收回调函数
+   *
+   * 兼容接口：内部包装为视图回调，每次回调复制一份 std::string。
+   * 与 setDataViewCallback 共用同一个回调槽，后设置者生效。
+   *
    * @param cb 回调函数，参数为接收到的数据字符串
    * @return 返回自身引用以支持链式调用
    */
   SerialPort& setDataCallback(DataCallback cb);
 
+  /**
+   * @brief 设置零拷贝数据接收回调函数
+   *
+   * 回调直接拿到接收缓冲区的只读视图，稳态下不产生任何堆分配。
+   *
+   * @param cb 回调函数，参数为数据视图（仅在回调期间有效）
+   * @return 返回自身引用以支持链式调用
+   */
+  SerialPort& setDataViewCallback(DataViewCallback cb);
+
+  /**
+   * @brief 设置帧解码器（需在 open() 之前设置）
+   *
+   * 解码器在数据交付线程中运行（未启用环形缓冲时为读线程，否则为消费线程），
+   * 每解出一帧调用一次帧回调。传入空指针表示关闭帧解码。
+   *
+   * @param decoder 帧解码器，所有权转移给 SerialPort
+   * @return 返回自身引用以支持链式调用
+   */
+  SerialPort& setFrameDecoder(std::unique_ptr<FrameDecoder> decoder);
+
+  /**
+   * @brief 设置帧回调函数
+   * @param cb 回调函数，参数为完整帧的只读视图（仅在回调期间有效）
+   * @return 返回自身引用以支持链式调用
+   */
+  SerialPort& setFrameCallback(FrameCallback cb);
+
+  /**
+   * @brief 获取帧解码统计信息
+   * @return 统计信息，未设置解码器时各项为 0
+   */
+  FrameDecoder::Stats frameStats() const;
+
+  /**
+   * @brief 启用读线程与消费者之间的无锁环形缓冲（需在 open() 之前设置）
+   *
+   * 启用后读线程只负责把数据写入环中，不再直接执行数据回调；
+   * 空间不足时丢弃新数据并计入溢出计数，读线程永不阻塞。
+   *
+   * @param capacity 环容量（字节），向上取整为 2 的幂；传 0 表示关闭
+   * @param consumer 消费方式，Internal 由库创建消费线程，External 由用户调用 consumeRing()
+   * @return 返回自身引用以支持链式调用
+   */
+  SerialPort& setRingBuffer(size_t capacity, RingConsumer consumer = RingConsumer::Internal);
+
+  /**
+   * @brief 从环形缓冲中批量取出数据（仅 External 模式，且只能由同一个线程调用）
+   * @param cb 数据回调，视图直接指向环内存储，仅在回调期间有效（环回绕时会调用两次）
+   * @param wait_ms 环为空时最多等待的毫秒数，0 表示不等待
+   * @return 本次取出的字节数
+   */
+  size_t consumeRing(const DataViewCallback& cb, uint32_t wait_ms = 0);
+
+  /**
+   * @brief 获取环形缓冲统计信息（任意线程可调用）
+   * @return 统计信息，未启用环形缓冲时各项为 0
+   */
+  RingStats ringStats() const;
+
+  /**
+   * @brief 启用接收块池（需在 open() 之前设置）
+   *
+   * 启用后读线程每次读取都直接填充池中的一个数据块，并在读线程中调用块回调；
+   * 数据回调、帧解码与环形缓冲照常工作，数据来源为同一个数据块。
+   *
+   * @param block_count 数据块数量，传 0 表示关闭
+   * @param block_size 单块容量（字节），即单次读取的最大字节数
+   * @param policy 池耗尽时的处理策略
+   * @return 返回自身引用以支持链式调用
+   */
+  SerialPort& setBlockPool(size_t block_count, size_t block_size = 4096,
+                           RxBlockPool::Exhaustion policy = RxBlockPool::Exhaustion::HeapFallback);
+
+  /**
+   * @brief 设置接收块回调函数（仅在启用接收块池时触发）
+   * @param cb 回调函数，参数为数据块句柄
+   * @return 返回自身引用以支持链式调用
+   */
+  SerialPort& setBlockCallback(BlockCallback cb);
+
+  /**
+   * @brief 获取接收块池统计信息（任意线程可调用）
+   * @return 统计信息，未启用接收块池时各项为 0
+   */
+  RxBlockPool::Stats poolStats() const;
+
+  /**
+   * @brief 启用读线程与交付线程之间的有界接收队列（需在 open() 之前设置）
+   *
+   * 启用后读线程只负责把数据块入队，数据回调、帧解码与块回调之外的交付在内部交付线程中执行；
+   * 队列满时按 policy 处理，所有丢弃都计入 queueStats()。启用队列时环形缓冲不生效。
+   *
+   * @param max_chunks 最多排队的数据块数，传 0 表示关闭
+   * @param max_bytes 最多排队的字节数，0 表示只限制块数
+   * @param policy 队列满时的处理策略
+   * @return 返回自身引用以支持链式调用
+   */
+  SerialPort& setRxQueue(size_t max_chunks, size_t max_bytes = 0, RxQueue::Overflow policy = RxQueue::Overflow::Block);
+
+  /**
+   * @brief 设置慢消费者回调（队列占用字节数越过阈值时在读线程中触发一次，回落到一半以下后重新布防）
+   * @param threshold_bytes 触发阈值（字节），0 表示关闭
+   * @param cb 回调函数，参数为触发时的队列统计，不应阻塞
+   * @return 返回自身引用以支持链式调用
+   */
+  SerialPort& setSlowConsumerCallback(size_t threshold_bytes, RxQueue::SlowConsumerCallback cb);
+
+  /**
+   * @brief 获取接收队列统计信息（任意线程可调用）
+   * @return 统计信息，未启用接收队列时各项为 0
+   */
+  RxQueue::Stats queueStats() const;
+
+  /**
+   * @brief 启用异步发送（需在 open() 之前设置）
+   * @param enable true 表示启用，open() 时启动写线程
+   * @param max_batch_bytes 写线程一次合并写出的最大字节数
+   * @return 返回自身引用以支持链式调用
+   */
+  SerialPort& setAsyncWrite(bool enable, size_t max_batch_bytes = 64 * 1024);
+
+  /**
+   * @brief 设置批量数据的分片时长（启用异步发送时有效）
+   *
+   * 普通通道的数据按此时长换算成字节数（依据当前串口参数的单字节传输时间）分片写出，
+   * 并按线路速率控制节拍，使内核发送缓冲中最多积压约一个分片；分片之间检查紧急通道，
+   * 因此紧急条目的最坏排队时延约为一个分片时间。0 表示不分片（默认）。
+   * @param slice_us 分片时长（微秒）
+   * @return 返回自身引用以支持链式调用
+   */
+  SerialPort& setTxSlice(uint32_t slice_us);
+
+  /**
+   * @brief 启用按波特率的发送节拍控制（需在 open() 之前设置）
+   *
+   * 用于接收 FIFO 很小且没有流控的设备：按令牌桶把数据分块写出，块之间在锁外精确等待，
+   * 并在帧之间插入帧间隔。节拍在写线程中执行，启用时自动启用异步发送；
+   * 此时 write() 也交给写线程写出并等待完成（不能在写完成回调中调用 write()）。
+   * @param enable true 表示启用
+   * @param config 令牌桶配置
+   * @return 返回自身引用以支持链式调用
+   */
+  SerialPort& setTxPacing(bool enable, const TxPacer::Config& config = TxPacer::Config());
+
+  /**
+   * @brief 获取发送节拍统计信息（任意线程可调用）
+   * @return 统计信息，未启用节拍控制时各项为 0
+   */
+  TxPacer::Stats pacingStats() const;
+
+  /**
+   * @brief 异步发送：放入发送队列后立即返回（任意线程可调用，无锁）
+   * @param data 要发送的数据
+   * @param done 完成回调，在写线程中调用，可为空
+   * @param priority 发送通道，Urgent 在普通数据的分片之间优先写出
+   * @return 未启用异步发送或串口未打开时返回 false（不调用 done）
+   */
+  bool writeAsync(std::string data, TxQueue::Completion done = nullptr,
+                  TxQueue::Priority priority = TxQueue::Priority::Normal);
+
+  /**
+   * @brief 获取发送队列统计信息（任意线程可调用）
+   * @return 统计信息，未启用异步发送时各项为 0
+   */
+  TxQueue::Stats txStats() const;
+
+  /**
+   * @brief 设置数据回调的合并条件（需在 open() 之前设置）
+   *
+   * 满足任一条件即交付：暂存数据达到 min_bytes 字节，或第一个未交付字节已等待 max_delay_us 微秒；
+   * 关闭串口时剩余数据会被交付。合并后的视图指向内部暂存缓冲区，仅在回调期间有效。
+   *
+   * @param min_bytes 字节数条件，传 0 表示关闭合并
+   * @param max_delay_us 附加延迟上限（微秒）
+   * @return 返回自身引用以支持链式调用
+   */
+  SerialPort& setCoalescing(size_t min_bytes, uint32_t max_delay_us);
+
+  /**
+   * @brief 获取回调合并统计信息（任意线程可调用）
+   */
+  CallbackCoalescer::Stats coalesceStats() const;
+
+  /**
+   * @brief 设置是否同时记录墙上时钟时间戳（默认只记录单调时钟）
+   * @param enable true 表示记录
+   * @return 返回自身引用以支持链式调用
+   */
+  SerialPort& setRealtimeTimestamps(bool enable);
+
+  /**
+   * @brief 获取延迟直方图快照（任意线程可调用，无需停止读取）
+   */
+  LatencyStats latencyStats() const;
+
+  /**
+   * @brief 清空延迟直方图
+   */
+  void resetLatencyStats();
+
+  /**
+   * @brief 启用驱动与转换芯片的低延迟设置（仅 Linux，需在 open() 之前设置）
+   *
+   * 每次打开与重连后：通过 TIOCSSERIAL 设置 ASYNC_LOW_LATENCY，接收数据不再经工作队列延后交给读者；
+   * 设备带有 latency_timer 属性（FTDI 等 USB 转串口芯片，默认 16ms，未满包的数据要等计时器到期才上报）时
+   * 把它调到 latency_timer_ms，写 sysfs 需要相应权限，无权限时只记录当前值。
+   * 实际生效的设置与检测到的驱动见 latencyTuning()。
+   * @param enable true 表示启用
+   * @param latency_timer_ms 目标 latency_timer（毫秒，1 ~ 255）
+   * @return 返回自身引用以支持链式调用
+   */
+  SerialPort& setLowLatency(bool enable, uint32_t latency_timer_ms = 1);
+
+  /**
+   * @brief 获取最近一次打开或重连后的延迟调优结果（任意线程可调用）
+   */
+  LatencyTuning latencyTuning() const;
+
   /**
    * @brief 设置日志输出回调函数
    * @param cb 回调函数，参数为日志级别与内容
@@ -191,6 +836,11 @@ class SerialPort
    */
   bool isOpen() const;
 
+  /**
+   * @brief 获取连接状态（任意线程可调用，无锁）
+   */
+  LinkState linkState() const;
+
   /**
    * @brief 向串口发送数据
    * @param data 要发送的字符串数据
@@ -198,12 +848,155 @@ class SerialPort
    */
   size_t write(const std::string& data);
 
+  /**
+   * @brief 聚集写：把多段数据按顺序作为一次写出，不先拼接到临时缓冲区
+   * @param buffers 数据段数组
+   * @param count 段数
+   * @return 实际写入的总字节数，超时时可能停在某一段中间
+   */
+  size_t write(const serial::IoVec* buffers, size_t count);
+
+  /**
+   * @brief 聚集写（便捷形式）：sp.write({{header, 4}, {payload.data(), payload.size()}})
+   */
+  size_t write(std::initializer_list<serial::IoVec> buffers);
+
+#if !defined(_WIN32)
+  /**
+   * @brief 获取串口文件描述符（外部事件循环模式下注册到用户的循环中）
+   * @return 文件描述符，未打开时返回 -1；所有权仍属于 SerialPort，调用方不得关闭
+   */
+  int nativeHandle() const;
+
+  /**
+   * @brief 需要关注的 poll 事件位（POLLIN，与 EPOLLIN 取值相同）
+   */
+  short pollEvents() const;
+
+  /**
+   * @brief 事件循环最多等待的微秒数（合并缓冲的截止时间）
+   * @return 没有待交付的合并数据时返回 -1（可一直等待）
+   */
+  int64_t nextTimeoutUs() const;
+
+  /**
+   * @brief fd 可读或报告错误时调用：非阻塞读取全部已到达数据并交付
+   *
+   * 可读却读不到数据时认为设备已断开，关闭串口（isOpen() 返回 false）。
+   *
+   * @return 本次读取的字节数
+   */
+  size_t onReadable();
+
+  /**
+   * @brief 随时可调用：非阻塞读取已到达的数据（不做断开判断），并交付到期的合并数据
+   * @return 本次读取的字节数
+   */
+  size_t pump();
+#endif
+
  private:
+  /**
+   * @brief 启动读线程（以及环形缓冲的消费线程）
+   */
+  void startReader();
+
   /**
    * @brief 停止数据读取线程（内部使用）
    */
   void stop();
 
+  /**
+   * @brief 停止环形缓冲的消费线程，退出前取完剩余数据
+   */
+  void stopRing();
+
+  /**
+   * @brief 启动异步发送的写线程
+   */
+  void startWriter();
+
+  /**
+   * @brief 写完已提交的数据后停止写线程
+   */
+  void stopWriter();
+
+  /**
+   * @brief 写线程主循环
+   */
+  void writerLoop();
+
+  /**
+   * @brief 把一批普通条目分片写出并逐条完成，分片之间插入紧急条目
+   * @param batch 按提交顺序排列的条目
+   * @param urgent 紧急条目的复用数组
+   * @param iov 复用的数据段数组
+   */
+  void writeBatch(std::vector<TxQueue::Item>& batch, std::vector<TxQueue::Item>& urgent,
+                  std::vector<serial::IoVec>& iov);
+
+  /**
+   * @brief 取出紧急通道中的全部条目，一次写出并逐条完成
+   */
+  void writeUrgent(std::vector<TxQueue::Item>& urgent, std::vector<serial::IoVec>& iov);
+
+  /**
+   * @brief 执行一次聚集写，启用节拍控制时按令牌桶分块写出
+   * @param iov 数据段
+   * @param frame_start 是否为一帧的开始（需满足帧间隔）
+   * @return 实际写出的字节数
+   */
+  size_t writeGather(const std::vector<serial::IoVec>& iov, bool frame_start);
+
+  /**
+   * @brief 持锁执行一次聚集写，并更新发送缓冲排空时刻的估算
+   * @return 实际写出的字节数，出错时为 0
+   */
+  size_t writeLocked(const serial::IoVec* buffers, size_t count);
+
+  /**
+   * @brief 节拍模式下的同步写：交给写线程写出并等待完成
+   * @return 实际写出的字节数
+   */
+  size_t writePaced(std::string data);
+
+  /**
+   * @brief 按写出的字节数依提交顺序完成一组条目
+   */
+  void completeItems(std::vector<TxQueue::Item>& items, size_t written);
+
+  /**
+   * @brief 环形缓冲消费线程主循环
+   */
+  void ringConsumerLoop();
+
+  /**
+   * @brief 关闭接收队列并等待交付线程取完剩余数据后退出
+   */
+  void stopQueue();
+
+  /**
+   * @brief 接收队列交付线程主循环
+   */
+  void queueConsumerLoop();
+
+  /**
+   * @brief 把读满的数据块放入接收队列（Block 策略下等待期间可被 stop() 打断）
+   */
+  void enqueue(RxBlock&& block);
+
+  /**
+   * @brief 等待环形缓冲中有数据
+   * @param wait_us 最长等待时间（微秒），负数表示一直等待直到有数据或停止
+   * @return 环中有数据返回 true
+   */
+  bool waitRing(int64_t wait_us);
+
+  /**
+   * @brief 生产者写入后通知可能在等待的消费者
+   */
+  void notifyRing();
+
   /**
    * @brief 数据读取循环函数（后台线程）
    *
@@ -212,9 +1005,237 @@ class SerialPort
   void readLoop();
 
   /**
-   * @brief 串口断开时尝试重连
+   * @brief 在读线程中应用线程配置（失败只记录警告）
+   * @param buffer 需要预先触碰的接收缓冲区
+   */
+  void applyThreadProfile(std::vector<uint8_t>& buffer);
+
+  /**
+   * @brief 轮询模式的读取循环（带超时读取 + 空闲休眠）
+   * @param buffer 复用的接收缓冲区
+   */
+  void pollingReadLoop(std::vector<uint8_t>& buffer);
+
+#if !defined(_WIN32)
+  /**
+   * @brief 事件驱动模式的读取循环（poll 阻塞等待串口 fd 与唤醒 fd）
+   * @param buffer 复用的接收缓冲区
+   */
+  void eventReadLoop(std::vector<uint8_t>& buffer);
+
+  /**
+   * @brief 创建唤醒管道（幂等）
+   * @return 成功返回 true
+   */
+  bool openWakeup();
+
+  /**
+   * @brief 关闭唤醒管道
+   */
+  void closeWakeup();
+
+  /**
+   * @brief 唤醒阻塞在 poll 上的读线程
+   */
+  void wakeup();
+#endif
+
+  /**
+   * @brief 是否由 poll/epoll 等待数据（事件驱动模式或使用反应器）
+   */
+  bool eventDriven() const;
+
+#if !defined(_WIN32)
+  /**
+   * @brief 外部事件循环模式下非阻塞读取并交付
+   * @param readable 调用方是否已确认 fd 就绪（就绪却读不到数据视为断开）
+   * @return 本次读取的字节数
+   */
+  size_t drainExternal(bool readable);
+#endif
+
+  /**
+   * @brief 把串口 fd 注册到反应器
+   * @return 成功返回 true；失败时调用方回退为独立读线程
    */
-  void reconnect();
+  bool attachReactor();
+
+  /**
+   * @brief 从反应器注销串口 fd 与合并定时器，返回后不再有回调在反应器线程中运行
+   */
+  void detachReactor();
+
+  /**
+   * @brief 反应器线程中处理串口 fd 事件
+   * @param events epoll 事件位
+   * @param buffer 反应器线程的复用接收缓冲区
+   * @return 返回 false 表示串口已断开，需从反应器注销
+   */
+  bool onReactorReadable(uint32_t events, std::vector<uint8_t>& buffer);
+
+  /**
+   * @brief 反应器线程中处理合并定时器到期
+   */
+  bool onReactorTimer();
+
+  /**
+   * @brief 按合并缓冲的截止时间设置定时器（反应器模式下代替限时 poll）
+   */
+  void armCoalesceTimer();
+
+  /**
+   * @brief 从串口读取一次数据并交付（启用接收块池时读入池中的数据块）
+   * @param buffer 未启用接收块池（或 Drop 策略丢弃数据）时使用的复用缓冲区
+   * @return 读取的字节数；Block 策略下等待空闲块期间读线程被停止时返回 0
+   */
+  size_t readChunk(std::vector<uint8_t>& buffer);
+
+  /**
+   * @brief 为刚读到的数据块打时间戳并记录到达间隔
+   */
+  RxTimestamp stampChunk();
+
+  /**
+   * @brief 将一段接收数据交付给用户回调
+   * @param data 数据起始地址（读线程复用缓冲区）
+   * @param size 数据长度
+   * @param stamp 接收时间戳
+   */
+  void deliver(const uint8_t* data, size_t size, const RxTimestamp& stamp);
+
+  /**
+   * @brief 把一段数据交给用户：先调用数据回调，再送入帧解码器
+   * @param data 数据起始地址
+   * @param size 数据长度
+   * @param stamp 接收时间戳（未知时为 0）
+   */
+  void dispatch(const uint8_t* data, size_t size, const RxTimestamp& stamp);
+
+  /**
+   * @brief 调用数据回调并记录执行时间
+   */
+  void callDataCallback(const uint8_t* data, size_t size, const RxTimestamp& stamp);
+
+  /**
+   * @brief 交付线程空闲时最多等待的微秒数（合并缓冲的截止时间）
+   * @return 没有待交付的合并数据时返回 -1（可一直等待）
+   */
+  int64_t coalesceWaitUs() const;
+
+  /**
+   * @brief 合并缓冲截止时间已到时交付（交付线程空闲时调用）
+   */
+  void pollCoalesced();
+
+  /**
+   * @brief 交付合并缓冲中的剩余数据（交付线程退出前调用）
+   */
+  void flushCoalesced();
+
+  /**
+   * @brief 读线程是否直接执行回调（未启用环形缓冲与接收队列）
+   */
+  bool readerDelivers() const;
+
+  /**
+   * @brief 按当前读取模式生成 serial 库的超时配置
+   */
+  serial::Timeout makeTimeout() const;
+
+  /**
+   * @brief 读路径检测到断开：切换到 Reconnecting 并交给重连线程，自身不阻塞
+   */
+  void linkLost();
+
+  /**
+   * @brief 读线程检测到断开：交给重连线程后等待其结果，放弃重连或 close() 开始时结束读循环
+   */
+  void readerLinkLost();
+
+  /**
+   * @brief 启动重连线程
+   */
+  void startReconnector();
+
+  /**
+   * @brief 停止重连线程
+   */
+  void stopReconnector();
+
+  /**
+   * @brief 重连线程主循环
+   */
+  void reconnectLoop();
+
+  /**
+   * @brief 关闭失效的串口，按退避策略重试直到成功、放弃或 close() 开始
+   */
+  void recover();
+
+  /**
+   * @brief 重连成功后切换到 Open 并恢复读路径
+   * @return close() 已经开始时返回 false
+   */
+  bool resumeLink();
+
+  /**
+   * @brief 第 attempt 次重试前的等待时间（含抖动）
+   */
+  uint32_t backoffDelayMs(size_t attempt) const;
+
+  /**
+   * @brief 设备节点当前是否存在（绑定身份时按身份查找，否则 POSIX 检查路径，其他平台总是返回 true）
+   */
+  bool deviceNodePresent() const;
+
+  /**
+   * @brief 监视线程中处理设备节点事件
+   */
+  void onHotplug(const DeviceWatcher::Event& event);
+
+  /**
+   * @brief 绑定身份时确定要打开的设备节点（需持有 tx_mtx_ 或尚未启动读写路径）
+   */
+  void resolveDevice();
+
+  /**
+   * @brief 打开或重连成功后应用低延迟设置并记录结果（需持有 tx_mtx_ 或尚未启动读写路径）
+   */
+  void tuneLatency();
+
+  /**
+   * @brief 打开成功后切换到 Open 并启动读写线程
+   * @param msg 日志内容
+   * @return 打开期间 close() 已经开始时返回 false
+   */
+  bool openDone(const char* msg);
+
+  /**
+   * @brief 无条件切换连接状态并唤醒等待者
+   */
+  void setState(LinkState state);
+
+  /**
+   * @brief 仅当当前状态为 from 时切换到 to
+   * @return 是否切换成功
+   */
+  bool transition(LinkState from, LinkState to);
+
+  /**
+   * @brief 重试间隔等待，状态离开 expected（如 close() 开始）时提前返回；
+   *        等待开始时设备节点不存在、期间重新出现时也提前返回
+   * @param delay_ms 等待时间
+   * @param expected 等待期间应保持的状态
+   * @param appeared 输出：是否因设备节点重新出现而提前返回（可为空）
+   * @return 等待结束时状态仍为 expected 返回 true
+   */
+  bool backoff(uint32_t delay_ms, LinkState expected, bool* appeared = nullptr);
+
+  /**
+   * @brief 等待打开或重连结束
+   * @return 结束后状态为 Open 时返回 true
+   */
+  bool waitLinkUp();
 
   /**
    * @brief 从另一个 SerialPort 对象移动资源
@@ -230,16 +1251,100 @@ class SerialPort
   void logMsg(LogLevel level, const std::string& msg);
 
  private:
-  serial::Serial serial_;            ///< serial 库的串口对象
-  std::string port_;                 ///< 串口名称
-  uint32_t baudrate_{0};             ///< 波特率
-  size_t reconnect_max_{0};          ///< 最大重连次数（0 表示不重连）
-  uint32_t timeout_ms_{10};          ///< 读超时时间（默认 10ms）
-  std::atomic_bool running_{false};  ///< 读线程运行标志
-  std::thread reader_thread_;        ///< 后台读取线程
-  std::mutex mtx_;                   ///< 串口访问互斥锁
-  DataCallback data_cb_;             ///< 数据接收回调
-  LogCallback log_cb_;               ///< 日志回调
+  serial::Serial serial_;                  ///< serial 库的串口对象
+  std::string port_;                       ///< 串口名称
+  uint32_t baudrate_{0};                   ///< 波特率
+  size_t reconnect_max_{0};                ///< 最大重连次数（0 表示不重连）
+  uint32_t timeout_ms_{10};                ///< 读超时时间（默认 10ms）
+  ReadMode read_mode_{ReadMode::Polling};  ///< 读线程工作模式
+  std::atomic_bool running_{false};        ///< 读线程运行标志
+  std::thread reader_thread_;              ///< 后台读取线程
+
+  std::atomic<LinkState> state_{LinkState::Closed};  ///< 连接状态
+  std::mutex life_mtx_;                              ///< 串行化 open()/close()（读写路径从不获取）
+  std::mutex tx_mtx_;                                ///< 发送路径互斥锁：串行化写出，并防止写出期间关闭串口
+  std::mutex state_mtx_;                             ///< 状态等待互斥锁（仅配合 state_cv_）
+  std::condition_variable state_cv_;                 ///< 状态变化通知：打断重试等待、唤醒等待连接的写线程
+  StateCallback state_cb_;                           ///< 连接状态变化回调
+
+  ReconnectPolicy reconnect_policy_;             ///< 重连退避策略
+  std::thread reconnect_thread_;                 ///< 重连线程
+  bool reconnect_quit_{false};                   ///< 重连线程退出标志（受 state_mtx_ 保护）
+  std::atomic<int64_t> lost_ns_{0};              ///< 最近一次检测到断开的时间
+  std::atomic<uint64_t> disconnects_{0};         ///< 断开次数
+  std::atomic<uint64_t> recoveries_{0};          ///< 重连成功次数
+  std::atomic<uint64_t> give_ups_{0};            ///< 放弃重连次数
+  std::atomic<uint64_t> reconnect_attempts_{0};  ///< 累计重试次数
+  std::atomic<int64_t> last_recovery_ns_{0};     ///< 最近一次恢复耗时
+  LatencyHistogram recovery_hist_;               ///< 恢复耗时
+
+  std::shared_ptr<DeviceWatcher> watcher_;      ///< 热插拔监视器（未启用时为空）
+  DeviceIdentity identity_;                     ///< 绑定的设备身份
+  uint64_t watch_id_{0};                        ///< 监视器订阅号
+  std::unique_ptr<PortEnumerator> enumerator_;  ///< 按身份查找节点与延迟调优（打开时创建，与监视器目录相同）
+  uint64_t hotplug_seq_{0};                     ///< 匹配的节点出现次数（受 state_mtx_ 保护）
+  uint64_t hotplug_seen_{0};                    ///< 重试等待已处理到的出现次数（受 state_mtx_ 保护）
+  std::string hotplug_node_;                    ///< 最近出现的满足身份的节点（受 state_mtx_ 保护）
+
+  DataViewCallback data_cb_;               ///< 数据接收回调（视图形式）
+  LogCallback log_cb_;                     ///< 日志回调
+  std::unique_ptr<FrameDecoder> decoder_;  ///< 帧解码器（未启用时为空）
+  FrameCallback frame_cb_;                 ///< 帧回调
+  std::shared_ptr<RxBlockPool> pool_;      ///< 接收块池（未启用时为空）
+  BlockCallback block_cb_;                 ///< 接收块回调
+
+  std::unique_ptr<RxQueue> queue_;         ///< 有界接收队列（未启用时为空）
+  std::thread queue_thread_;               ///< 接收队列交付线程
+  size_t slow_threshold_{0};               ///< 慢消费者阈值（字节）
+  RxQueue::SlowConsumerCallback slow_cb_;  ///< 慢消费者回调
+
+  CallbackCoalescer coalescer_;                     ///< 数据回调合并器
+  CallbackCoalescer::DeliverCallback coalesce_cb_;  ///< 合并后交付给数据回调
+
+  ThreadProfile thread_profile_;  ///< 读线程配置
+
+  std::shared_ptr<PortReactor> reactor_;  ///< 共享反应器（未启用时为空）
+  uint64_t reactor_id_{0};                ///< 串口 fd 的注册号
+  uint64_t timer_id_{0};                  ///< 合并定时器的注册号
+  int timer_fd_{-1};                      ///< 合并定时器（timerfd，按需创建）
+  int64_t timer_deadline_ns_{-1};         ///< 定时器当前的到期时间
+  std::mutex reactor_mtx_;                ///< 串行化同一串口的 fd 事件与定时器事件
+
+  bool external_{false};              ///< 当前是否由外部事件循环驱动
+  std::vector<uint8_t> pump_buffer_;  ///< 外部事件循环模式的接收缓冲区
+
+  std::unique_ptr<TxQueue> tx_queue_;   ///< 异步发送队列（未启用时为空）
+  std::thread writer_thread_;           ///< 异步发送写线程
+  std::atomic_bool tx_running_{false};  ///< 是否接受异步发送
+  size_t tx_batch_bytes_{64 * 1024};    ///< 一次合并写出的最大字节数
+
+  uint32_t tx_slice_us_{0};     ///< 批量数据分片时长（微秒，0 不分片）
+  int64_t tx_line_free_ns_{0};  ///< 估算的内核发送缓冲排空时刻（仅写线程访问）
+
+  std::unique_ptr<TxPacer> pacer_;       ///< 发送节拍控制（未启用时为空）
+  std::vector<serial::IoVec> pace_iov_;  ///< 节拍分块用的数据段（仅写线程访问）
+
+  bool realtime_stamps_{false};     ///< 是否记录墙上时钟时间戳
+  int64_t last_chunk_ns_{0};        ///< 上一个数据块的到达时间（仅读线程访问）
+  LatencyHistogram gap_hist_;       ///< 相邻数据块到达间隔
+  LatencyHistogram callback_hist_;  ///< 回调执行时间
+  LatencyHistogram dwell_hist_;     ///< 接收队列停留时间
+
+  bool low_latency_{false};        ///< 是否启用低延迟设置
+  uint32_t latency_timer_ms_{1};   ///< 目标 latency_timer（毫秒）
+  LatencyTuning tuning_;           ///< 最近一次的调优结果（受 tuning_mtx_ 保护）
+  mutable std::mutex tuning_mtx_;  ///< 调优结果互斥锁
+
+  std::unique_ptr<SpscRing> ring_;                      ///< 接收环形缓冲（未启用时为空）
+  RingConsumer ring_consumer_{RingConsumer::Internal};  ///< 环形缓冲消费方式
+  std::thread ring_thread_;                             ///< 环形缓冲消费线程
+  std::atomic_bool ring_running_{false};                ///< 消费线程运行标志
+  std::atomic_bool ring_waiting_{false};                ///< 消费者是否正在等待数据
+  std::mutex ring_mtx_;                                 ///< 消费者休眠/唤醒互斥锁
+  std::condition_variable ring_cv_;                     ///< 消费者休眠/唤醒条件变量
+#if !defined(_WIN32)
+  int wakeup_fds_[2]{-1, -1};  ///< 唤醒管道 [读端, 写端]，用于打断 poll
+#endif
 };
 
 #endif  // SERIAL_PORT_H
@@ -0,0 +1,125 @@
+#pragma once
+#ifndef SERIAL_PORT_SPSC_RING_H
+#define SERIAL_PORT_SPSC_RING_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+
+#include "serialport/cache_aligned.h"
+
+/**
+ * @brief 无锁单生产者/单消费者字节环形缓冲区
+ *
+ * - 生产者（读线程）只调用 push()，消费者只调用 pop()/consume()，两者之间不需要任何锁。
+ * - 读写索引分别独占一条缓存行，并各自缓存对端索引，避免伪共享与频繁的跨核读取；
+ *   对象按缓存行对齐分配，索引所在的缓存行不会与相邻的堆数据共享。
+ * - 容量向上取整为 2 的幂；空间不足时多余字节被丢弃并计入溢出计数，不会阻塞生产者。
+ * - 统计计数（高水位、溢出）只由生产者更新，任意线程均可读取。
+ */
+class alignas(CacheAligned::kCacheLine) SpscRing : public CacheAligned
+{
+ public:
+  /// 批量消费回调类型（参数为环内连续区段的只读视图，仅在回调期间有效）
+  using ConsumeCallback = std::function<void(const uint8_t*, size_t)>;
+
+  /**
+   * @brief 构造环形缓冲区
+   * @param capacity 期望容量（字节），向上取整为 2 的幂，最小 64
+   */
+  explicit SpscRing(size_t capacity);
+
+  // 禁止复制与移动
+  SpscRing(const SpscRing&) = delete;
+  SpscRing& operator=(const SpscRing&) = delete;
+
+  /**
+   * @brief 写入数据（仅生产者调用）
+   * @param data 数据起始地址
+   * @param size 数据长度
+   * @return 实际写入的字节数，不足 size 的部分计入溢出
+   */
+  size_t push(const uint8_t* data, size_t size);
+
+  /**
+   * @brief 读出数据到用户缓冲区（仅消费者调用）
+   * @param out 输出缓冲区
+   * @param size 输出缓冲区大小
+   * @return 实际读出的字节数
+   */
+  size_t pop(uint8_t* out, size_t size);
+
+  /**
+   * @brief 零拷贝批量消费（仅消费者调用）
+   *
+   * 当前可读数据最多分两段（环回绕时）交给回调，回调返回后统一释放空间。
+   *
+   * @param cb 消费回调
+   * @param max_bytes 本次最多消费的字节数
+   * @return 实际消费的字节数
+   */
+  size_t consume(const ConsumeCallback& cb, size_t max_bytes = static_cast<size_t>(-1));
+
+  /// 当前可读字节数（近似值，跨线程读取时仅供参考）
+  size_t size() const;
+
+  /// 是否为空
+  bool empty() const
+  {
+    return size() == 0;
+  }
+
+  /// 实际容量（字节）
+  size_t capacity() const
+  {
+    return capacity_;
+  }
+
+  /// 历史最高占用字节数
+  size_t highWaterMark() const
+  {
+    return high_water_.load(std::memory_order_relaxed);
+  }
+
+  /// 因空间不足被丢弃的总字节数
+  uint64_t overflowBytes() const
+  {
+    return overflow_bytes_.load(std::memory_order_relaxed);
+  }
+
+  /// 发生溢出的次数（一次 push 丢弃数据计一次）
+  uint64_t overflowEvents() const
+  {
+    return overflow_events_.load(std::memory_order_relaxed);
+  }
+
+  /// 累计写入成功的字节数
+  uint64_t pushedBytes() const
+  {
+    return pushed_bytes_.load(std::memory_order_relaxed);
+  }
+
+ private:
+  // 生产者独占的缓存行：写索引 + 对读索引的本地缓存
+  std::atomic<size_t> head_{0};
+  size_t cached_tail_{0};
+  char pad0_[kCacheLine - sizeof(std::atomic<size_t>) - sizeof(size_t)];
+
+  // 消费者独占的缓存行：读索引 + 对写索引的本地缓存
+  std::atomic<size_t> tail_{0};
+  size_t cached_head_{0};
+  char pad1_[kCacheLine - sizeof(std::atomic<size_t>) - sizeof(size_t)];
+
+  // 只读配置与统计计数（统计由生产者写入，远离两个索引所在的缓存行）
+  size_t capacity_;
+  size_t mask_;
+  std::unique_ptr<uint8_t[]> storage_;
+  std::atomic<size_t> high_water_{0};
+  std::atomic<uint64_t> overflow_bytes_{0};
+  std::atomic<uint64_t> overflow_events_{0};
+  std::atomic<uint64_t> pushed_bytes_{0};
+};
+
+#endif  // SERIAL_PORT_SPSC_RING_H
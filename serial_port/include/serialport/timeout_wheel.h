@@ -0,0 +1,79 @@
+#pragma once
+#ifndef SERIAL_PORT_TIMEOUT_WHEEL_H
+#define SERIAL_PORT_TIMEOUT_WHEEL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief 哈希时间轮（单线程使用，调用方负责加锁）
+ *
+ * 截止时间按 tick 映射到环形槽位，添加为 O(1)，推进时只检查经过的槽位；
+ * 超过一圈的截止时间留在槽中，等转到对应的圈数再到期。
+ * 删除时以添加时的截止时间定位槽位，只扫描该槽位，因此 empty() 为真即表示没有未完成的条目。
+ */
+class TimeoutWheel
+{
+ public:
+  /**
+   * @brief 构造时间轮
+   * @param tick_ns 每个槽位代表的时长（纳秒），即超时精度
+   * @param slots 槽位数（一圈覆盖 tick_ns * slots）
+   */
+  explicit TimeoutWheel(int64_t tick_ns = 1000000, size_t slots = 1024);
+
+  /**
+   * @brief 添加一个条目
+   * @param id 条目标识
+   * @param deadline_ns 截止时间（steady_clock 纳秒）
+   */
+  void add(uint64_t id, int64_t deadline_ns);
+
+  /**
+   * @brief 推进到当前时间，取出所有已到期的条目
+   * @param now_ns 当前时间（steady_clock 纳秒）
+   * @param expired 输出：到期条目的 id（追加）
+   */
+  void advance(int64_t now_ns, std::vector<uint64_t>& expired);
+
+  /**
+   * @brief 删除一个尚未到期的条目
+   * @param id 条目标识
+   * @param deadline_ns 添加时的截止时间（用于定位槽位）
+   * @return 找到并删除返回 true，已到期或不存在返回 false
+   */
+  bool cancel(uint64_t id, int64_t deadline_ns);
+
+  /**
+   * @brief 条目数
+   */
+  size_t size() const { return count_; }
+
+  /**
+   * @brief 是否没有任何条目
+   */
+  bool empty() const { return count_ == 0; }
+
+  /**
+   * @brief 每个槽位代表的时长（纳秒）
+   */
+  int64_t tickNs() const { return tick_ns_; }
+
+ private:
+  /**
+   * @brief 槽位中的条目
+   */
+  struct Entry
+  {
+    uint64_t id;          ///< 条目标识
+    int64_t deadline_ns;  ///< 截止时间
+  };
+
+  std::vector<std::vector<Entry>> slots_;  ///< 环形槽位
+  int64_t tick_ns_;                        ///< 每个槽位的时长
+  int64_t current_tick_{0};                ///< 已处理到的 tick
+  size_t count_{0};                        ///< 条目数
+};
+
+#endif  // SERIAL_PORT_TIMEOUT_WHEEL_H
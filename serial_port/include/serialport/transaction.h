@@ -0,0 +1,218 @@
+#pragma once
+#ifndef SERIAL_PORT_TRANSACTION_H
+#define SERIAL_PORT_TRANSACTION_H
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <future>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "serialport/latency_histogram.h"
+#include "serialport/serialport.h"
+#include "serialport/timeout_wheel.h"
+
+/**
+ * @brief 请求/应答关联引擎（流水线）
+ *
+ * 建立在 SerialPort 的帧解码之上：发送请求时登记其关联键，收到的每一帧经用户提供的键提取函数
+ * 得到关联键后与在途请求匹配（同一键有多个在途请求时按发送顺序匹配）。
+ * 最多 depth 个请求同时在途，其余按提交顺序排队；每个请求有自己的超时（从提交开始计时），
+ * 由时间轮统一管理。完成方式可以是 std::future 或回调。
+ *
+ *    TransactionEngine engine(sp, [](const SerialPort::DataView &frame, std::string &key) {
+ *        if (frame.size < 2) return false;
+ *        key.assign(reinterpret_cast<const char *>(frame.data), 2);  // 前两个字节为序号
+ *        return true;
+ *    }, 8);
+ *    TransactionEngine::Request req;
+ *    req.type = "read_reg";
+ *    req.key = "07";
+ *    req.payload = "07R0100\r\n";
+ *    req.timeout_ms = 100;
+ *    auto resp = engine.submit(req).get();
+ *
+ * 引擎接管串口的帧回调，需先为串口设置帧解码器，并在 open() 之前构造、close() 之后析构。
+ * 回调在串口读线程或引擎的定时线程中执行，不应阻塞。
+ */
+class TransactionEngine
+{
+ public:
+  /**
+   * @brief 键提取函数：从一帧中取出关联键，返回 false 表示该帧不是应答（交给未匹配帧回调）
+   */
+  using KeyExtractor = std::function<bool(const SerialPort::DataView& frame, std::string& key)>;
+
+  /**
+   * @brief 完成状态
+   */
+  enum class Status
+  {
+    Ok,           ///< 收到匹配的应答
+    Timeout,      ///< 截止时间前未收到应答
+    WriteFailed,  ///< 请求未能完整写出
+    Cancelled     ///< 引擎析构或 cancelAll() 时仍未完成
+  };
+
+  /**
+   * @brief 请求
+   */
+  struct Request
+  {
+    std::string type;           ///< 事务类型（用于分类统计往返时延）
+    std::string key;            ///< 关联键，应答帧提取出的键与之相等时匹配
+    std::string payload;        ///< 要发送的数据
+    uint32_t timeout_ms{1000};  ///< 超时（毫秒，从提交开始计时）
+  };
+
+  /**
+   * @brief 应答
+   */
+  struct Response
+  {
+    Status status{Status::Cancelled};  ///< 完成状态
+    std::string frame;                 ///< 应答帧（仅 Ok 时有效）
+    int64_t rtt_ns{0};                 ///< 往返时延：开始写出请求到收到应答帧（仅 Ok 时有效）
+  };
+
+  /**
+   * @brief 完成回调类型
+   */
+  using Completion = std::function<void(const Response&)>;
+
+  /**
+   * @brief 某一事务类型的统计
+   */
+  struct TypeStats
+  {
+    uint64_t completed{0};           ///< 收到应答的次数
+    uint64_t timeouts{0};            ///< 超时次数
+    uint64_t failures{0};            ///< 写失败与取消次数
+    LatencyHistogram::Snapshot rtt;  ///< 往返时延直方图
+  };
+
+  /**
+   * @brief 构造引擎并接管串口的帧回调
+   * @param port 串口（需已设置帧解码器）
+   * @param extractor 键提取函数
+   * @param depth 最大在途请求数（流水线深度），0 按 1 处理
+   * @param tick_ms 超时时间轮的精度（毫秒）
+   */
+  TransactionEngine(SerialPort& port, KeyExtractor extractor, size_t depth = 1, uint32_t tick_ms = 1);
+
+  /**
+   * @brief 析构时取消所有未完成的请求
+   */
+  ~TransactionEngine();
+
+  // 禁止复制与移动
+  TransactionEngine(const TransactionEngine&) = delete;
+  TransactionEngine& operator=(const TransactionEngine&) = delete;
+
+  /**
+   * @brief 提交请求，以 future 取得应答
+   */
+  std::future<Response> submit(const Request& request);
+
+  /**
+   * @brief 提交请求，完成时调用回调
+   * @param request 请求
+   * @param done 完成回调（在读线程、定时线程或提交线程中调用）
+   */
+  void submit(const Request& request, Completion done);
+
+  /**
+   * @brief 设置未匹配帧回调（不是应答，或没有在途请求与之匹配的帧）
+   */
+  void setUnsolicitedCallback(SerialPort::FrameCallback cb);
+
+  /**
+   * @brief 以 Cancelled 完成所有在途与排队中的请求
+   */
+  void cancelAll();
+
+  /**
+   * @brief 当前在途请求数
+   */
+  size_t inFlight() const;
+
+  /**
+   * @brief 当前排队（尚未发送）的请求数
+   */
+  size_t queued() const;
+
+  /**
+   * @brief 按事务类型获取统计
+   */
+  std::map<std::string, TypeStats> stats() const;
+
+ private:
+  /**
+   * @brief 一个未完成的请求
+   */
+  struct Pending
+  {
+    Request request;         ///< 请求
+    Completion done;         ///< 完成回调
+    int64_t deadline_ns{0};  ///< 超时截止时间（时间轮中的位置）
+    int64_t sent_ns{0};      ///< 开始写出的时间（0 表示仍在排队）
+  };
+
+  /**
+   * @brief 某一事务类型的计数与直方图
+   */
+  struct TypeCounters
+  {
+    uint64_t completed{0};  ///< 收到应答的次数
+    uint64_t timeouts{0};   ///< 超时次数
+    uint64_t failures{0};   ///< 写失败与取消次数
+    LatencyHistogram rtt;   ///< 往返时延
+  };
+
+  /**
+   * @brief 发送一个已占用在途名额的请求
+   */
+  void send(uint64_t id);
+
+  /**
+   * @brief 帧回调：提取关联键并匹配在途请求
+   */
+  void onFrame(const SerialPort::DataView& frame);
+
+  /**
+   * @brief 完成一个请求，释放名额并发送下一个排队的请求
+   * @return 请求已不存在（已经完成）时返回 false
+   */
+  bool complete(uint64_t id, Status status, const std::string& frame, int64_t now_ns);
+
+  /**
+   * @brief 定时线程：推进时间轮并使到期的请求超时
+   */
+  void timerLoop();
+
+ private:
+  SerialPort& port_;                                                 ///< 串口
+  KeyExtractor extractor_;                                           ///< 键提取函数
+  size_t depth_;                                                     ///< 最大在途请求数
+  SerialPort::FrameCallback unsolicited_cb_;                         ///< 未匹配帧回调
+  mutable std::mutex mtx_;                                           ///< 保护以下状态
+  std::condition_variable cv_;                                       ///< 唤醒定时线程
+  bool stopping_{false};                                             ///< 定时线程退出标志
+  uint64_t next_id_{1};                                              ///< 下一个请求号
+  size_t in_flight_{0};                                              ///< 在途请求数
+  std::unordered_map<uint64_t, Pending> pending_;                    ///< 未完成的请求
+  std::unordered_map<std::string, std::deque<uint64_t>> by_key_;     ///< 关联键 -> 在途请求（发送顺序）
+  std::deque<uint64_t> waiting_;                                     ///< 排队中的请求（提交顺序）
+  std::map<std::string, std::unique_ptr<TypeCounters>> type_stats_;  ///< 按事务类型统计
+  TimeoutWheel wheel_;                                               ///< 超时时间轮
+  std::thread timer_thread_;                                         ///< 定时线程
+};
+
+#endif  // SERIAL_PORT_TRANSACTION_H
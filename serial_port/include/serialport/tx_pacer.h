@@ -0,0 +1,96 @@
+#pragma once
+#ifndef SERIAL_PORT_TX_PACER_H
+#define SERIAL_PORT_TX_PACER_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief 按波特率控制发送节拍的令牌桶（用于没有流控、接收 FIFO 很小的设备）
+ *
+ * - 令牌按线路速率的 rate_percent% 补充（每字节间隔由单字节传输时间换算），桶容量为 burst_bytes，
+ *   通常取设备接收 FIFO 的大小：任一时刻设备侧尚未消化的数据不超过桶容量。
+ * - 每帧的第一块要等上一帧全部发完后再空闲 frame_gap_us（帧间隔）。
+ * - 以虚拟调度（GCRA）实现：状态只有一个原子的"理论排空时刻"，预约只做一次 CAS，不持有任何锁；
+ *   调用方拿到开始时刻后在锁外调用 waitUntil()，先以绝对时间睡眠，截止前 spin_us 改为自旋，精度为微秒级。
+ */
+class TxPacer
+{
+ public:
+  /**
+   * @brief 节拍配置
+   */
+  struct Config
+  {
+    uint32_t burst_bytes{16};    ///< 桶容量（字节），即一次最多连续写出的字节数，0 按 1 处理
+    uint32_t rate_percent{100};  ///< 令牌补充速率占线路速率的百分比（1 ~ 100）
+    uint32_t frame_gap_us{0};    ///< 帧间隔：上一帧发完后的最小线路空闲时间（微秒）
+    uint32_t spin_us{50};        ///< 截止前改为自旋等待的时长（微秒），0 表示只睡眠
+  };
+
+  /**
+   * @brief 节拍统计信息
+   */
+  struct Stats
+  {
+    uint64_t chunks{0};       ///< 预约的块数
+    uint64_t delayed{0};      ///< 需要等待的块数
+    uint64_t wait_ns{0};      ///< 累计等待时间
+    uint64_t max_late_ns{0};  ///< 实际开始时刻晚于预约时刻的最大值（睡眠精度）
+  };
+
+  TxPacer();
+  explicit TxPacer(const Config& config);
+
+  // 禁止复制与移动
+  TxPacer(const TxPacer&) = delete;
+  TxPacer& operator=(const TxPacer&) = delete;
+
+  /**
+   * @brief 设置单字节传输时间（串口打开或参数变化后调用），0 表示未知，此时不做节拍控制
+   */
+  void setByteTime(uint32_t byte_ns);
+
+  /**
+   * @brief 每块的最大字节数（桶容量）
+   */
+  size_t chunkBytes() const;
+
+  /**
+   * @brief 预约一块数据的写出时刻（任意线程，无锁）
+   * @param bytes 块大小，不应超过 chunkBytes()
+   * @param frame_start 是否为一帧的第一块（需满足帧间隔）
+   * @return 最早可以开始写出的时刻（steady_clock 纳秒）
+   */
+  int64_t reserve(size_t bytes, bool frame_start);
+
+  /**
+   * @brief 等待到指定时刻（不持有任何锁）
+   * @param deadline_ns 截止时刻（steady_clock 纳秒），已过去时立即返回
+   */
+  void waitUntil(int64_t deadline_ns);
+
+  /**
+   * @brief 清空节拍状态（下一块立即可写）
+   */
+  void reset();
+
+  /**
+   * @brief 获取统计信息
+   */
+  Stats stats() const;
+
+ private:
+  const Config config_;  ///< 配置
+
+  std::atomic<int64_t> interval_ns_{0};  ///< 每字节的令牌补充间隔（纳秒）
+  std::atomic<int64_t> tat_ns_{0};       ///< 理论排空时刻：已预约的数据按补充速率全部消化的时刻
+
+  std::atomic<uint64_t> chunks_{0};       ///< 预约的块数
+  std::atomic<uint64_t> delayed_{0};      ///< 需要等待的块数
+  std::atomic<uint64_t> wait_ns_{0};      ///< 累计等待时间
+  std::atomic<uint64_t> max_late_ns_{0};  ///< 最大晚醒时间
+};
+
+#endif  // SERIAL_PORT_TX_PACER_H
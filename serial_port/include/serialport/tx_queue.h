@@ -0,0 +1,220 @@
+#pragma once
+#ifndef SERIAL_PORT_TX_QUEUE_H
+#define SERIAL_PORT_TX_QUEUE_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+
+#include "serialport/cache_aligned.h"
+#include "serialport/latency_histogram.h"
+
+/**
+ * @brief 无锁多生产者/单消费者发送队列（生产者线程与写线程之间）
+ *
+ * - 入队只做一次原子交换加一次原子存储，生产者之间不争用任何锁，也不等待写出完成。
+ * - 写线程是唯一的消费者：按提交顺序取出，空闲时在条件变量上休眠；
+ *   生产者只在写线程确实在等待时才加锁唤醒它（与 SpscRing 的等待/唤醒方式相同）。
+ * - 分为普通与紧急两条通道，各自保持提交顺序，共用同一套等待/唤醒；
+ *   写线程在批量数据的分片之间检查紧急通道，紧急条目插到下一个分片之前写出。
+ * - 提交的条目在写出完成（或失败）并调用 finish() 之前都计入排队深度与待发送字节数。
+ * - 写线程释放的节点放回有界的无锁空闲池，生产者优先从池中取节点，稳态下入队不经过全局分配器。
+ * - 通道首尾指针按缓存行对齐，对象本身也通过 CacheAligned 按缓存行对齐分配。
+ */
+class alignas(CacheAligned::kCacheLine) TxQueue : public CacheAligned
+{
+ public:
+  /// 写完成回调类型（在写线程中调用）：ok 表示整条数据已写出，written 为该条实际写出的字节数
+  using Completion = std::function<void(bool ok, size_t written)>;
+
+  /**
+   * @brief 发送优先级（通道）
+   */
+  enum class Priority
+  {
+    Normal,  ///< 普通通道：批量数据，可被分片写出
+    Urgent   ///< 紧急通道：急停、心跳等短命令，在普通数据的分片之间优先写出
+  };
+
+  /**
+   * @brief 一条待发送的数据
+   */
+  struct Item
+  {
+    std::string data;       ///< 数据
+    Completion done;        ///< 完成回调（可为空）
+    int64_t enqueue_ns{0};  ///< 提交时间（单调时钟）
+  };
+
+  /**
+   * @brief 发送队列统计信息
+   */
+  struct Stats
+  {
+    size_t depth{0};               ///< 已提交、尚未完成的条目数
+    size_t bytes_pending{0};       ///< 已提交、尚未完成的字节数
+    size_t high_water_depth{0};    ///< 历史最高条目数
+    size_t high_water_bytes{0};    ///< 历史最高待发送字节数
+    uint64_t submitted{0};         ///< 累计提交条目数
+    uint64_t completed{0};         ///< 累计成功写出的条目数
+    uint64_t failed{0};            ///< 累计写出失败的条目数
+    uint64_t write_calls{0};       ///< 累计底层写调用次数（相邻条目合并后写出）
+    uint64_t bytes_written{0};     ///< 累计写出字节数
+    uint64_t node_allocations{0};  ///< 空闲节点池为空时从堆上分配的节点数
+
+    uint64_t urgent_submitted{0};               ///< 累计提交的紧急条目数
+    LatencyHistogram::Snapshot urgent_latency;  ///< 紧急条目从提交到写出的时延
+  };
+
+  TxQueue();
+
+  /**
+   * @brief 析构时释放仍在队列中的条目（不调用其完成回调）
+   */
+  ~TxQueue();
+
+  // 禁止复制与移动
+  TxQueue(const TxQueue&) = delete;
+  TxQueue& operator=(const TxQueue&) = delete;
+
+  /**
+   * @brief 提交一条数据（任意线程，无锁）
+   */
+  void push(std::string data, Completion done, Priority priority = Priority::Normal);
+
+  /**
+   * @brief 取出队首条目，紧急通道优先（仅写线程调用）
+   * @return 两条通道都为空时返回 false
+   */
+  bool pop(Item& item);
+
+  /**
+   * @brief 从指定通道取出队首条目（仅写线程调用）
+   * @return 该通道为空时返回 false
+   */
+  bool pop(Item& item, Priority priority);
+
+  /**
+   * @brief 等待任一通道非空或被关闭（仅写线程调用）
+   * @return 队列非空时返回 true
+   */
+  bool wait();
+
+  /**
+   * @brief 等待紧急通道非空、被关闭或超时（仅写线程调用，用于分片之间的节拍等待）
+   * @param timeout_ns 最长等待时间（纳秒），<= 0 时只检查不等待
+   * @return 紧急通道非空时返回 true
+   */
+  bool waitUrgent(int64_t timeout_ns);
+
+  /**
+   * @brief 记录一个紧急条目从提交到写出的时延（仅写线程调用）
+   */
+  void noteUrgentLatency(int64_t latency_ns);
+
+  /**
+   * @brief 记录条目完成（仅写线程调用）
+   * @param count 完成的条目数
+   * @param bytes 这些条目的总字节数
+   * @param failed 其中失败的条目数
+   */
+  void finish(size_t count, size_t bytes, size_t failed);
+
+  /**
+   * @brief 记录一次底层写调用
+   * @param bytes 写出的字节数
+   */
+  void noteWrite(size_t bytes);
+
+  /**
+   * @brief 开始接受唤醒（写线程启动前调用）
+   */
+  void open();
+
+  /**
+   * @brief 唤醒写线程并让 wait() 在队列为空时返回 false
+   */
+  void close();
+
+  /**
+   * @brief 获取统计信息
+   */
+  Stats stats() const;
+
+ private:
+  /**
+   * @brief 队列节点（首个节点为哑元）
+   */
+  struct Node
+  {
+    std::atomic<Node*> next{nullptr};  ///< 下一个节点
+    Item item;                         ///< 条目
+  };
+
+  /**
+   * @brief 一条通道（Vyukov 链表）
+   */
+  struct Lane
+  {
+    alignas(kCacheLine) std::atomic<Node*> head;  ///< 最新的节点（生产者交换）
+    alignas(kCacheLine) Node* tail;               ///< 哑元节点，其后为队首（仅消费者访问）
+  };
+
+  /**
+   * @brief 空闲节点池的一个槽位（Vyukov 有界队列）
+   */
+  struct Slot
+  {
+    std::atomic<size_t> seq{0};  ///< 槽位序号，决定该槽位当前可放回还是可取出
+    Node* node{nullptr};         ///< 空闲节点
+  };
+
+  static constexpr size_t kPoolSlots = 256;  ///< 空闲节点池容量
+
+  /**
+   * @brief 通道是否有条目
+   */
+  bool ready(const Lane& lane) const;
+
+  /**
+   * @brief 取一个节点：优先从空闲池取出，池为空时从堆上分配（任意线程，无锁）
+   */
+  Node* allocNode();
+
+  /**
+   * @brief 释放一个节点：放回空闲池，池已满时归还堆（仅写线程调用）
+   */
+  void recycleNode(Node* node);
+
+ private:
+  Lane lanes_[2];  ///< 按 Priority 下标的通道
+
+  Slot pool_[kPoolSlots];                                 ///< 空闲节点池
+  alignas(kCacheLine) std::atomic<size_t> pool_head_{0};  ///< 下一个取出位置（生产者竞争）
+  alignas(kCacheLine) size_t pool_tail_{0};               ///< 下一个放回位置（仅写线程访问）
+  std::atomic<uint64_t> node_allocations_{0};             ///< 堆上分配的节点数
+
+  std::atomic_bool waiting_{false};  ///< 写线程是否正在等待
+  bool closed_{true};                ///< 是否已关闭（受 mtx_ 保护）
+  std::mutex mtx_;                   ///< 休眠/唤醒互斥锁
+  std::condition_variable cv_;       ///< 休眠/唤醒条件变量
+
+  std::atomic<size_t> depth_{0};             ///< 未完成条目数
+  std::atomic<size_t> bytes_pending_{0};     ///< 未完成字节数
+  std::atomic<size_t> high_water_depth_{0};  ///< 历史最高条目数
+  std::atomic<size_t> high_water_bytes_{0};  ///< 历史最高字节数
+  std::atomic<uint64_t> submitted_{0};       ///< 累计提交条目数
+  std::atomic<uint64_t> completed_{0};       ///< 累计成功条目数
+  std::atomic<uint64_t> failed_{0};          ///< 累计失败条目数
+  std::atomic<uint64_t> write_calls_{0};     ///< 累计写调用次数
+  std::atomic<uint64_t> bytes_written_{0};   ///< 累计写出字节数
+
+  std::atomic<uint64_t> urgent_submitted_{0};  ///< 累计提交的紧急条目数
+  LatencyHistogram urgent_latency_;            ///< 紧急条目时延
+};
+
+#endif  // SERIAL_PORT_TX_QUEUE_H
@@ -0,0 +1,102 @@
+/// 说明：回调合并器实现
+
+#include "serialport/coalescer.h"
+
+/// @brief 设置合并条件
+void CallbackCoalescer::configure(size_t min_bytes, uint32_t max_delay_us)
+{
+  min_bytes_ = min_bytes;
+  window_ns_ = static_cast<int64_t>(max_delay_us) * 1000;
+  pending_.clear();
+  if (min_bytes_ > 0) pending_.reserve(min_bytes_ * 2);
+}
+
+/// @brief 输入数据，满足条件时交付
+void CallbackCoalescer::feed(const uint8_t* data, size_t size, const RxTimestamp& stamp, int64_t now_ns,
+                             const DeliverCallback& cb)
+{
+  if (size == 0) return;
+  input_chunks_.fetch_add(1, std::memory_order_relaxed);
+  input_bytes_.fetch_add(size, std::memory_order_relaxed);
+
+  if (pending_.empty())
+  {
+    if (size >= min_bytes_ || window_ns_ == 0)
+    {
+      // 单块已满足条件，直接交付，不复制也没有附加延迟
+      flush_by_size_.fetch_add(1, std::memory_order_relaxed);
+      noteDelay(0);
+      cb(data, size, stamp);
+      return;
+    }
+    first_ns_ = now_ns;
+    first_stamp_ = stamp;
+  }
+
+  pending_.insert(pending_.end(), data, data + size);
+  if (pending_.size() >= min_bytes_)
+  {
+    flush_by_size_.fetch_add(1, std::memory_order_relaxed);
+    deliverPending(now_ns, cb);
+  }
+  else if (now_ns - first_ns_ >= window_ns_)
+  {
+    flush_by_time_.fetch_add(1, std::memory_order_relaxed);
+    deliverPending(now_ns, cb);
+  }
+}
+
+/// @brief 时间窗口已到时交付
+bool CallbackCoalescer::poll(int64_t now_ns, const DeliverCallback& cb)
+{
+  if (pending_.empty() || now_ns - first_ns_ < window_ns_) return false;
+  flush_by_time_.fetch_add(1, std::memory_order_relaxed);
+  deliverPending(now_ns, cb);
+  return true;
+}
+
+/// @brief 无条件交付剩余数据
+void CallbackCoalescer::flush(int64_t now_ns, const DeliverCallback& cb)
+{
+  if (pending_.empty()) return;
+  flush_by_close_.fetch_add(1, std::memory_order_relaxed);
+  deliverPending(now_ns, cb);
+}
+
+/// @brief 获取合并统计信息
+CallbackCoalescer::Stats CallbackCoalescer::stats() const
+{
+  Stats stats;
+  stats.input_chunks = input_chunks_.load(std::memory_order_relaxed);
+  stats.input_bytes = input_bytes_.load(std::memory_order_relaxed);
+  stats.callbacks = callbacks_.load(std::memory_order_relaxed);
+  stats.flush_by_size = flush_by_size_.load(std::memory_order_relaxed);
+  stats.flush_by_time = flush_by_time_.load(std::memory_order_relaxed);
+  stats.flush_by_close = flush_by_close_.load(std::memory_order_relaxed);
+  stats.total_delay_ns = total_delay_ns_.load(std::memory_order_relaxed);
+  stats.max_delay_ns = max_delay_ns_.load(std::memory_order_relaxed);
+  return stats;
+}
+
+/// @brief 当前 steady_clock 时间
+int64_t CallbackCoalescer::nowNs()
+{
+  return RxTimestamp::monoNow();
+}
+
+/// @brief 交付暂存数据并清空
+void CallbackCoalescer::deliverPending(int64_t now_ns, const DeliverCallback& cb)
+{
+  noteDelay(now_ns - first_ns_);
+  cb(pending_.data(), pending_.size(), first_stamp_);
+  pending_.clear();
+}
+
+/// @brief 记录附加延迟
+void CallbackCoalescer::noteDelay(int64_t delay_ns)
+{
+  const uint64_t delay = delay_ns > 0 ? static_cast<uint64_t>(delay_ns) : 0;
+  callbacks_.fetch_add(1, std::memory_order_relaxed);
+  total_delay_ns_.fetch_add(delay, std::memory_order_relaxed);
+  if (delay > max_delay_ns_.load(std::memory_order_relaxed)) max_delay_ns_.store(delay, std::memory_order_relaxed);
+}
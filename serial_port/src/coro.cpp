@@ -0,0 +1,185 @@
+/// 说明：C++20 协程接口实现
+
+#include "serialport/coro.h"
+
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <system_error>
+
+// ============================== CoExecutor ==============================
+
+/// @brief 挂起协程并登记为等待者
+void CoExecutor::IoAwaiter::await_suspend(std::coroutine_handle<> h)
+{
+  handle_ = h;
+  executor_.waiters_.push_back(this);
+}
+
+/// @brief 托管一个任务
+void CoExecutor::spawn(CoTask<void> task)
+{
+  post(runDetached(std::move(task)).handle);
+}
+
+/// @brief 运行事件循环直到没有任何工作
+void CoExecutor::run()
+{
+  while (runOnce())
+  {
+  }
+}
+
+/// @brief 执行一轮事件循环
+bool CoExecutor::runOnce()
+{
+  if (!ready_.empty())
+  {
+    // 只恢复本轮开始时已就绪的协程，期间新就绪的留到下一轮，避免饿死 fd 等待者
+    for (size_t n = ready_.size(); n > 0; --n)
+    {
+      std::coroutine_handle<> h = ready_.front();
+      ready_.pop_front();
+      h.resume();
+    }
+    return true;
+  }
+  if (waiters_.empty()) return false;
+
+  std::vector<struct pollfd> fds(waiters_.size());
+  Deadline earliest = Deadline::max();
+  for (size_t i = 0; i < waiters_.size(); ++i)
+  {
+    fds[i].fd = waiters_[i]->fd_;  // 负数 fd 被 poll 忽略，只参与截止时间计算
+    fds[i].events = waiters_[i]->events_;
+    fds[i].revents = 0;
+    earliest = std::min(earliest, waiters_[i]->deadline_);
+  }
+
+  int timeout_ms = -1;
+  if (earliest != Deadline::max())
+  {
+    const auto remaining = std::chrono::ceil<std::chrono::milliseconds>(earliest - Clock::now()).count();
+    timeout_ms = static_cast<int>(std::clamp<decltype(remaining)>(remaining, 0, INT_MAX));
+  }
+  if (::poll(fds.data(), fds.size(), timeout_ms) < 0 && errno != EINTR)
+  {
+    throw std::system_error(errno, std::generic_category(), "CoExecutor: poll failed");
+  }
+
+  // 就绪或到期的等待者移出列表后再恢复：恢复的协程可能立刻登记新的等待
+  const Deadline now = Clock::now();
+  std::vector<IoAwaiter*> pending;
+  pending.reserve(waiters_.size());
+  for (size_t i = 0; i < waiters_.size(); ++i)
+  {
+    IoAwaiter* w = waiters_[i];
+    if (fds[i].revents != 0)
+    {
+      w->ready_ = true;
+      post(w->handle_);
+    }
+    else if (w->deadline_ <= now)
+    {
+      post(w->handle_);
+    }
+    else
+    {
+      pending.push_back(w);
+    }
+  }
+  waiters_.swap(pending);
+  return true;
+}
+
+/// @brief 执行托管任务
+coro_detail::Detached CoExecutor::runDetached(CoTask<void> task)
+{
+  co_await task;
+}
+
+// ============================ AsyncSerialPort ============================
+
+AsyncSerialPort::AsyncSerialPort(CoExecutor& executor, SerialPort& port) : executor_(executor), port_(port)
+{
+  port_.setReadMode(SerialPort::ReadMode::External).setDataViewCallback([this](const SerialPort::DataView& view) {
+    rx_.append(reinterpret_cast<const char*>(view.data), view.size);
+  });
+}
+
+/// @brief 读取当前可用的数据
+CoTask<std::string> AsyncSerialPort::readSome(Deadline deadline)
+{
+  if (rx_.empty() && !co_await fill(deadline)) co_return std::string();
+  std::string out;
+  out.swap(rx_);
+  co_return out;
+}
+
+/// @brief 读取直到遇到分隔符
+CoTask<std::string> AsyncSerialPort::readUntil(std::string delim, Deadline deadline)
+{
+  if (delim.empty()) throw std::invalid_argument("AsyncSerialPort: delimiter must not be empty");
+
+  size_t scanned = 0;  // 已确认不含分隔符起点的前缀长度，避免每次从头查找
+  while (true)
+  {
+    const size_t pos = rx_.find(delim, scanned);
+    if (pos != std::string::npos)
+    {
+      std::string out = rx_.substr(0, pos + delim.size());
+      rx_.erase(0, pos + delim.size());
+      co_return out;
+    }
+    scanned = rx_.size() >= delim.size() ? rx_.size() - delim.size() + 1 : 0;
+    if (!co_await fill(deadline)) co_return std::string();
+  }
+}
+
+/// @brief 写入全部数据
+CoTask<size_t> AsyncSerialPort::write(std::string data, Deadline deadline)
+{
+  size_t written = 0;
+  while (written < data.size())
+  {
+    const int fd = port_.nativeHandle();
+    if (fd < 0) break;
+    const ssize_t n = ::write(fd, data.data() + written, data.size() - written);
+    if (n > 0)
+    {
+      written += static_cast<size_t>(n);
+      continue;
+    }
+    if (n < 0 && errno == EINTR) continue;
+    if (n < 0 && errno != EAGAIN && errno != EWOULDBLOCK) break;
+    if (!co_await executor_.writable(fd, deadline)) break;  // 超时
+  }
+  co_return written;
+}
+
+/// @brief 等待串口可读并取走数据
+CoTask<bool> AsyncSerialPort::fill(Deadline deadline)
+{
+  while (port_.isOpen())
+  {
+    // 合并缓冲中有待交付数据时按其截止时间提前醒来
+    Deadline wake = deadline;
+    const int64_t wait_us = port_.nextTimeoutUs();
+    if (wait_us >= 0) wake = std::min(wake, CoExecutor::after(std::chrono::microseconds(wait_us)));
+
+    const size_t before = rx_.size();
+    if (co_await executor_.readable(port_.nativeHandle(), wake))
+    {
+      port_.onReadable();
+    }
+    else
+    {
+      port_.pump();
+    }
+    if (rx_.size() > before) co_return true;
+    if (CoExecutor::Clock::now() >= deadline) co_return false;
+  }
+  co_return false;
+}
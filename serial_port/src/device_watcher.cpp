@@ -0,0 +1,224 @@
+/// 说明：串口设备热插拔监视器实现
+
+#include "serialport/device_watcher.h"
+
+#include <cstring>
+
+#if defined(__linux__)
+#include <linux/netlink.h>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/inotify.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <cerrno>
+#endif
+
+DeviceWatcher::DeviceWatcher() : config_(Config())
+{
+}
+
+DeviceWatcher::DeviceWatcher(const Config& config) : config_(config)
+{
+}
+
+DeviceWatcher::~DeviceWatcher()
+{
+  stop();
+}
+
+/// @brief 订阅设备节点事件
+uint64_t DeviceWatcher::subscribe(Callback cb)
+{
+#if defined(__linux__)
+  if (!cb) return 0;
+  std::lock_guard<std::mutex> lock(mtx_);
+  if (!startLocked()) return 0;
+  const uint64_t id = next_id_++;
+  subscribers_[id] = std::move(cb);
+  return id;
+#else
+  (void)cb;
+  return 0;
+#endif
+}
+
+/// @brief 取消订阅
+void DeviceWatcher::unsubscribe(uint64_t id)
+{
+  // 通知期间持有同一把锁，取得锁即说明该回调没有在运行
+  std::lock_guard<std::mutex> lock(mtx_);
+  subscribers_.erase(id);
+}
+
+/// @brief 打开 netlink 与 inotify 并启动线程
+bool DeviceWatcher::startLocked()
+{
+#if defined(__linux__)
+  if (running_) return true;
+
+  if (config_.netlink)
+  {
+    netlink_fd_ = ::socket(AF_NETLINK, SOCK_DGRAM | SOCK_CLOEXEC | SOCK_NONBLOCK, NETLINK_KOBJECT_UEVENT);
+    struct sockaddr_nl addr;
+    std::memset(&addr, 0, sizeof(addr));
+    addr.nl_family = AF_NETLINK;
+    addr.nl_groups = 1;  // 内核 uevent 组
+    if (netlink_fd_ >= 0 && ::bind(netlink_fd_, reinterpret_cast<struct sockaddr*>(&addr), sizeof(addr)) != 0)
+    {
+      ::close(netlink_fd_);
+      netlink_fd_ = -1;
+    }
+  }
+
+  inotify_fd_ = ::inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+  if (inotify_fd_ >= 0)
+  {
+    for (const std::string& dir : config_.watch_dirs)
+    {
+      // 链接的创建与删除、节点的创建与删除都会触发
+      int wd = ::inotify_add_watch(inotify_fd_, dir.c_str(), IN_CREATE | IN_DELETE | IN_MOVED_TO | IN_MOVED_FROM);
+      if (wd >= 0) watch_dirs_[wd] = dir;
+    }
+    if (watch_dirs_.empty())
+    {
+      ::close(inotify_fd_);
+      inotify_fd_ = -1;
+    }
+  }
+
+  wakeup_fd_ = ::eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+  if ((netlink_fd_ < 0 && inotify_fd_ < 0) || wakeup_fd_ < 0)
+  {
+    for (int* fd : {&netlink_fd_, &inotify_fd_, &wakeup_fd_})
+    {
+      if (*fd >= 0) ::close(*fd);
+      *fd = -1;
+    }
+    watch_dirs_.clear();
+    return false;
+  }
+
+  running_ = true;
+  thread_ = std::thread(&DeviceWatcher::threadLoop, this);
+  return true;
+#else
+  return false;
+#endif
+}
+
+/// @brief 停止监视线程
+void DeviceWatcher::stop()
+{
+#if defined(__linux__)
+  {
+    std::lock_guard<std::mutex> lock(mtx_);
+    if (!running_) return;
+    running_ = false;
+    uint64_t one = 1;
+    ssize_t r = ::write(wakeup_fd_, &one, sizeof(one));
+    (void)r;
+  }
+  if (thread_.joinable()) thread_.join();
+
+  for (int* fd : {&netlink_fd_, &inotify_fd_, &wakeup_fd_})
+  {
+    if (*fd >= 0) ::close(*fd);
+    *fd = -1;
+  }
+  watch_dirs_.clear();
+#endif
+}
+
+/// @brief 监视线程主循环
+void DeviceWatcher::threadLoop()
+{
+#if defined(__linux__)
+  // uevent 单条消息不超过 8KB；inotify 缓冲需按 inotify_event 对齐
+  alignas(struct inotify_event) char buf[16 * 1024];
+  struct pollfd fds[3];
+  fds[0].fd = wakeup_fd_;
+  fds[1].fd = netlink_fd_;  // 负数的 fd 被 poll 忽略
+  fds[2].fd = inotify_fd_;
+  for (struct pollfd& fd : fds) fd.events = POLLIN;
+
+  while (running_)
+  {
+    for (struct pollfd& fd : fds) fd.revents = 0;
+    int r = ::poll(fds, 3, -1);
+    if (r < 0)
+    {
+      if (errno == EINTR) continue;
+      break;
+    }
+    if (fds[0].revents & POLLIN) break;
+    if (fds[1].revents & POLLIN)
+    {
+      ssize_t n;
+      while ((n = ::recv(netlink_fd_, buf, sizeof(buf), 0)) > 0) handleUevent(buf, static_cast<size_t>(n));
+    }
+    if (fds[2].revents & POLLIN)
+    {
+      ssize_t n;
+      while ((n = ::read(inotify_fd_, buf, sizeof(buf))) > 0) handleInotify(buf, static_cast<size_t>(n));
+    }
+  }
+#endif
+}
+
+/// @brief 解析一条 uevent 消息
+void DeviceWatcher::handleUevent(const char* msg, size_t size)
+{
+#if defined(__linux__)
+  // 格式为 "action@devpath\0KEY=VALUE\0KEY=VALUE\0..."，只关心 tty 子系统中带设备节点的 add/remove
+  std::string action, subsystem, devname;
+  for (size_t pos = strnlen(msg, size) + 1; pos < size;)
+  {
+    const char* field = msg + pos;
+    const size_t len = strnlen(field, size - pos);
+    if (std::strncmp(field, "ACTION=", 7) == 0) action.assign(field + 7, len - 7);
+    else if (std::strncmp(field, "SUBSYSTEM=", 10) == 0) subsystem.assign(field + 10, len - 10);
+    else if (std::strncmp(field, "DEVNAME=", 8) == 0) devname.assign(field + 8, len - 8);
+    pos += len + 1;
+  }
+  if (subsystem != "tty" || devname.empty() || (action != "add" && action != "remove")) return;
+
+  Event event;
+  event.added = action == "add";
+  event.devnode = devname[0] == '/' ? devname : config_.dev_root + "/" + devname;
+  publish(event);
+#else
+  (void)msg;
+  (void)size;
+#endif
+}
+
+/// @brief 解析 inotify 事件
+void DeviceWatcher::handleInotify(const char* buf, size_t size)
+{
+#if defined(__linux__)
+  for (size_t pos = 0; pos + sizeof(struct inotify_event) <= size;)
+  {
+    const struct inotify_event* ev = reinterpret_cast<const struct inotify_event*>(buf + pos);
+    pos += sizeof(struct inotify_event) + ev->len;
+    auto dir = watch_dirs_.find(ev->wd);
+    if (ev->len == 0 || dir == watch_dirs_.end() || (ev->mask & IN_ISDIR)) continue;
+
+    Event event;
+    event.added = (ev->mask & (IN_CREATE | IN_MOVED_TO)) != 0;
+    event.devnode = dir->second + "/" + ev->name;
+    publish(event);
+  }
+#else
+  (void)buf;
+  (void)size;
+#endif
+}
+
+/// @brief 通知所有订阅者
+void DeviceWatcher::publish(const Event& event)
+{
+  std::lock_guard<std::mutex> lock(mtx_);
+  for (const auto& item : subscribers_) item.second(event);
+}
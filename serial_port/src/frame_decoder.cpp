@@ -0,0 +1,259 @@
+/// 说明：流式帧解码器实现
+
+#include "serialport/frame_decoder.h"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+// ============================ FrameDecoder ============================
+
+/// @brief 丢弃半帧
+void FrameDecoder::reset()
+{
+  pending_.clear();
+}
+
+/// @brief 获取解码统计信息
+FrameDecoder::Stats FrameDecoder::stats() const
+{
+  Stats stats;
+  stats.frames = frames_.load(std::memory_order_relaxed);
+  stats.dropped_bytes = dropped_bytes_.load(std::memory_order_relaxed);
+  return stats;
+}
+
+/// @brief 交付一帧
+void FrameDecoder::emit(const uint8_t* data, size_t size, const FrameCallback& cb)
+{
+  frames_.fetch_add(1, std::memory_order_relaxed);
+  if (cb) cb(data, size);
+}
+
+/// @brief 记录丢弃字节
+void FrameDecoder::drop(size_t size)
+{
+  dropped_bytes_.fetch_add(size, std::memory_order_relaxed);
+}
+
+// ======================== DelimiterFrameDecoder ========================
+
+DelimiterFrameDecoder::DelimiterFrameDecoder(const std::string& delimiter, bool include_delimiter, size_t max_frame) :
+  delimiter_(delimiter), scanner_(delimiter), include_delimiter_(include_delimiter), max_frame_(max_frame)
+{
+  if (max_frame_ < delimiter_.size()) max_frame_ = delimiter_.size();
+}
+
+/// @brief 输入数据并按分隔符切帧
+void DelimiterFrameDecoder::feed(const uint8_t* data, size_t size, const FrameCallback& cb)
+{
+  const size_t dlen = delimiter_.size();
+  const uint8_t* delim = reinterpret_cast<const uint8_t*>(delimiter_.data());
+
+  if (!pending_.empty() && size > 0)
+  {
+    // 分隔符可能横跨上一块末尾与本块开头，k 为落在上一块中的分隔符字节数
+    size_t end = 0;
+    for (size_t k = std::min(dlen - 1, pending_.size()); k >= 1 && end == 0; --k)
+    {
+      if (size >= dlen - k && std::memcmp(pending_.data() + pending_.size() - k, delim, k) == 0 &&
+          std::memcmp(data, delim + k, dlen - k) == 0)
+      {
+        end = dlen - k;
+      }
+    }
+    if (end == 0)
+    {
+      size_t pos = scanner_.find(data, size);
+      if (pos != serial::DelimiterScanner::npos) end = pos + dlen;
+    }
+
+    if (end == 0)
+    {
+      pending_.insert(pending_.end(), data, data + size);
+      if (pending_.size() > max_frame_)
+      {
+        drop(pending_.size());
+        pending_.clear();
+      }
+      return;
+    }
+
+    pending_.insert(pending_.end(), data, data + end);
+    if (pending_.size() > max_frame_)
+    {
+      drop(pending_.size());
+    }
+    else
+    {
+      emitFrame(pending_.data(), pending_.size(), cb);
+    }
+    pending_.clear();
+    data += end;
+    size -= end;
+  }
+
+  // 完整落在本块内的帧直接以视图交付，不做复制
+  while (size > 0)
+  {
+    size_t pos = scanner_.find(data, size);
+    if (pos == serial::DelimiterScanner::npos)
+    {
+      if (size > max_frame_)
+      {
+        drop(size);
+      }
+      else
+      {
+        pending_.assign(data, data + size);
+      }
+      return;
+    }
+
+    size_t end = pos + dlen;
+    if (end > max_frame_)
+    {
+      drop(end);
+    }
+    else
+    {
+      emitFrame(data, end, cb);
+    }
+    data += end;
+    size -= end;
+  }
+}
+
+/// @brief 按配置决定是否包含分隔符后交付
+void DelimiterFrameDecoder::emitFrame(const uint8_t* data, size_t end, const FrameCallback& cb)
+{
+  emit(data, include_delimiter_ ? end : end - delimiter_.size(), cb);
+}
+
+// ========================= HeaderFrameDecoder =========================
+
+/// @brief 输入数据并按帧头给出的长度切帧
+void HeaderFrameDecoder::feed(const uint8_t* data, size_t size, const FrameCallback& cb)
+{
+  // 先补全跨数据块的半帧：每次只追加刚好够用的字节，避免把整个数据块复制进缓冲区
+  while (!pending_.empty())
+  {
+    size_t need = 0;
+    const size_t len = frameLength(pending_.data(), pending_.size(), need);
+    if (len == kInvalid || len > max_frame_)
+    {
+      // 帧头非法：丢弃一个字节后重新同步
+      drop(1);
+      pending_.erase(pending_.begin());
+      continue;
+    }
+    if (len != 0 && pending_.size() >= len)
+    {
+      emit(pending_.data(), len, cb);
+      pending_.erase(pending_.begin(), pending_.begin() + static_cast<std::ptrdiff_t>(len));
+      continue;
+    }
+    if (size == 0) return;
+
+    const size_t target = (len != 0) ? len : need;
+    const size_t take = std::min(size, target - pending_.size());
+    pending_.insert(pending_.end(), data, data + take);
+    data += take;
+    size -= take;
+  }
+
+  // 完整落在本块内的帧直接以视图交付，不做复制
+  while (size > 0)
+  {
+    size_t need = 0;
+    const size_t len = frameLength(data, size, need);
+    if (len == kInvalid || len > max_frame_)
+    {
+      drop(1);
+      ++data;
+      --size;
+      continue;
+    }
+    if (len != 0 && len <= size)
+    {
+      emit(data, len, cb);
+      data += len;
+      size -= len;
+      continue;
+    }
+    pending_.assign(data, data + size);  // 半帧暂存，等待后续数据
+    return;
+  }
+}
+
+// ======================= FixedLengthFrameDecoder =======================
+
+FixedLengthFrameDecoder::FixedLengthFrameDecoder(size_t frame_size) :
+  HeaderFrameDecoder(frame_size), frame_size_(frame_size)
+{
+  if (frame_size_ == 0) throw std::invalid_argument("FixedLengthFrameDecoder: frame size must be > 0");
+}
+
+/// @brief 定长帧的长度恒定
+size_t FixedLengthFrameDecoder::frameLength(const uint8_t* /*data*/, size_t /*size*/, size_t& need) const
+{
+  need = frame_size_;
+  return frame_size_;
+}
+
+// ===================== LengthPrefixedFrameDecoder =====================
+
+LengthPrefixedFrameDecoder::LengthPrefixedFrameDecoder(LengthField field, size_t length_offset, int64_t length_adjust,
+                                                       size_t max_frame) :
+  HeaderFrameDecoder(max_frame), field_(field), length_offset_(length_offset), length_adjust_(length_adjust)
+{
+}
+
+/// @brief 解析长度字段并计算整帧长度
+size_t LengthPrefixedFrameDecoder::frameLength(const uint8_t* data, size_t size, size_t& need) const
+{
+  const uint8_t* p = data + length_offset_;
+  uint64_t value = 0;
+  size_t header = length_offset_;
+
+  if (field_ == LengthField::Varint)
+  {
+    for (size_t i = 0;; ++i)
+    {
+      if (i == 5) return kInvalid;  // 超过 32 位的 varint 视为非法
+      if (length_offset_ + i >= size)
+      {
+        need = length_offset_ + i + 1;
+        return 0;
+      }
+      value |= static_cast<uint64_t>(p[i] & 0x7F) << (7 * i);
+      if ((p[i] & 0x80) == 0)
+      {
+        header += i + 1;
+        break;
+      }
+    }
+  }
+  else
+  {
+    size_t width = 1;
+    if (field_ == LengthField::Uint16LE || field_ == LengthField::Uint16BE) width = 2;
+    if (field_ == LengthField::Uint32LE || field_ == LengthField::Uint32BE) width = 4;
+    if (size < length_offset_ + width)
+    {
+      need = length_offset_ + width;
+      return 0;
+    }
+    bool big_endian = (field_ == LengthField::Uint16BE || field_ == LengthField::Uint32BE);
+    for (size_t i = 0; i < width; ++i)
+    {
+      size_t idx = big_endian ? i : width - 1 - i;
+      value = (value << 8) | p[idx];
+    }
+    header += width;
+  }
+
+  int64_t rest = static_cast<int64_t>(value) + length_adjust_;
+  if (rest < 0) return kInvalid;
+  return header + static_cast<size_t>(rest);
+}
@@ -0,0 +1,121 @@
+/// 说明：对数-线性延迟直方图实现
+
+#include "serialport/latency_histogram.h"
+
+namespace
+{
+/// @brief 最高有效位的位置
+unsigned highestBit(uint64_t v)
+{
+#if defined(__GNUC__)
+  return 63u - static_cast<unsigned>(__builtin_clzll(v));
+#else
+  unsigned n = 0;
+  while (v >>= 1) ++n;
+  return n;
+#endif
+}
+}  // namespace
+
+constexpr size_t LatencyHistogram::kSubBuckets;
+constexpr size_t LatencyHistogram::kMaxExponent;
+constexpr size_t LatencyHistogram::kBuckets;
+
+LatencyHistogram::LatencyHistogram()
+{
+  for (auto& bucket : buckets_) bucket.store(0, std::memory_order_relaxed);
+}
+
+/// @brief 记录一个样本
+void LatencyHistogram::record(int64_t value_ns)
+{
+  const uint64_t value = value_ns > 0 ? static_cast<uint64_t>(value_ns) : 0;
+  buckets_[bucketIndex(value)].fetch_add(1, std::memory_order_relaxed);
+  count_.fetch_add(1, std::memory_order_relaxed);
+  sum_.fetch_add(value, std::memory_order_relaxed);
+  // 最值通常很快稳定，先读后写避免每次都产生 CAS
+  uint64_t cur = min_.load(std::memory_order_relaxed);
+  while (value < cur && !min_.compare_exchange_weak(cur, value, std::memory_order_relaxed))
+  {
+  }
+  cur = max_.load(std::memory_order_relaxed);
+  while (value > cur && !max_.compare_exchange_weak(cur, value, std::memory_order_relaxed))
+  {
+  }
+}
+
+/// @brief 清空所有样本
+void LatencyHistogram::reset()
+{
+  for (auto& bucket : buckets_) bucket.store(0, std::memory_order_relaxed);
+  count_.store(0, std::memory_order_relaxed);
+  sum_.store(0, std::memory_order_relaxed);
+  min_.store(UINT64_MAX, std::memory_order_relaxed);
+  max_.store(0, std::memory_order_relaxed);
+}
+
+/// @brief 获取快照
+LatencyHistogram::Snapshot LatencyHistogram::snapshot() const
+{
+  Snapshot snap;
+  snap.buckets.resize(kBuckets);
+  for (size_t i = 0; i < kBuckets; ++i)
+  {
+    snap.buckets[i] = buckets_[i].load(std::memory_order_relaxed);
+    snap.count += snap.buckets[i];  // 以桶计数为准，保证分位数计算自洽
+  }
+  snap.sum_ns = sum_.load(std::memory_order_relaxed);
+  snap.max_ns = max_.load(std::memory_order_relaxed);
+  const uint64_t min = min_.load(std::memory_order_relaxed);
+  snap.min_ns = (min == UINT64_MAX) ? 0 : min;
+  return snap;
+}
+
+/// @brief 估算分位数
+uint64_t LatencyHistogram::Snapshot::percentile(double p) const
+{
+  if (count == 0) return 0;
+  if (p < 0) p = 0;
+  if (p > 100) p = 100;
+  uint64_t rank = static_cast<uint64_t>(p / 100.0 * static_cast<double>(count) + 0.5);
+  if (rank == 0) rank = 1;
+
+  uint64_t seen = 0;
+  for (size_t i = 0; i < buckets.size(); ++i)
+  {
+    seen += buckets[i];
+    if (seen >= rank)
+    {
+      const uint64_t upper = bucketUpperBound(i) - 1;
+      return upper < max_ns ? upper : max_ns;
+    }
+  }
+  return max_ns;
+}
+
+/// @brief 桶下界
+uint64_t LatencyHistogram::bucketLowerBound(size_t index)
+{
+  if (index < kSubBuckets) return index;
+  const size_t exponent = index / kSubBuckets + 3;
+  const uint64_t sub = index % kSubBuckets;
+  return (kSubBuckets + sub) << (exponent - 4);
+}
+
+/// @brief 桶上界
+uint64_t LatencyHistogram::bucketUpperBound(size_t index)
+{
+  if (index < kSubBuckets) return index + 1;
+  const size_t exponent = index / kSubBuckets + 3;
+  return bucketLowerBound(index) + (uint64_t(1) << (exponent - 4));
+}
+
+/// @brief 计算桶下标
+size_t LatencyHistogram::bucketIndex(uint64_t value)
+{
+  if (value < kSubBuckets) return static_cast<size_t>(value);
+  const unsigned exponent = highestBit(value);
+  if (exponent > kMaxExponent) return kBuckets - 1;
+  const size_t sub = static_cast<size_t>(value >> (exponent - 4)) & (kSubBuckets - 1);
+  return (exponent - 3) * kSubBuckets + sub;
+}
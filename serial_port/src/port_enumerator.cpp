@@ -0,0 +1,514 @@
+/// 说明：基于 sysfs 的串口枚举器实现
+
+#include "serialport/port_enumerator.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <climits>
+#include <cstdlib>
+#include <thread>
+
+#include "serialport/rx_timestamp.h"
+
+#if defined(__linux__)
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+#if defined(__linux__)
+/// @brief 读取相对于 dir_fd 的 sysfs 属性（单行），失败返回空字符串
+std::string readAttrAt(int dir_fd, const char* path)
+{
+  char buf[256];
+  int fd = ::openat(dir_fd, path, O_RDONLY | O_CLOEXEC);
+  if (fd < 0) return std::string();
+  ssize_t n = ::read(fd, buf, sizeof(buf) - 1);
+  ::close(fd);
+  if (n <= 0) return std::string();
+  while (n > 0 && (buf[n - 1] == '\n' || buf[n - 1] == '\r')) --n;
+  return std::string(buf, static_cast<size_t>(n));
+}
+
+/// @brief 写入相对于 dir_fd 的 sysfs 属性，失败时保留 errno
+bool writeAttrAt(int dir_fd, const char* path, const std::string& value)
+{
+  int fd = ::openat(dir_fd, path, O_WRONLY | O_CLOEXEC);
+  if (fd < 0) return false;
+  const bool ok = ::write(fd, value.data(), value.size()) == static_cast<ssize_t>(value.size());
+  const int err = errno;
+  ::close(fd);
+  errno = err;
+  return ok;
+}
+
+/// @brief 读取相对于 dir_fd 的链接目标的最后一段，失败返回空字符串
+std::string linkBaseAt(int dir_fd, const char* path)
+{
+  char buf[PATH_MAX];
+  ssize_t n = ::readlinkat(dir_fd, path, buf, sizeof(buf));
+  if (n <= 0) return std::string();
+  const std::string target(buf, static_cast<size_t>(n));
+  return target.substr(target.rfind('/') + 1);
+}
+
+/// @brief 已打开目录的绝对路径（由内核给出，不逐级解析）
+std::string fdPath(int fd)
+{
+  char buf[PATH_MAX];
+  ssize_t n = ::readlink(("/proc/self/fd/" + std::to_string(fd)).c_str(), buf, sizeof(buf));
+  return n > 0 ? std::string(buf, static_cast<size_t>(n)) : std::string();
+}
+
+/// @brief 名称是否可能是串口（排除 tty、ttyN 虚拟终端、console、ptmx 等）
+bool serialName(const std::string& name)
+{
+  if (name.compare(0, 6, "rfcomm") == 0) return true;
+  return name.size() > 3 && name.compare(0, 3, "tty") == 0 && !std::isdigit(static_cast<unsigned char>(name[3]));
+}
+
+/// @brief 是否为不存在的 8250 端口（type 为 0 即 PORT_UNKNOWN）
+bool phantomUart(int class_fd, const std::string& name)
+{
+  return name.compare(0, 4, "ttyS") == 0 && readAttrAt(class_fd, (name + "/type").c_str()) == "0";
+}
+#endif
+}  // namespace
+
+PortEnumerator::PortEnumerator() : config_(Config())
+{
+}
+
+PortEnumerator::PortEnumerator(const Config& config) : config_(config)
+{
+}
+
+PortEnumerator::~PortEnumerator()
+{
+  if (watch_id_ != 0) watcher_->unsubscribe(watch_id_);
+}
+
+/// @brief 列出当前可用串口
+std::vector<serial::PortInfo> PortEnumerator::list()
+{
+#if defined(__linux__)
+  std::lock_guard<std::mutex> lock(mtx_);
+  if (cached_)
+  {
+    ++stats_.cache_hits;
+  }
+  else
+  {
+    scanLocked();
+  }
+  std::vector<serial::PortInfo> result;
+  result.reserve(ports_.size());
+  for (const auto& item : ports_) result.push_back(item.second.toPortInfo());
+  return result;
+#else
+  return serial::list_ports();
+#endif
+}
+
+/// @brief 列出当前可用串口的元数据
+std::vector<PortMetadata> PortEnumerator::listMetadata()
+{
+  std::vector<PortMetadata> result;
+  std::lock_guard<std::mutex> lock(mtx_);
+  if (cached_)
+  {
+    ++stats_.cache_hits;
+  }
+  else
+  {
+    scanLocked();
+  }
+  result.reserve(ports_.size());
+  for (const auto& item : ports_) result.push_back(item.second);
+  return result;
+}
+
+/// @brief 按身份查找串口
+bool PortEnumerator::find(const DeviceIdentity& identity, PortMetadata& meta)
+{
+  if (!identity.valid()) return false;
+  auto candidates = [&](std::vector<std::string>& names) {
+    if (!identity.serial.empty())
+    {
+      auto range = by_serial_.equal_range(identity.serial);
+      for (auto it = range.first; it != range.second; ++it) names.push_back(it->second);
+    }
+    else
+    {
+      auto range = by_vidpid_.equal_range(static_cast<uint32_t>(identity.vid) << 16 | identity.pid);
+      for (auto it = range.first; it != range.second; ++it) names.push_back(it->second);
+    }
+  };
+  std::lock_guard<std::mutex> lock(mtx_);
+  return lookupLocked(candidates, [&](const PortMetadata& m) { return identity.matches(m.identity()); }, meta);
+}
+
+/// @brief 按物理路径查找串口
+bool PortEnumerator::findByPath(const std::string& physical_path, PortMetadata& meta)
+{
+  if (physical_path.empty()) return false;
+  auto candidates = [&](std::vector<std::string>& names) {
+    auto it = by_path_.find(physical_path);
+    if (it != by_path_.end()) names.push_back(it->second);
+  };
+  auto match = [&](const PortMetadata& m) {
+    const std::string& path = m.physical_path;
+    return path == physical_path || path.substr(path.rfind('/') + 1) == physical_path;
+  };
+  std::lock_guard<std::mutex> lock(mtx_);
+  return lookupLocked(candidates, match, meta);
+}
+
+/// @brief 读取单个设备节点的元数据
+bool PortEnumerator::metadata(const std::string& port, PortMetadata& meta) const
+{
+#if defined(__linux__)
+  const std::string name = ttyName(port);
+  return !name.empty() && probeName(name, meta);
+#else
+  (void)port;
+  (void)meta;
+  return false;
+#endif
+}
+
+/// @brief 设置 usb-serial 转换芯片的 latency_timer
+bool PortEnumerator::setLatencyTimer(const std::string& port, uint32_t ms) const
+{
+#if defined(__linux__)
+  const std::string name = ttyName(port);
+  if (name.empty())
+  {
+    errno = ENOENT;
+    return false;
+  }
+  int class_fd = ::open((config_.sysfs_root + "/class/tty").c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+  if (class_fd < 0) return false;
+  const bool ok = writeAttrAt(class_fd, (name + "/device/latency_timer").c_str(), std::to_string(ms));
+  const int err = errno;
+  ::close(class_fd);
+  errno = err;
+  return ok;
+#else
+  (void)port;
+  (void)ms;
+  errno = ENOTSUP;
+  return false;
+#endif
+}
+
+/// @brief 订阅设备事件并启用缓存
+bool PortEnumerator::watch(std::shared_ptr<DeviceWatcher> watcher)
+{
+  if (!watcher) return false;
+  // 检查与订阅之间另一个 watch() 不能插入，否则两次都会订阅，多出的订阅在析构后仍回调本对象；
+  // 事件回调只获取 mtx_，不获取 watch_mtx_，持 watch_mtx_ 订阅不会死锁
+  std::lock_guard<std::mutex> watch_lock(watch_mtx_);
+  {
+    std::lock_guard<std::mutex> lock(mtx_);
+    if (watch_id_ != 0) return true;
+  }
+  // 不能持 mtx_ 订阅：事件回调在持有监视器锁时获取本锁
+  const uint64_t id = watcher->subscribe([this](const DeviceWatcher::Event& event) { onEvent(event); });
+  if (id == 0) return false;
+  std::lock_guard<std::mutex> lock(mtx_);
+  watch_id_ = id;
+  watcher_ = std::move(watcher);
+  cached_ = false;  // 订阅之后的第一次 list() 才完整枚举，订阅前发生的变化不会遗漏
+  return true;
+}
+
+/// @brief 丢弃缓存
+void PortEnumerator::invalidate()
+{
+  std::lock_guard<std::mutex> lock(mtx_);
+  cached_ = false;
+}
+
+/// @brief 获取统计信息
+PortEnumerator::Stats PortEnumerator::stats() const
+{
+  std::lock_guard<std::mutex> lock(mtx_);
+  return stats_;
+}
+
+/// @brief 完整枚举
+void PortEnumerator::scanLocked()
+{
+#if defined(__linux__)
+  const int64_t start = RxTimestamp::monoNow();
+  ports_.clear();
+  by_serial_.clear();
+  by_vidpid_.clear();
+  by_path_.clear();
+  int class_fd = ::open((config_.sysfs_root + "/class/tty").c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+  int dev_fd = ::open(config_.dev_root.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+  DIR* dir = class_fd >= 0 ? ::fdopendir(::dup(class_fd)) : nullptr;
+
+  // 先按名称与 type 属性筛选，大量虚拟终端与 ttyS 占位节点不做任何逐口工作
+  std::vector<std::string> names;
+  if (dir && dev_fd >= 0)
+  {
+    while (struct dirent* entry = ::readdir(dir))
+    {
+      const std::string name = entry->d_name;
+      if (serialName(name) && !phantomUart(class_fd, name)) names.push_back(name);
+    }
+  }
+  if (dir) ::closedir(dir);
+
+  std::vector<PortMetadata> infos(names.size());
+  std::vector<char> found(names.size(), 0);
+  auto work = [&](size_t first, size_t step) {
+    for (size_t i = first; i < names.size(); i += step) found[i] = probe(class_fd, dev_fd, names[i], infos[i]);
+  };
+  size_t threads = config_.threads ? config_.threads : std::min<size_t>(std::thread::hardware_concurrency(), 8);
+  if (names.size() < config_.parallel_min_ports || threads < 2) threads = 1;
+  std::vector<std::thread> workers;
+  for (size_t t = 1; t < threads; ++t) workers.emplace_back(work, t, threads);
+  work(0, threads);
+  for (auto& w : workers) w.join();
+
+  for (size_t i = 0; i < names.size(); ++i)
+  {
+    if (found[i]) storeLocked(names[i], std::move(infos[i]));
+  }
+  if (class_fd >= 0) ::close(class_fd);
+  if (dev_fd >= 0) ::close(dev_fd);
+
+  cached_ = watch_id_ != 0;
+  indexed_ = true;
+  ++stats_.full_scans;
+  stats_.candidates = names.size();
+  stats_.last_scan_ns = RxTimestamp::monoNow() - start;
+#endif
+}
+
+/// @brief 读取单个端口的元数据
+bool PortEnumerator::probe(int class_fd, int dev_fd, const std::string& name, PortMetadata& meta) const
+{
+#if defined(__linux__)
+  struct stat st;
+  if (::fstatat(dev_fd, name.c_str(), &st, 0) != 0) return false;  // 没有设备节点
+  meta = PortMetadata();
+  meta.port = config_.dev_root + "/" + name;
+  meta.description = name;
+  meta.hardware_id = "n/a";
+
+  // 由内核解析 class 链接与 device 链接，不在用户态逐级 realpath
+  int device_fd = ::openat(class_fd, (name + "/device").c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+  if (device_fd < 0) return name.compare(0, 6, "rfcomm") == 0;  // 没有 device 的是虚拟终端
+  meta.driver = linkBaseAt(device_fd, "driver");
+
+  const bool usb = name.compare(0, 6, "ttyUSB") == 0;
+  int path_fd = device_fd;
+  if (usb || name.compare(0, 6, "ttyACM") == 0)
+  {
+    // ttyUSB 的 device 是接口下的端口目录，ttyACM 的 device 是接口目录，其上为 USB 设备目录
+    int iface_fd = usb ? ::openat(device_fd, "..", O_RDONLY | O_DIRECTORY | O_CLOEXEC) : device_fd;
+    int usb_fd = iface_fd >= 0 ? ::openat(iface_fd, "..", O_RDONLY | O_DIRECTORY | O_CLOEXEC) : -1;
+    if (usb_fd >= 0)
+    {
+      meta.manufacturer = readAttrAt(usb_fd, "manufacturer");
+      meta.product = readAttrAt(usb_fd, "product");
+      meta.serial = readAttrAt(usb_fd, "serial");
+      const std::string vid = readAttrAt(usb_fd, "idVendor");
+      const std::string pid = readAttrAt(usb_fd, "idProduct");
+      meta.vid = static_cast<uint16_t>(std::strtoul(vid.c_str(), nullptr, 16));
+      meta.pid = static_cast<uint16_t>(std::strtoul(pid.c_str(), nullptr, 16));
+      const std::string number = readAttrAt(iface_fd, "bInterfaceNumber");
+      if (!number.empty()) meta.interface = static_cast<int>(std::strtol(number.c_str(), nullptr, 16));
+      if (!meta.manufacturer.empty() || !meta.product.empty() || !meta.serial.empty())
+      {
+        meta.description = meta.manufacturer + " " + meta.product + " " + meta.serial;
+      }
+      meta.hardware_id = "USB VID:PID=" + vid + ":" + pid + " ";
+      if (!meta.serial.empty()) meta.hardware_id += "SNR=" + meta.serial;
+      ::close(usb_fd);
+    }
+    // usb-serial 驱动（FTDI 等）在端口目录下提供 latency_timer，cdc_acm 没有
+    const std::string timer = usb ? readAttrAt(device_fd, "latency_timer") : std::string();
+    if (!timer.empty()) meta.latency_timer_ms = std::atoi(timer.c_str());
+    if (iface_fd >= 0) path_fd = iface_fd;
+  }
+  else
+  {
+    const std::string id = readAttrAt(device_fd, "id");  // PCI/PNP 设备的 ID
+    if (!id.empty()) meta.hardware_id = id;
+  }
+
+  const std::string devices = config_.sysfs_root + "/devices/";
+  meta.physical_path = fdPath(path_fd);
+  if (meta.physical_path.compare(0, devices.size(), devices) == 0) meta.physical_path.erase(0, devices.size());
+  if (path_fd != device_fd) ::close(path_fd);
+  ::close(device_fd);
+  return true;
+#else
+  (void)class_fd;
+  (void)dev_fd;
+  (void)name;
+  (void)meta;
+  return false;
+#endif
+}
+
+/// @brief 打开所需目录后读取单个端口的元数据
+bool PortEnumerator::probeName(const std::string& name, PortMetadata& meta) const
+{
+#if defined(__linux__)
+  int class_fd = ::open((config_.sysfs_root + "/class/tty").c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+  int dev_fd = ::open(config_.dev_root.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+  const bool found = class_fd >= 0 && dev_fd >= 0 && serialName(name) && !phantomUart(class_fd, name) &&
+                     probe(class_fd, dev_fd, name, meta);
+  if (class_fd >= 0) ::close(class_fd);
+  if (dev_fd >= 0) ::close(dev_fd);
+  return found;
+#else
+  (void)name;
+  (void)meta;
+  return false;
+#endif
+}
+
+/// @brief 设备节点对应的 tty 名称
+std::string PortEnumerator::ttyName(const std::string& port) const
+{
+#if defined(__linux__)
+  // 先按节点名查找，找不到时按链接目标（如 by-id 链接）查找
+  const std::string name = port.substr(port.rfind('/') + 1);
+  struct stat st;
+  if (::stat((config_.sysfs_root + "/class/tty/" + name).c_str(), &st) == 0) return name;
+  char buf[PATH_MAX];
+  if (!::realpath(port.c_str(), buf)) return std::string();
+  const std::string real(buf);
+  const std::string real_name = real.substr(real.rfind('/') + 1);
+  if (real_name == name || ::stat((config_.sysfs_root + "/class/tty/" + real_name).c_str(), &st) != 0)
+  {
+    return std::string();
+  }
+  return real_name;
+#else
+  (void)port;
+  return std::string();
+#endif
+}
+
+/// @brief 按索引查找
+bool PortEnumerator::lookupLocked(const std::function<void(std::vector<std::string>&)>& candidates,
+                                  const std::function<bool(const PortMetadata&)>& match, PortMetadata& meta)
+{
+  ++stats_.lookups;
+  if (!cached_ && !indexed_)
+  {
+    ++stats_.lookup_scans;
+    scanLocked();
+  }
+  for (int pass = 0; pass < 2; ++pass)
+  {
+    std::vector<std::string> names;
+    candidates(names);
+    std::sort(names.begin(), names.end());
+    for (const std::string& name : names)
+    {
+      if (cached_)
+      {
+        // 缓存由设备事件维护，索引即为最新
+        const PortMetadata& cached = ports_[name];
+        if (!match(cached)) continue;
+        meta = cached;
+        return true;
+      }
+      // 未启用监视：索引可能已过期，定点探测确认该端口仍然存在且满足条件
+      PortMetadata fresh;
+      if (probeName(name, fresh) && match(fresh))
+      {
+        meta = fresh;
+        storeLocked(name, std::move(fresh));
+        return true;
+      }
+    }
+    if (cached_ || pass == 1) break;
+    ++stats_.lookup_scans;
+    scanLocked();  // 索引未命中或已失效，重新枚举一次再查
+  }
+  return false;
+}
+
+/// @brief 加入或更新缓存条目并维护索引
+void PortEnumerator::storeLocked(const std::string& name, PortMetadata meta)
+{
+  eraseLocked(name);
+  if (!meta.serial.empty()) by_serial_.emplace(meta.serial, name);
+  if (meta.vid != 0) by_vidpid_.emplace(static_cast<uint32_t>(meta.vid) << 16 | meta.pid, name);
+  if (!meta.physical_path.empty())
+  {
+    by_path_[meta.physical_path] = name;
+    by_path_[meta.physical_path.substr(meta.physical_path.rfind('/') + 1)] = name;
+  }
+  ports_[name] = std::move(meta);
+}
+
+/// @brief 删除缓存条目及其索引
+void PortEnumerator::eraseLocked(const std::string& name)
+{
+  auto it = ports_.find(name);
+  if (it == ports_.end()) return;
+  const PortMetadata& meta = it->second;
+  auto unindex = [&name](std::unordered_multimap<std::string, std::string>& index, const std::string& key) {
+    auto range = index.equal_range(key);
+    for (auto i = range.first; i != range.second; ++i)
+    {
+      if (i->second == name)
+      {
+        index.erase(i);
+        return;
+      }
+    }
+  };
+  unindex(by_serial_, meta.serial);
+  auto range = by_vidpid_.equal_range(static_cast<uint32_t>(meta.vid) << 16 | meta.pid);
+  for (auto i = range.first; i != range.second; ++i)
+  {
+    if (i->second == name)
+    {
+      by_vidpid_.erase(i);
+      break;
+    }
+  }
+  for (const std::string& key : {meta.physical_path, meta.physical_path.substr(meta.physical_path.rfind('/') + 1)})
+  {
+    auto path = by_path_.find(key);
+    if (path != by_path_.end() && path->second == name) by_path_.erase(path);
+  }
+  ports_.erase(it);
+}
+
+/// @brief 监视线程中处理设备事件
+void PortEnumerator::onEvent(const DeviceWatcher::Event& event)
+{
+#if defined(__linux__)
+  // 只关心设备目录下的节点本身（by-id 等链接目录中的事件忽略）
+  const std::string prefix = config_.dev_root + "/";
+  if (event.devnode.compare(0, prefix.size(), prefix) != 0) return;
+  const std::string name = event.devnode.substr(prefix.size());
+  if (name.find('/') != std::string::npos || !serialName(name)) return;
+
+  std::lock_guard<std::mutex> lock(mtx_);
+  if (!cached_) return;  // 下一次 list() 会完整枚举
+  ++stats_.incremental;
+  eraseLocked(name);
+  PortMetadata meta;
+  if (event.added && probeName(name, meta)) storeLocked(name, std::move(meta));
+#else
+  (void)event;
+#endif
+}
@@ -0,0 +1,222 @@
+/// 说明：多串口共享的 epoll 反应器实现
+
+#include "serialport/port_reactor.h"
+
+#if defined(__linux__)
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+#include <cerrno>
+#endif
+
+namespace
+{
+constexpr uint64_t kWakeupId = 0;  ///< 唤醒 eventfd 的注册号
+thread_local uint64_t t_current_id = 0;  ///< 当前线程正在处理的注册号（用于在处理函数中注销自身）
+}  // namespace
+
+PortReactor::PortReactor(size_t threads, size_t buffer_size) :
+  thread_count_(threads == 0 ? 1 : threads), buffer_size_(buffer_size)
+{
+}
+
+PortReactor::~PortReactor()
+{
+  stop();
+}
+
+/// @brief 注册 fd
+uint64_t PortReactor::attach(int fd, Handler handler)
+{
+#if defined(__linux__)
+  if (fd < 0 || !handler) return 0;
+  std::lock_guard<std::mutex> lock(mtx_);
+  if (!startLocked()) return 0;
+
+  auto reg = std::make_shared<Registration>();
+  reg->fd = fd;
+  reg->handler = std::move(handler);
+  const uint64_t id = next_id_++;
+
+  struct epoll_event ev;
+  ev.events = EPOLLIN | EPOLLONESHOT;
+  ev.data.u64 = id;
+  regs_[id] = reg;  // 先登记再加入 epoll，事件可能立刻被其他线程取走
+  if (::epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, fd, &ev) != 0)
+  {
+    regs_.erase(id);
+    return 0;
+  }
+  return id;
+#else
+  (void)fd;
+  (void)handler;
+  return 0;
+#endif
+}
+
+/// @brief 注销 fd
+void PortReactor::detach(uint64_t id)
+{
+#if defined(__linux__)
+  std::unique_lock<std::mutex> lock(mtx_);
+  auto it = regs_.find(id);
+  if (it == regs_.end()) return;
+  std::shared_ptr<Registration> reg = it->second;
+  if (!reg->removed)
+  {
+    reg->removed = true;
+    ::epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, reg->fd, nullptr);
+  }
+  // 处理函数仍在运行时保留注册项作为墓碑，由反应器线程在处理函数返回后移除：
+  // 处理函数注销自身后，其他线程再次注销同一注册号仍能找到它并等待，而不是立即返回
+  if (reg->in_flight == 0)
+  {
+    regs_.erase(it);
+    return;
+  }
+
+  if (t_current_id == id) return;  // 在自身的处理函数中注销，不能等待自己
+  cv_.wait(lock, [&reg] { return reg->in_flight == 0; });
+#else
+  (void)id;
+#endif
+}
+
+/// @brief 停止所有反应器线程
+void PortReactor::stop()
+{
+#if defined(__linux__)
+  {
+    std::lock_guard<std::mutex> lock(mtx_);
+    if (!running_) return;
+    running_ = false;
+    uint64_t one = 1;
+    ssize_t r = ::write(wakeup_fd_, &one, sizeof(one));  // 水平触发，所有线程都会醒来
+    (void)r;
+  }
+  for (auto& t : threads_)
+  {
+    if (t.joinable()) t.join();
+  }
+  threads_.clear();
+
+  std::lock_guard<std::mutex> lock(mtx_);
+  regs_.clear();
+  ::close(epoll_fd_);
+  ::close(wakeup_fd_);
+  epoll_fd_ = wakeup_fd_ = -1;
+#endif
+}
+
+/// @brief 获取统计信息
+PortReactor::Stats PortReactor::stats() const
+{
+  Stats stats;
+  std::lock_guard<std::mutex> lock(mtx_);
+  stats.threads = threads_.size();
+  stats.registered = regs_.size();
+  stats.wakeups = wakeups_.load(std::memory_order_relaxed);
+  stats.events = events_.load(std::memory_order_relaxed);
+  return stats;
+}
+
+/// @brief 创建 epoll 集合并启动线程
+bool PortReactor::startLocked()
+{
+#if defined(__linux__)
+  if (running_) return true;
+
+  epoll_fd_ = ::epoll_create1(EPOLL_CLOEXEC);
+  wakeup_fd_ = ::eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+  struct epoll_event ev;
+  ev.events = EPOLLIN;
+  ev.data.u64 = kWakeupId;
+  if (epoll_fd_ < 0 || wakeup_fd_ < 0 || ::epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, wakeup_fd_, &ev) != 0)
+  {
+    if (epoll_fd_ >= 0) ::close(epoll_fd_);
+    if (wakeup_fd_ >= 0) ::close(wakeup_fd_);
+    epoll_fd_ = wakeup_fd_ = -1;
+    return false;
+  }
+
+  running_ = true;
+  for (size_t i = 0; i < thread_count_; ++i) threads_.emplace_back(&PortReactor::threadLoop, this);
+  return true;
+#else
+  return false;
+#endif
+}
+
+/// @brief 反应器线程主循环
+void PortReactor::threadLoop()
+{
+#if defined(__linux__)
+  std::vector<uint8_t> buffer(buffer_size_);
+  struct epoll_event events[64];
+
+  while (running_)
+  {
+    int n = ::epoll_wait(epoll_fd_, events, 64, -1);
+    if (n < 0)
+    {
+      if (errno == EINTR) continue;
+      break;
+    }
+    wakeups_.fetch_add(1, std::memory_order_relaxed);
+
+    for (int i = 0; i < n && running_; ++i)
+    {
+      const uint64_t id = events[i].data.u64;
+      if (id == kWakeupId) continue;
+
+      std::shared_ptr<Registration> reg;
+      {
+        std::lock_guard<std::mutex> lock(mtx_);
+        auto it = regs_.find(id);
+        if (it == regs_.end() || it->second->removed) continue;  // 事件取出后已被注销
+        reg = it->second;
+        ++reg->in_flight;
+      }
+      events_.fetch_add(1, std::memory_order_relaxed);
+
+      t_current_id = id;
+      bool keep = false;
+      try
+      {
+        keep = reg->handler(events[i].events, buffer);
+      }
+      catch (...)
+      {
+        keep = false;  // 处理函数应自行处理异常，这里只保证反应器线程不退出
+      }
+      t_current_id = 0;
+
+      std::lock_guard<std::mutex> lock(mtx_);
+      --reg->in_flight;
+      if (!reg->removed)
+      {
+        if (keep)
+        {
+          // EPOLLONESHOT：处理完毕后重新布防
+          struct epoll_event ev;
+          ev.events = EPOLLIN | EPOLLONESHOT;
+          ev.data.u64 = id;
+          ::epoll_ctl(epoll_fd_, EPOLL_CTL_MOD, reg->fd, &ev);
+        }
+        else
+        {
+          reg->removed = true;
+          ::epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, reg->fd, nullptr);
+        }
+      }
+      if (reg->removed)
+      {
+        if (reg->in_flight == 0) regs_.erase(id);  // 移除墓碑
+        cv_.notify_all();
+      }
+    }
+  }
+#endif
+}
@@ -0,0 +1,202 @@
+/// 说明：引用计数接收块池实现
+
+#include "serialport/rx_block_pool.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <stdexcept>
+
+namespace
+{
+constexpr size_t kBlockAlign = 64;  ///< 池内数据块按缓存行对齐，避免相邻块伪共享
+}  // namespace
+
+// =============================== RxBlock ===============================
+
+RxBlock::RxBlock(const RxBlock& other) : block_(other.block_)
+{
+  if (block_) block_->refs.fetch_add(1, std::memory_order_relaxed);
+}
+
+RxBlock::RxBlock(RxBlock&& other) noexcept : block_(other.block_)
+{
+  other.block_ = nullptr;
+}
+
+RxBlock& RxBlock::operator=(const RxBlock& other)
+{
+  if (other.block_) other.block_->refs.fetch_add(1, std::memory_order_relaxed);
+  reset();
+  block_ = other.block_;
+  return *this;
+}
+
+RxBlock& RxBlock::operator=(RxBlock&& other) noexcept
+{
+  if (this != &other)
+  {
+    reset();
+    block_ = other.block_;
+    other.block_ = nullptr;
+  }
+  return *this;
+}
+
+RxBlock::~RxBlock()
+{
+  reset();
+}
+
+/// @brief 设置有效数据长度
+void RxBlock::setSize(size_t size)
+{
+  if (block_) block_->size = std::min(size, block_->capacity);
+}
+
+/// @brief 设置接收时间戳
+void RxBlock::setTimestamp(const RxTimestamp& stamp)
+{
+  if (block_) block_->stamp = stamp;
+}
+
+/// @brief 释放持有的数据块
+void RxBlock::reset()
+{
+  if (block_)
+  {
+    release(block_);
+    block_ = nullptr;
+  }
+}
+
+/// @brief 减少引用计数，归零时归还数据块
+void RxBlock::release(Block* block)
+{
+  if (block->refs.fetch_sub(1, std::memory_order_acq_rel) != 1) return;
+
+  if (!block->owner)
+  {
+    // 池耗尽时从堆上分配的块
+    delete[] block->data;
+    delete block;
+    return;
+  }
+  // 先取出池的引用再归还：若这是最后一个引用，池在本函数末尾（而不是在池的成员函数中）析构
+  std::shared_ptr<RxBlockPool> pool = std::move(block->owner);
+  pool->recycle(block);
+}
+
+// ============================= RxBlockPool =============================
+
+RxBlockPool::RxBlockPool(size_t block_count, size_t block_size, Exhaustion policy) :
+  block_count_(block_count), block_size_(block_size), policy_(policy)
+{
+  if (block_count_ == 0 || block_size_ == 0)
+  {
+    throw std::invalid_argument("RxBlockPool: block count and block size must be > 0");
+  }
+
+  const size_t stride = (block_size_ + kBlockAlign - 1) / kBlockAlign * kBlockAlign;
+  slab_size_ = stride * block_count_ + kBlockAlign;
+  slab_.reset(new uint8_t[slab_size_]);
+  uint8_t* base = slab_.get();
+  base += (kBlockAlign - reinterpret_cast<uintptr_t>(base) % kBlockAlign) % kBlockAlign;
+
+  blocks_.reset(new RxBlock::Block[block_count_]);
+  free_.reserve(block_count_);
+  for (size_t i = block_count_; i > 0; --i)
+  {
+    RxBlock::Block& block = blocks_[i - 1];
+    block.data = base + (i - 1) * stride;
+    block.capacity = block_size_;
+    free_.push_back(&block);
+  }
+}
+
+/// @brief 取出一个空闲数据块
+RxBlock RxBlockPool::acquire(int64_t wait_ms)
+{
+  RxBlock::Block* block = nullptr;
+  {
+    std::unique_lock<std::mutex> lock(mtx_);
+    if (free_.empty())
+    {
+      misses_.fetch_add(1, std::memory_order_relaxed);
+      if (policy_ == Exhaustion::Drop) return RxBlock();
+
+      if (policy_ == Exhaustion::HeapFallback)
+      {
+        lock.unlock();
+        block = new RxBlock::Block;
+        block->data = new uint8_t[block_size_];
+        block->capacity = block_size_;
+        block->refs.store(1, std::memory_order_relaxed);
+        heap_allocations_.fetch_add(1, std::memory_order_relaxed);
+        acquired_.fetch_add(1, std::memory_order_relaxed);
+        return RxBlock(block);
+      }
+
+      waits_.fetch_add(1, std::memory_order_relaxed);
+      ++waiters_;
+      auto ready = [this] { return !free_.empty(); };
+      if (wait_ms < 0)
+      {
+        cv_.wait(lock, ready);
+      }
+      else
+      {
+        cv_.wait_for(lock, std::chrono::milliseconds(wait_ms), ready);
+      }
+      --waiters_;
+      if (free_.empty()) return RxBlock();
+    }
+    block = free_.back();
+    free_.pop_back();
+  }
+
+  block->size = 0;
+  block->stamp = RxTimestamp();
+  block->refs.store(1, std::memory_order_relaxed);
+  block->owner = shared_from_this();
+  acquired_.fetch_add(1, std::memory_order_relaxed);
+  return RxBlock(block);
+}
+
+/// @brief 预先触碰全部池内存
+void RxBlockPool::prefault()
+{
+  std::memset(slab_.get(), 0, slab_size_);
+}
+
+/// @brief 记录调用方丢弃的字节数
+void RxBlockPool::noteDropped(size_t size)
+{
+  dropped_bytes_.fetch_add(size, std::memory_order_relaxed);
+}
+
+/// @brief 获取池统计信息
+RxBlockPool::Stats RxBlockPool::stats() const
+{
+  Stats stats;
+  stats.block_count = block_count_;
+  stats.block_size = block_size_;
+  {
+    std::lock_guard<std::mutex> lock(mtx_);
+    stats.free_blocks = free_.size();
+  }
+  stats.acquired = acquired_.load(std::memory_order_relaxed);
+  stats.misses = misses_.load(std::memory_order_relaxed);
+  stats.heap_allocations = heap_allocations_.load(std::memory_order_relaxed);
+  stats.waits = waits_.load(std::memory_order_relaxed);
+  stats.dropped_bytes = dropped_bytes_.load(std::memory_order_relaxed);
+  return stats;
+}
+
+/// @brief 数据块放回空闲链表
+void RxBlockPool::recycle(RxBlock::Block* block)
+{
+  std::lock_guard<std::mutex> lock(mtx_);
+  free_.push_back(block);  // 容量已预留，不会分配
+  if (waiters_ > 0) cv_.notify_one();
+}
@@ -0,0 +1,206 @@
+/// 说明：有界接收队列实现
+
+#include "serialport/rx_queue.h"
+
+#include <chrono>
+#include <stdexcept>
+
+namespace
+{
+/// @brief 当前 steady_clock 时间（纳秒）
+int64_t steadyNowNs()
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+    .count();
+}
+}  // namespace
+
+RxQueue::RxQueue(size_t max_chunks, size_t max_bytes, Overflow policy) :
+  max_chunks_(max_chunks), max_bytes_(max_bytes), policy_(policy), slots_(max_chunks)
+{
+  if (max_chunks_ == 0) throw std::invalid_argument("RxQueue: max chunks must be > 0");
+}
+
+/// @brief 设置慢消费者回调
+void RxQueue::setSlowConsumer(size_t threshold_bytes, SlowConsumerCallback cb)
+{
+  std::lock_guard<std::mutex> lock(mtx_);
+  slow_threshold_ = threshold_bytes;
+  slow_cb_ = std::move(cb);
+  slow_armed_ = true;
+}
+
+/// @brief 数据块入队
+bool RxQueue::push(RxBlock&& block, int64_t wait_ms)
+{
+  const size_t size = block.size();
+  bool fire_slow = false;
+  Stats slow_stats;
+  {
+    std::unique_lock<std::mutex> lock(mtx_);
+    if (!closed_ && !hasRoom(size))
+    {
+      if (policy_ == Overflow::DropNewest)
+      {
+        noteLoss(1, size);
+        block.reset();
+        return false;
+      }
+      if (policy_ == Overflow::DropOldest)
+      {
+        uint64_t chunks = 0;
+        uint64_t bytes = 0;
+        while (!hasRoom(size))
+        {
+          bytes += takeFront().size();
+          ++chunks;
+        }
+        noteLoss(chunks, bytes);
+      }
+      else
+      {
+        stats_.block_waits++;
+        const auto start = std::chrono::steady_clock::now();
+        auto ready = [this, size] { return closed_ || hasRoom(size); };
+        if (wait_ms < 0)
+        {
+          not_full_.wait(lock, ready);
+        }
+        else
+        {
+          not_full_.wait_for(lock, std::chrono::milliseconds(wait_ms), ready);
+        }
+        stats_.blocked_ns += static_cast<uint64_t>(
+          std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count());
+      }
+    }
+    if (closed_)
+    {
+      noteLoss(1, size);
+      block.reset();
+      return false;
+    }
+    if (!hasRoom(size)) return false;  // Block 策略等待超时，数据块留给调用方
+
+    slots_[(head_ + count_) % max_chunks_] = std::move(block);
+    ++count_;
+    bytes_ += size;
+    stats_.enqueued_chunks++;
+    stats_.enqueued_bytes += size;
+    if (count_ > stats_.high_water_chunks) stats_.high_water_chunks = count_;
+    if (bytes_ > stats_.high_water_bytes) stats_.high_water_bytes = bytes_;
+
+    if (slow_threshold_ > 0 && slow_armed_ && bytes_ >= slow_threshold_)
+    {
+      slow_armed_ = false;
+      stats_.slow_consumer_events++;
+      fire_slow = static_cast<bool>(slow_cb_);
+      if (fire_slow) slow_stats = snapshot();
+    }
+  }
+  not_empty_.notify_one();
+  if (fire_slow) slow_cb_(slow_stats);  // 在锁外调用，回调中可以安全地读取统计
+  return true;
+}
+
+/// @brief 放弃未能入队的数据块
+void RxQueue::discard(RxBlock&& block)
+{
+  const size_t size = block.size();
+  block.reset();
+  std::lock_guard<std::mutex> lock(mtx_);
+  noteLoss(1, size);
+}
+
+/// @brief 数据块出队
+bool RxQueue::pop(RxBlock& out, int64_t wait_us)
+{
+  {
+    std::unique_lock<std::mutex> lock(mtx_);
+    auto ready = [this] { return count_ > 0 || closed_; };
+    if (wait_us < 0)
+    {
+      not_empty_.wait(lock, ready);
+    }
+    else
+    {
+      not_empty_.wait_for(lock, std::chrono::microseconds(wait_us), ready);
+    }
+    if (count_ == 0) return false;
+
+    out = takeFront();
+    if (!slow_armed_ && bytes_ <= slow_threshold_ / 2) slow_armed_ = true;  // 回落到阈值一半以下后重新布防
+  }
+  if (policy_ == Overflow::Block) not_full_.notify_one();
+  return true;
+}
+
+/// @brief 重新打开队列
+void RxQueue::open()
+{
+  std::lock_guard<std::mutex> lock(mtx_);
+  closed_ = false;
+}
+
+/// @brief 关闭队列并唤醒所有等待者
+void RxQueue::close()
+{
+  {
+    std::lock_guard<std::mutex> lock(mtx_);
+    closed_ = true;
+  }
+  not_empty_.notify_all();
+  not_full_.notify_all();
+}
+
+/// @brief 队列是否已关闭
+bool RxQueue::closed() const
+{
+  std::lock_guard<std::mutex> lock(mtx_);
+  return closed_;
+}
+
+/// @brief 获取统计信息
+RxQueue::Stats RxQueue::stats() const
+{
+  std::lock_guard<std::mutex> lock(mtx_);
+  return snapshot();
+}
+
+/// @brief 判断是否还能放入数据块
+bool RxQueue::hasRoom(size_t size) const
+{
+  if (count_ == 0) return true;
+  if (count_ >= max_chunks_) return false;
+  return max_bytes_ == 0 || bytes_ + size <= max_bytes_;
+}
+
+/// @brief 取出队首数据块
+RxBlock RxQueue::takeFront()
+{
+  RxBlock block = std::move(slots_[head_]);
+  head_ = (head_ + 1) % max_chunks_;
+  --count_;
+  bytes_ -= block.size();
+  return block;
+}
+
+/// @brief 记录一次丢弃
+void RxQueue::noteLoss(uint64_t chunks, uint64_t bytes)
+{
+  stats_.dropped_chunks += chunks;
+  stats_.dropped_bytes += bytes;
+  stats_.loss_events++;
+  stats_.last_loss_ns = steadyNowNs();
+}
+
+/// @brief 生成统计快照
+RxQueue::Stats RxQueue::snapshot() const
+{
+  Stats stats = stats_;
+  stats.max_chunks = max_chunks_;
+  stats.max_bytes = max_bytes_;
+  stats.chunks = count_;
+  stats.bytes = bytes_;
+  return stats;
+}
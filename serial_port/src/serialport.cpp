@@ -5,6 +5,27 @@
 
 #include "serialport/serialport.h"
 
+#include <algorithm>
+#include <cmath>
+#include <future>
+#include <random>
+
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <poll.h>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#if defined(__linux__)
+#include <sys/epoll.h>
+#include <sys/timerfd.h>
+#endif
+
+#include <cerrno>
+#include <cstring>
+#endif
+
 SerialPort::SerialPort(const std::string& port, uint32_t baudrate) : port_(port), baudrate_(baudrate) {}
 
 SerialPort::~SerialPort()
@@ -15,7 +36,8 @@ SerialPort::~SerialPort()
 /// @brief 列出系统当前可用串口
 std::vector<serial::PortInfo> SerialPort::listPorts()
 {
-  return serial::list_ports();
+  static PortEnumerator enumerator;  // 非 Linux 平台上直接调用 serial::list_ports()
+  return enumerator.list();
 }
 
 /// @brief 设置串口端口名
@@ -46,12 +68,319 @@ SerialPort& SerialPort::setReconnectLimit(size_t limit)
   return *this;
 }
 
-/// @brief 设置数据接收回调
+/// @brief 设置重连退避策略
+SerialPort& SerialPort::setReconnectPolicy(const ReconnectPolicy& policy)
+{
+  reconnect_policy_ = policy;
+  return *this;
+}
+
+/// @brief 设置连接状态变化回调
+SerialPort& SerialPort::setStateCallback(StateCallback cb)
+{
+  state_cb_ = std::move(cb);
+  return *this;
+}
+
+/// @brief 获取重连统计信息
+SerialPort::ReconnectStats SerialPort::reconnectStats() const
+{
+  ReconnectStats stats;
+  stats.disconnects = disconnects_.load(std::memory_order_relaxed);
+  stats.recoveries = recoveries_.load(std::memory_order_relaxed);
+  stats.give_ups = give_ups_.load(std::memory_order_relaxed);
+  stats.attempts = reconnect_attempts_.load(std::memory_order_relaxed);
+  stats.last_recovery_ns = last_recovery_ns_.load(std::memory_order_relaxed);
+  stats.recovery = recovery_hist_.snapshot();
+  return stats;
+}
+
+/// @brief 设置读线程工作模式
+SerialPort& SerialPort::setReadMode(ReadMode mode)
+{
+  read_mode_ = mode;
+  return *this;
+}
+
+/// @brief 设置读线程配置
+SerialPort& SerialPort::setThreadProfile(const ThreadProfile& profile)
+{
+  thread_profile_ = profile;
+  return *this;
+}
+
+/// @brief 设置共享反应器
+SerialPort& SerialPort::setReactor(std::shared_ptr<PortReactor> reactor)
+{
+  reactor_ = std::move(reactor);
+  return *this;
+}
+
+/// @brief 设置热插拔监视器
+SerialPort& SerialPort::setDeviceWatcher(std::shared_ptr<DeviceWatcher> watcher)
+{
+  watcher_ = std::move(watcher);
+  enumerator_.reset();  // 下次打开时按新监视器的目录重新创建
+  return *this;
+}
+
+/// @brief 按 USB 身份绑定设备
+SerialPort& SerialPort::setDeviceIdentity(const DeviceIdentity& identity)
+{
+  identity_ = identity;
+  return *this;
+}
+
+/// @brief 设置数据接收回调（兼容接口，包装为视图回调）
 SerialPort& SerialPort::setDataCallback(DataCallback cb)
+{
+  if (cb)
+  {
+    data_cb_ = [cb](const DataView& view) { cb(view.toString()); };
+  }
+  else
+  {
+    data_cb_ = nullptr;
+  }
+  return *this;
+}
+
+/// @brief 设置零拷贝数据接收回调
+SerialPort& SerialPort::setDataViewCallback(DataViewCallback cb)
 {
   data_cb_ = std::move(cb);
   return *this;
 }
+
+/// @brief 设置帧解码器
+SerialPort& SerialPort::setFrameDecoder(std::unique_ptr<FrameDecoder> decoder)
+{
+  decoder_ = std::move(decoder);
+  return *this;
+}
+
+/// @brief 设置帧回调
+SerialPort& SerialPort::setFrameCallback(FrameCallback cb)
+{
+  frame_cb_ = std::move(cb);
+  return *this;
+}
+
+/// @brief 获取帧解码统计信息
+FrameDecoder::Stats SerialPort::frameStats() const
+{
+  return decoder_ ? decoder_->stats() : FrameDecoder::Stats();
+}
+
+/// @brief 启用接收环形缓冲
+SerialPort& SerialPort::setRingBuffer(size_t capacity, RingConsumer consumer)
+{
+  if (capacity == 0)
+  {
+    ring_.reset();
+  }
+  else
+  {
+    ring_.reset(new SpscRing(capacity));
+  }
+  ring_consumer_ = consumer;
+  return *this;
+}
+
+/// @brief 从环形缓冲中批量取出数据
+size_t SerialPort::consumeRing(const DataViewCallback& cb, uint32_t wait_ms)
+{
+  if (!ring_ || !cb) return 0;
+  if (wait_ms > 0 && !waitRing(static_cast<int64_t>(wait_ms) * 1000)) return 0;
+  return ring_->consume([&cb](const uint8_t* data, size_t size) {
+    DataView view;
+    view.data = data;
+    view.size = size;
+    cb(view);
+  });
+}
+
+/// @brief 获取环形缓冲统计信息
+SerialPort::RingStats SerialPort::ringStats() const
+{
+  RingStats stats;
+  if (ring_)
+  {
+    stats.capacity = ring_->capacity();
+    stats.used = ring_->size();
+    stats.high_water_mark = ring_->highWaterMark();
+    stats.pushed_bytes = ring_->pushedBytes();
+    stats.overflow_bytes = ring_->overflowBytes();
+    stats.overflow_events = ring_->overflowEvents();
+  }
+  return stats;
+}
+
+/// @brief 启用接收块池
+SerialPort& SerialPort::setBlockPool(size_t block_count, size_t block_size, RxBlockPool::Exhaustion policy)
+{
+  if (block_count == 0 || block_size == 0)
+  {
+    pool_.reset();
+  }
+  else
+  {
+    pool_ = std::make_shared<RxBlockPool>(block_count, block_size, policy);
+  }
+  return *this;
+}
+
+/// @brief 设置接收块回调
+SerialPort& SerialPort::setBlockCallback(BlockCallback cb)
+{
+  block_cb_ = std::move(cb);
+  return *this;
+}
+
+/// @brief 获取接收块池统计信息
+RxBlockPool::Stats SerialPort::poolStats() const
+{
+  return pool_ ? pool_->stats() : RxBlockPool::Stats();
+}
+
+/// @brief 启用有界接收队列
+SerialPort& SerialPort::setRxQueue(size_t max_chunks, size_t max_bytes, RxQueue::Overflow policy)
+{
+  if (max_chunks == 0)
+  {
+    queue_.reset();
+  }
+  else
+  {
+    queue_.reset(new RxQueue(max_chunks, max_bytes, policy));
+  }
+  return *this;
+}
+
+/// @brief 设置慢消费者回调
+SerialPort& SerialPort::setSlowConsumerCallback(size_t threshold_bytes, RxQueue::SlowConsumerCallback cb)
+{
+  slow_threshold_ = threshold_bytes;
+  slow_cb_ = std::move(cb);
+  return *this;
+}
+
+/// @brief 获取接收队列统计信息
+RxQueue::Stats SerialPort::queueStats() const
+{
+  return queue_ ? queue_->stats() : RxQueue::Stats();
+}
+
+/// @brief 启用异步发送
+SerialPort& SerialPort::setAsyncWrite(bool enable, size_t max_batch_bytes)
+{
+  if (enable)
+  {
+    if (!tx_queue_) tx_queue_.reset(new TxQueue);
+  }
+  else
+  {
+    tx_queue_.reset();
+  }
+  tx_batch_bytes_ = max_batch_bytes == 0 ? 1 : max_batch_bytes;
+  return *this;
+}
+
+/// @brief 设置批量数据的分片时长
+SerialPort& SerialPort::setTxSlice(uint32_t slice_us)
+{
+  tx_slice_us_ = slice_us;
+  return *this;
+}
+
+/// @brief 启用按波特率的发送节拍控制
+SerialPort& SerialPort::setTxPacing(bool enable, const TxPacer::Config& config)
+{
+  if (enable)
+  {
+    pacer_.reset(new TxPacer(config));
+    if (!tx_queue_) tx_queue_.reset(new TxQueue);  // 节拍只在写线程中执行
+  }
+  else
+  {
+    pacer_.reset();
+  }
+  return *this;
+}
+
+/// @brief 获取发送节拍统计信息
+TxPacer::Stats SerialPort::pacingStats() const
+{
+  return pacer_ ? pacer_->stats() : TxPacer::Stats();
+}
+
+/// @brief 异步发送
+bool SerialPort::writeAsync(std::string data, TxQueue::Completion done, TxQueue::Priority priority)
+{
+  if (!tx_queue_ || !tx_running_) return false;
+  tx_queue_->push(std::move(data), std::move(done), priority);
+  return true;
+}
+
+/// @brief 获取发送队列统计信息
+TxQueue::Stats SerialPort::txStats() const
+{
+  return tx_queue_ ? tx_queue_->stats() : TxQueue::Stats();
+}
+
+/// @brief 设置数据回调合并条件
+SerialPort& SerialPort::setCoalescing(size_t min_bytes, uint32_t max_delay_us)
+{
+  coalescer_.configure(min_bytes, max_delay_us);
+  return *this;
+}
+
+/// @brief 获取回调合并统计信息
+CallbackCoalescer::Stats SerialPort::coalesceStats() const
+{
+  return coalescer_.stats();
+}
+
+/// @brief 设置是否记录墙上时钟时间戳
+SerialPort& SerialPort::setRealtimeTimestamps(bool enable)
+{
+  realtime_stamps_ = enable;
+  return *this;
+}
+
+/// @brief 获取延迟直方图快照
+SerialPort::LatencyStats SerialPort::latencyStats() const
+{
+  LatencyStats stats;
+  stats.inter_chunk_gap = gap_hist_.snapshot();
+  stats.callback_time = callback_hist_.snapshot();
+  stats.queue_dwell = dwell_hist_.snapshot();
+  return stats;
+}
+
+/// @brief 清空延迟直方图
+void SerialPort::resetLatencyStats()
+{
+  gap_hist_.reset();
+  callback_hist_.reset();
+  dwell_hist_.reset();
+}
+
+/// @brief 启用驱动与转换芯片的低延迟设置
+SerialPort& SerialPort::setLowLatency(bool enable, uint32_t latency_timer_ms)
+{
+  low_latency_ = enable;
+  latency_timer_ms_ = std::min<uint32_t>(std::max<uint32_t>(latency_timer_ms, 1), 255);
+  return *this;
+}
+
+/// @brief 获取最近一次的延迟调优结果
+SerialPort::LatencyTuning SerialPort::latencyTuning() const
+{
+  std::lock_guard<std::mutex> lock(tuning_mtx_);
+  return tuning_;
+}
+
 /// @brief 设置日志输出回调
 SerialPort& SerialPort::setLogCallback(LogCallback cb)
 {
@@ -62,9 +391,10 @@ SerialPort& SerialPort::setLogCallback(LogCallback cb)
 /// @brief 打开串口
 bool SerialPort::open()
 {
-  std::lock_guard<std::mutex> lock(mtx_);
+  // 只串行化 open/close 本身：重试等待期间读写路径只看 state_，不会被阻塞
+  std::lock_guard<std::mutex> lock(life_mtx_);
 
-  if (port_.empty())
+  if (port_.empty() && !identity_.valid())
   {
     logMsg(LogLevel::Error, "open failed: port not set");
     return false;
@@ -74,22 +404,56 @@ bool SerialPort::open()
     logMsg(LogLevel::Error, "open failed: baudrate not set");
     return false;
   }
+#if !defined(_WIN32)
+  if (eventDriven() && !openWakeup())
+  {
+    logMsg(LogLevel::Error, "open failed: cannot create wakeup pipe");
+    return false;
+  }
+#endif
+
+  // 放弃重连后读线程已自行退出循环，重新打开前回收
+  if (!running_ && reader_thread_.joinable()) reader_thread_.join();
+
+  // 订阅热插拔事件：重试等待期间设备节点出现时立即重试；只绑定身份时创建私有监视器
+  if (identity_.valid() && !watcher_) watcher_ = std::make_shared<DeviceWatcher>();
+  if (watcher_ && watch_id_ == 0)
+  {
+    watch_id_ = watcher_->subscribe([this](const DeviceWatcher::Event& event) { onHotplug(event); });
+    if (watch_id_ == 0) logMsg(LogLevel::Warning, "hotplug watcher unavailable, fall back to polling the device node");
+  }
+  // 按身份查找节点走枚举器的索引（不做完整枚举），低延迟调优也经它读写 sysfs；有监视器时目录与监视器一致
+  if ((identity_.valid() || low_latency_) && !enumerator_)
+  {
+    PortEnumerator::Config config;
+    if (watcher_)
+    {
+      config.sysfs_root = watcher_->config().sysfs_root;
+      config.dev_root = watcher_->config().dev_root;
+    }
+    enumerator_.reset(new PortEnumerator(config));
+  }
+  {
+    std::lock_guard<std::mutex> state_lock(state_mtx_);
+    hotplug_seen_ = hotplug_seq_;
+    hotplug_node_.clear();
+  }
 
+  setState(LinkState::Opening);
   try
   {
-    auto timeout = serial::Timeout::simpleTimeout(timeout_ms_);
+    auto timeout = makeTimeout();
     serial_.setPort(port_);
     serial_.setBaudrate(baudrate_);
     serial_.setTimeout(timeout);
+    // 读只发生在唯一的读路径上，写由 tx_mtx_ 串行化，开关串口也与读写互斥，serial 库自带的锁可以省去
+    serial_.setLockElision(true, true);
+    // 只在启用过低延迟设置时改动驱动标志，否则保持驱动默认值
+    if (low_latency_ || latencyTuning().requested) serial_.setLowLatency(low_latency_);
+    resolveDevice();
     serial_.open();
 
-    if (serial_.isOpen())
-    {
-      running_ = true;
-      if (!reader_thread_.joinable()) reader_thread_ = std::thread(&SerialPort::readLoop, this);
-      logMsg(LogLevel::Info, "SerialPort opened");
-      return true;
-    }
+    if (serial_.isOpen()) return openDone("SerialPort opened");
   }
   catch (const std::exception& e)
   {
@@ -99,17 +463,12 @@ bool SerialPort::open()
   // 重连尝试
   for (size_t attempt = 1; attempt <= reconnect_max_; ++attempt)
   {
-    std::this_thread::sleep_for(std::chrono::milliseconds(500 * attempt));
+    if (!backoff(backoffDelayMs(attempt), LinkState::Opening)) break;  // close() 打断了等待
     try
     {
+      resolveDevice();
       serial_.open();
-      if (serial_.isOpen())
-      {
-        running_ = true;
-        if (!reader_thread_.joinable()) reader_thread_ = std::thread(&SerialPort::readLoop, this);
-        logMsg(LogLevel::Info, "SerialPort reconnected");
-        return true;
-      }
+      if (serial_.isOpen()) return openDone("SerialPort reconnected");
     }
     catch (const std::exception& e)
     {
@@ -117,33 +476,120 @@ bool SerialPort::open()
     }
   }
 
+  transition(LinkState::Opening, LinkState::Closed);
   logMsg(LogLevel::Error, "open failed after retries");
   return false;
 }
 
+/// @brief 应用低延迟设置并记录结果
+void SerialPort::tuneLatency()
+{
+  LatencyTuning tuning;
+  tuning.requested = low_latency_;
+#if defined(__linux__)
+  if (low_latency_)
+  {
+    // ASYNC_LOW_LATENCY 已在 serial 库配置串口时设置，这里读回驱动实际接受的值
+    tuning.low_latency = serial_.getLowLatency();
+
+    // 驱动名与 latency_timer 取自 sysfs（by-id 等链接会被解析）；pty 等没有 device 链接的节点查不到
+    PortMetadata meta;
+    if (enumerator_->metadata(serial_.getPort(), meta))
+    {
+      tuning.driver = meta.driver;
+      tuning.latency_timer_ms = meta.latency_timer_ms;
+      // FTDI 等芯片默认 16ms，重新插入后恢复默认值
+      if (meta.latency_timer_ms >= 0 && meta.latency_timer_ms != static_cast<int>(latency_timer_ms_))
+      {
+        if (enumerator_->setLatencyTimer(meta.port, latency_timer_ms_))
+        {
+          tuning.latency_timer_ms = static_cast<int>(latency_timer_ms_);
+          tuning.latency_timer_set = true;
+        }
+        else
+        {
+          logMsg(LogLevel::Warning, "cannot set latency_timer of " + meta.port + ": " + std::strerror(errno));
+        }
+      }
+    }
+    logMsg(LogLevel::Info, "low latency: driver=" + (tuning.driver.empty() ? std::string("unknown") : tuning.driver) +
+                               " async_low_latency=" + (tuning.low_latency ? "on" : "off") +
+                               " latency_timer=" + std::to_string(tuning.latency_timer_ms));
+  }
+#endif
+  std::lock_guard<std::mutex> lock(tuning_mtx_);
+  tuning_ = std::move(tuning);
+}
+
+/// @brief 打开成功后切换到 Open 并启动各线程
+bool SerialPort::openDone(const char* msg)
+{
+  tuneLatency();
+  if (!transition(LinkState::Opening, LinkState::Open))
+  {
+    // 打开期间 close() 已经开始：不再启动线程，串口交给 close() 关闭
+    logMsg(LogLevel::Warning, "open aborted by close()");
+    return false;
+  }
+  startReader();
+  logMsg(LogLevel::Info, msg);
+  return true;
+}
+
 /// @brief 关闭串口
 void SerialPort::close()
 {
-  stop();  // 停止读线程
+  setState(LinkState::Closing);  // 打断 open() 与重连的重试等待，写路径随即快速失败
+  stopReconnector();             // 先停止重连线程，之后不会再有人重新打开串口或注册反应器
+  stop();                        // 停止读线程
+  stopRing();                    // 读线程停止后再停止消费线程，确保环中剩余数据被取完
+  stopQueue();                   // 同上，交付线程取完队列中剩余数据后退出
+  stopWriter();                  // 关闭串口前写完已提交的数据
 
-  std::lock_guard<std::mutex> lock(mtx_);
-  if (serial_.isOpen())
+  std::lock_guard<std::mutex> lock(life_mtx_);
+  if (watch_id_ != 0)
   {
-    serial_.close();
-    logMsg(LogLevel::Info, "SerialPort closed");
+    watcher_->unsubscribe(watch_id_);
+    watch_id_ = 0;
+  }
+  {
+    std::lock_guard<std::mutex> tx_lock(tx_mtx_);
+    if (serial_.isOpen())
+    {
+      serial_.close();
+      logMsg(LogLevel::Info, "SerialPort closed");
+    }
   }
+#if !defined(_WIN32)
+  closeWakeup();
+#endif
+  setState(LinkState::Closed);
 }
 
 /// @brief 检查串口是否已打开
 bool SerialPort::isOpen() const
 {
-  return serial_.isOpen();
+  return state_.load(std::memory_order_acquire) == LinkState::Open;
+}
+
+/// @brief 获取连接状态
+SerialPort::LinkState SerialPort::linkState() const
+{
+  return state_.load(std::memory_order_acquire);
 }
 
 /// @brief 向串口发送数据
 size_t SerialPort::write(const std::string& data)
 {
-  std::lock_guard<std::mutex> lock(mtx_);
+  // 连接不可用（打开中、重连中、已关闭）时立即失败，不在任何锁上等待
+  if (state_.load(std::memory_order_acquire) != LinkState::Open)
+  {
+    logMsg(LogLevel::Error, "write failed: not open");
+    return 0;
+  }
+  if (pacer_ && tx_running_) return writePaced(data);
+
+  std::lock_guard<std::mutex> lock(tx_mtx_);
   if (!serial_.isOpen())
   {
     logMsg(LogLevel::Error, "write failed: not open");
@@ -161,80 +607,1288 @@ size_t SerialPort::write(const std::string& data)
   }
 }
 
-/// @brief 内部停止读线程
-void SerialPort::stop()
+/// @brief 聚集写：多段数据一次写出
+size_t SerialPort::write(const serial::IoVec* buffers, size_t count)
 {
-  running_ = false;
-  if (reader_thread_.joinable())
+  if (state_.load(std::memory_order_acquire) != LinkState::Open)
   {
-    reader_thread_.join();
+    logMsg(LogLevel::Error, "write failed: not open");
+    return 0;
+  }
+  if (pacer_ && tx_running_)
+  {
+    std::string data;
+    for (size_t i = 0; i < count; ++i) data.append(static_cast<const char*>(buffers[i].data), buffers[i].size);
+    return writePaced(std::move(data));
   }
-}
 
-/// @brief 内部读线程主循环
-void SerialPort::readLoop()
-{
-  std::vector<uint8_t> buffer(1024 * 64);  // 64KB 缓冲区
-  while (running_)
+  std::lock_guard<std::mutex> lock(tx_mtx_);
+  if (!serial_.isOpen())
   {
-    try
-    {
-      if (!serial_.isOpen())
-      {
-        logMsg(LogLevel::Warning, "disconnected, try reconnect");
-        reconnect();
-        continue;
-      }
+    logMsg(LogLevel::Error, "write failed: not open");
+    return 0;
+  }
 
-      // 读取最多 buffer.size() 字节，复用 buffer
-      size_t n = serial_.read(buffer.data(), buffer.size());
-      if (n > 0 && data_cb_)
-      {
-        data_cb_(std::string(reinterpret_cast<const char*>(buffer.data()), n));
-      }
-      else if (n == 0)
-      {
-        // 没有数据，短暂 sleep 避免 CPU 占满
-        std::this_thread::sleep_for(std::chrono::milliseconds(5));
-      }
-    }
-    catch (const std::exception& e)
-    {
-      logMsg(LogLevel::Warning, std::string("read exception: ") + e.what());
-      reconnect();
-    }
+  try
+  {
+    return serial_.write(buffers, count);
+  }
+  catch (const std::exception& e)
+  {
+    logMsg(LogLevel::Error, std::string("write exception: ") + e.what());
+    return 0;
   }
 }
 
-/// @brief 内部尝试重连串口
-void SerialPort::reconnect()
+/// @brief 聚集写（便捷形式）
+size_t SerialPort::write(std::initializer_list<serial::IoVec> buffers)
 {
-  stop();
+  return write(buffers.begin(), buffers.size());
+}
+
+/// @brief 节拍模式下的同步写：交给写线程按节拍写出并等待完成
+size_t SerialPort::writePaced(std::string data)
+{
+  // 调用方只等待结果，不持有任何锁；未写出的条目在 stopWriter() 中以失败完成，不会永久阻塞
+  auto result = std::make_shared<std::promise<size_t>>();
+  std::future<size_t> written = result->get_future();
+  tx_queue_->push(std::move(data), [result](bool, size_t n) { result->set_value(n); });
+  return written.get();
+}
 
-  std::lock_guard<std::mutex> lock(mtx_);
-  if (serial_.isOpen()) serial_.close();
+/// @brief 内部启动读线程
+void SerialPort::startReader()
+{
+  if (decoder_) decoder_->reset();  // 重新打开后丢弃上次连接遗留的半帧
+  if (!coalesce_cb_)
+  {
+    coalesce_cb_ = [this](const uint8_t* data, size_t size, const RxTimestamp& stamp) {
+      callDataCallback(data, size, stamp);
+    };
+  }
+  last_chunk_ns_ = 0;  // 重新打开后的第一个数据块不计到达间隔
+  startWriter();
+  startReconnector();
 
-  for (size_t attempt = 1; attempt <= reconnect_max_ && running_; ++attempt)
+  if (queue_)
   {
-    std::this_thread::sleep_for(std::chrono::milliseconds(500 * attempt));
-    try
+    // 队列以数据块为单位排队，未设置接收块池时按队列深度自动创建一个
+    if (!pool_) pool_ = std::make_shared<RxBlockPool>(queue_->stats().max_chunks + 2, 4096);
+    queue_->setSlowConsumer(slow_threshold_, slow_cb_);
+    queue_->open();
+    if (!queue_thread_.joinable()) queue_thread_ = std::thread(&SerialPort::queueConsumerLoop, this);
+  }
+  else if (ring_ && !ring_running_)
+  {
+    ring_running_ = true;
+    if (ring_consumer_ == RingConsumer::Internal && !ring_thread_.joinable())
     {
-      serial_.open();
-      if (serial_.isOpen())
+      ring_thread_ = std::thread(&SerialPort::ringConsumerLoop, this);
+    }
+  }
+  running_ = true;
+  if (reactor_ && attachReactor()) return;
+#if !defined(_WIN32)
+  if (read_mode_ == ReadMode::External)
+  {
+    external_ = true;
+    pump_buffer_.resize(1024 * 64);
+    return;
+  }
+#endif
+  if (!reader_thread_.joinable()) reader_thread_ = std::thread(&SerialPort::readLoop, this);
+}
+
+/// @brief 内部停止读线程
+void SerialPort::stop()
+{
+  running_ = false;
+  detachReactor();
+  if (external_)
+  {
+    external_ = false;
+    if (readerDelivers()) flushCoalesced();  // 没有读线程在退出时交付，这里代为交付
+  }
+#if !defined(_WIN32)
+  wakeup();  // 事件驱动模式下读线程阻塞在 poll 上，需要主动唤醒
+#endif
+  if (reader_thread_.joinable())
+  {
+    reader_thread_.join();
+  }
+}
+
+/// @brief 内部停止环形缓冲消费线程
+void SerialPort::stopRing()
+{
+  {
+    std::lock_guard<std::mutex> lock(ring_mtx_);
+    ring_running_ = false;
+  }
+  ring_cv_.notify_all();
+  if (ring_thread_.joinable())
+  {
+    ring_thread_.join();
+  }
+}
+
+/// @brief 环形缓冲消费线程主循环
+void SerialPort::ringConsumerLoop()
+{
+  while (ring_running_ || !ring_->empty())
+  {
+    if (!waitRing(coalesceWaitUs()))
+    {
+      pollCoalesced();
+      continue;
+    }
+    ring_->consume([this](const uint8_t* data, size_t size) { dispatch(data, size, RxTimestamp()); });
+  }
+  flushCoalesced();
+}
+
+/// @brief 启动写线程
+void SerialPort::startWriter()
+{
+  if (pacer_)
+  {
+    // 打开（或重连）后按实际串口参数换算节拍，上一次连接遗留的节拍状态作废
+    pacer_->setByteTime(serial_.getByteTimeNs());
+    pacer_->reset();
+  }
+  if (!tx_queue_ || writer_thread_.joinable()) return;
+  tx_queue_->open();
+  tx_running_ = true;
+  writer_thread_ = std::thread(&SerialPort::writerLoop, this);
+}
+
+/// @brief 停止写线程
+void SerialPort::stopWriter()
+{
+  tx_running_ = false;
+  if (tx_queue_) tx_queue_->close();
+  if (writer_thread_.joinable())
+  {
+    writer_thread_.join();
+  }
+  if (!tx_queue_) return;
+
+  // 写线程退出与 tx_running_ 置位之间提交的条目不会再被写出
+  std::vector<TxQueue::Item> rest;
+  TxQueue::Item item;
+  size_t bytes = 0;
+  while (tx_queue_->pop(item))
+  {
+    bytes += item.data.size();
+    rest.push_back(std::move(item));
+  }
+  tx_queue_->finish(rest.size(), bytes, rest.size());
+  for (auto& r : rest)
+  {
+    if (r.done) r.done(false, 0);
+  }
+}
+
+/// @brief 写线程主循环
+void SerialPort::writerLoop()
+{
+  std::vector<TxQueue::Item> batch;
+  std::vector<TxQueue::Item> urgent;
+  std::vector<serial::IoVec> iov;
+  tx_line_free_ns_ = 0;
+  // 关闭后 wait() 在队列取空之前仍返回 true，保证已提交的数据都被写出
+  while (tx_queue_->wait())
+  {
+    // 打开或重连期间条目留在队列中，连接恢复后再写出
+    if (state_.load(std::memory_order_acquire) != LinkState::Open) waitLinkUp();
+    writeUrgent(urgent, iov);
+    // 节拍模式下每条数据是一帧，逐条写出以便插入帧间隔
+    const size_t batch_bytes = pacer_ ? 1 : tx_batch_bytes_;
+    size_t bytes = 0;
+    TxQueue::Item item;
+    while (bytes < batch_bytes && tx_queue_->pop(item, TxQueue::Priority::Normal))
+    {
+      bytes += item.data.size();
+      batch.push_back(std::move(item));
+    }
+    if (batch.empty()) continue;
+    writeBatch(batch, urgent, iov);
+    batch.clear();
+  }
+}
+
+/// @brief 分片写出一批普通条目
+void SerialPort::writeBatch(std::vector<TxQueue::Item>& batch, std::vector<TxQueue::Item>& urgent,
+                            std::vector<serial::IoVec>& iov)
+{
+  size_t total = 0;
+  for (const auto& item : batch) total += item.data.size();
+
+  // 分片字节数由分片时长与当前串口参数下的单字节传输时间换算；未启用分片或串口未打开时整批写出
+  uint32_t byte_ns = 0;
+  {
+    std::lock_guard<std::mutex> lock(tx_mtx_);
+    if (serial_.isOpen()) byte_ns = serial_.getByteTimeNs();
+  }
+  const int64_t slice_ns = static_cast<int64_t>(tx_slice_us_) * 1000;
+  size_t slice = total;
+  if (slice_ns > 0 && byte_ns > 0) slice = std::max<size_t>(1, static_cast<size_t>(slice_ns / byte_ns));
+
+  size_t written = 0;
+  while (written < total)
+  {
+    // 各条目直接作为数据段（不拷贝），只取本分片 [written, written + want) 覆盖的部分
+    const size_t want = std::min(slice, total - written);
+    iov.clear();
+    size_t offset = 0;
+    for (const auto& item : batch)
+    {
+      const size_t size = item.data.size();
+      const size_t begin = std::max(offset, written);
+      const size_t end = std::min(offset + size, written + want);
+      if (begin < end) iov.push_back(serial::IoVec{item.data.data() + (begin - offset), end - begin});
+      offset += size;
+      if (offset >= written + want) break;
+    }
+    const size_t n = writeGather(iov, written == 0);
+    written += n;
+    if (n < want || written == total) break;
+
+    // 等到内核发送缓冲中只剩约 1/4 个分片再写下一片，使紧急条目前面最多排着约一个分片；
+    // 等待期间到达的紧急条目立即写出
+    while (tx_queue_->waitUrgent(tx_line_free_ns_ - slice_ns / 4 - RxTimestamp::monoNow()))
+    {
+      writeUrgent(urgent, iov);
+    }
+  }
+  completeItems(batch, written);
+}
+
+/// @brief 写出紧急通道中的全部条目
+void SerialPort::writeUrgent(std::vector<TxQueue::Item>& urgent, std::vector<serial::IoVec>& iov)
+{
+  for (;;)
+  {
+    // 节拍模式下逐条写出（每条一帧），否则一次取完
+    TxQueue::Item item;
+    while ((urgent.empty() || !pacer_) && tx_queue_->pop(item, TxQueue::Priority::Urgent))
+    {
+      urgent.push_back(std::move(item));
+    }
+    if (urgent.empty()) return;
+
+    iov.clear();
+    for (const auto& u : urgent) iov.push_back(serial::IoVec{u.data.data(), u.data.size()});
+    const size_t written = writeGather(iov, true);
+
+    // 时延只统计整条写出的条目
+    const int64_t now = RxTimestamp::monoNow();
+    size_t offset = 0;
+    for (const auto& u : urgent)
+    {
+      offset += u.data.size();
+      if (offset <= written) tx_queue_->noteUrgentLatency(now - u.enqueue_ns);
+    }
+    completeItems(urgent, written);
+    urgent.clear();
+  }
+}
+
+/// @brief 执行一次聚集写，启用节拍时按令牌桶分块
+size_t SerialPort::writeGather(const std::vector<serial::IoVec>& iov, bool frame_start)
+{
+  if (!pacer_) return writeLocked(iov.data(), iov.size());
+
+  size_t total = 0;
+  for (const auto& v : iov) total += v.size;
+
+  // 每块不超过桶容量，在锁外等待到预约的时刻，再持锁写出这一块
+  size_t written = 0;
+  while (written < total)
+  {
+    const size_t want = std::min(pacer_->chunkBytes(), total - written);
+    pace_iov_.clear();
+    size_t offset = 0;
+    for (const auto& v : iov)
+    {
+      const size_t begin = std::max(offset, written);
+      const size_t end = std::min(offset + v.size, written + want);
+      if (begin < end)
+      {
+        pace_iov_.push_back(serial::IoVec{static_cast<const char*>(v.data) + (begin - offset), end - begin});
+      }
+      offset += v.size;
+      if (offset >= written + want) break;
+    }
+    pacer_->waitUntil(pacer_->reserve(want, frame_start && written == 0));
+    const size_t n = writeLocked(pace_iov_.data(), pace_iov_.size());
+    written += n;
+    if (n < want) break;
+  }
+  return written;
+}
+
+/// @brief 持锁执行一次聚集写
+size_t SerialPort::writeLocked(const serial::IoVec* buffers, size_t count)
+{
+  size_t written = 0;
+  uint32_t byte_ns = 0;
+  {
+    std::lock_guard<std::mutex> lock(tx_mtx_);
+    try
+    {
+      if (!serial_.isOpen()) throw serial::PortNotOpenedException("SerialPort::writeAsync");
+      written = serial_.write(buffers, count);
+      byte_ns = serial_.getByteTimeNs();
+      tx_queue_->noteWrite(written);
+    }
+    catch (const std::exception& e)
+    {
+      logMsg(LogLevel::Error, std::string("async write exception: ") + e.what());
+    }
+  }
+  // 估算内核发送缓冲排空的时刻：写入的字节排在尚未发完的数据之后
+  const int64_t now = RxTimestamp::monoNow();
+  tx_line_free_ns_ = std::max(tx_line_free_ns_, now) + static_cast<int64_t>(written) * byte_ns;
+  return written;
+}
+
+/// @brief 按写出字节数完成一组条目
+void SerialPort::completeItems(std::vector<TxQueue::Item>& items, size_t written)
+{
+  // 按提交顺序把写出的字节数分配给各条目：只有整条写出的才算成功
+  size_t offset = 0;
+  size_t total = 0;
+  size_t failed = 0;
+  for (const auto& item : items)
+  {
+    const size_t size = item.data.size();
+    if (offset + size > written) ++failed;
+    offset += size;
+    total += size;
+  }
+  tx_queue_->finish(items.size(), total, failed);
+
+  offset = 0;
+  for (auto& item : items)
+  {
+    const size_t size = item.data.size();
+    const size_t covered = written > offset ? std::min(size, written - offset) : 0;
+    offset += size;
+    if (item.done) item.done(covered == size, covered);
+  }
+}
+
+/// @brief 关闭接收队列并等待交付线程退出
+void SerialPort::stopQueue()
+{
+  if (queue_) queue_->close();
+  if (queue_thread_.joinable())
+  {
+    queue_thread_.join();
+  }
+}
+
+/// @brief 接收队列交付线程主循环
+void SerialPort::queueConsumerLoop()
+{
+  RxBlock block;
+  while (true)
+  {
+    if (queue_->pop(block, coalesceWaitUs()))
+    {
+      const RxTimestamp stamp = block.timestamp();
+      dwell_hist_.record(RxTimestamp::monoNow() - stamp.mono_ns);
+      dispatch(block.data(), block.size(), stamp);
+      block.reset();  // 尽快把数据块还给池
+      continue;
+    }
+    if (queue_->closed()) break;  // 已关闭且取完
+    pollCoalesced();
+  }
+  flushCoalesced();
+}
+
+/// @brief 数据块入队
+void SerialPort::enqueue(RxBlock&& block)
+{
+  // 只有 Block 策略会等待超时并保留数据块；分段等待以便 stop() 之后及时退出
+  while (!queue_->push(std::move(block), 100))
+  {
+    if (!block) return;  // 已按策略丢弃
+    if (!running_)
+    {
+      queue_->discard(std::move(block));
+      return;
+    }
+  }
+}
+
+/// @brief 等待环形缓冲中有数据
+bool SerialPort::waitRing(int64_t wait_us)
+{
+  if (!ring_->empty()) return true;
+
+  std::unique_lock<std::mutex> lock(ring_mtx_);
+  ring_waiting_.store(true);
+  // 与 notifyRing() 中的栅栏配对：要么生产者看到等待标志，要么消费者看到新数据，不会丢失唤醒
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  auto ready = [this] { return !ring_->empty() || !ring_running_; };
+  if (wait_us < 0)
+  {
+    ring_cv_.wait(lock, ready);
+  }
+  else
+  {
+    ring_cv_.wait_for(lock, std::chrono::microseconds(wait_us), ready);
+  }
+  ring_waiting_.store(false);
+  return !ring_->empty();
+}
+
+/// @brief 生产者写入后唤醒等待中的消费者
+void SerialPort::notifyRing()
+{
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (ring_waiting_.load(std::memory_order_relaxed))
+  {
+    std::lock_guard<std::mutex> lock(ring_mtx_);
+    ring_cv_.notify_all();
+  }
+}
+
+/// @brief 内部读线程主循环
+void SerialPort::readLoop()
+{
+  std::vector<uint8_t> buffer(1024 * 64);  // 64KB 缓冲区
+  applyThreadProfile(buffer);
+#if !defined(_WIN32)
+  if (eventDriven())
+  {
+    eventReadLoop(buffer);
+  }
+  else
+#endif
+  {
+    pollingReadLoop(buffer);
+  }
+  if (readerDelivers()) flushCoalesced();
+}
+
+/// @brief 在读线程中应用线程配置
+void SerialPort::applyThreadProfile(std::vector<uint8_t>& buffer)
+{
+  const ThreadProfile& profile = thread_profile_;
+#if !defined(_WIN32)
+  if (profile.lock_memory && ::mlockall(MCL_CURRENT | MCL_FUTURE) != 0)
+  {
+    logMsg(LogLevel::Warning, std::string("mlockall failed: ") + std::strerror(errno));
+  }
+
+  if (profile.prefault)
+  {
+    // 先锁定再触碰：锁定后新触碰的页直接常驻
+    std::memset(buffer.data(), 0, buffer.size());
+    if (pool_) pool_->prefault();
+    // 预先触碰读线程栈，避免运行中首次深层调用时缺页
+    volatile uint8_t stack[64 * 1024];
+    for (size_t i = 0; i < sizeof(stack); i += 4096) stack[i] = 0;
+  }
+
+  if (!profile.cpus.empty())
+  {
+#if defined(__linux__)
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (int cpu : profile.cpus)
+    {
+      if (cpu >= 0 && cpu < CPU_SETSIZE) CPU_SET(cpu, &set);
+    }
+    int err = ::pthread_setaffinity_np(::pthread_self(), sizeof(set), &set);
+    if (err != 0) logMsg(LogLevel::Warning, std::string("set CPU affinity failed: ") + std::strerror(err));
+#else
+    logMsg(LogLevel::Warning, "CPU affinity is not supported on this platform");
+#endif
+  }
+
+  if (profile.policy != SchedPolicy::Default)
+  {
+    struct sched_param param;
+    std::memset(&param, 0, sizeof(param));
+    param.sched_priority = profile.priority;
+    const int policy = (profile.policy == SchedPolicy::Fifo) ? SCHED_FIFO : SCHED_RR;
+    int err = ::pthread_setschedparam(::pthread_self(), policy, &param);
+    if (err != 0) logMsg(LogLevel::Warning, std::string("set realtime scheduling failed: ") + std::strerror(err));
+  }
+#else
+  (void)buffer;
+  if (!profile.cpus.empty() || profile.policy != SchedPolicy::Default || profile.lock_memory || profile.prefault)
+  {
+    logMsg(LogLevel::Warning, "thread profile is not supported on this platform");
+  }
+#endif
+}
+
+/// @brief 轮询模式读取循环
+void SerialPort::pollingReadLoop(std::vector<uint8_t>& buffer)
+{
+  while (running_)
+  {
+    try
+    {
+      if (!serial_.isOpen())
+      {
+        readerLinkLost();
+        continue;
+      }
+
+      // 读取最多 buffer.size()（或数据块容量）字节并交付
+      size_t n = readChunk(buffer);
+      if (n == 0)
+      {
+        // 没有数据，短暂 sleep 避免 CPU 占满
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+      }
+      if (readerDelivers()) pollCoalesced();
+    }
+    catch (const std::exception& e)
+    {
+      logMsg(LogLevel::Warning, std::string("read exception: ") + e.what());
+      readerLinkLost();
+    }
+  }
+}
+
+#if !defined(_WIN32)
+/// @brief 获取串口文件描述符
+int SerialPort::nativeHandle() const
+{
+  return serial_.getNativeHandle();
+}
+
+/// @brief 需要关注的 poll 事件位
+short SerialPort::pollEvents() const
+{
+  return POLLIN;
+}
+
+/// @brief 事件循环最多等待的微秒数
+int64_t SerialPort::nextTimeoutUs() const
+{
+  return readerDelivers() ? coalesceWaitUs() : -1;
+}
+
+/// @brief fd 可读或报告错误时调用
+size_t SerialPort::onReadable()
+{
+  return drainExternal(true);
+}
+
+/// @brief 非阻塞读取并交付到期的合并数据
+size_t SerialPort::pump()
+{
+  return drainExternal(false);
+}
+
+/// @brief 外部事件循环模式下非阻塞读取并交付
+size_t SerialPort::drainExternal(bool readable)
+{
+  if (!external_ || !running_) return 0;
+
+  size_t total = 0;
+  try
+  {
+    // 读超时为 0：只取走已到达的数据；读满一整块时 serial 库的预读缓冲中可能还有数据，继续读
+    const size_t chunk = pool_ ? pool_->blockSize() : pump_buffer_.size();
+    size_t n = readChunk(pump_buffer_);
+    total = n;
+    while (n >= chunk && running_)
+    {
+      n = readChunk(pump_buffer_);
+      total += n;
+    }
+    if (readable && total == 0 && running_)
+    {
+      throw serial::SerialException("device reports readiness to read but returned no data (device disconnected?)");
+    }
+    if (readerDelivers()) pollCoalesced();
+  }
+  catch (const std::exception& e)
+  {
+    logMsg(LogLevel::Warning, std::string("read exception: ") + e.what());
+    // 用户应从循环中移除 fd：重连成功后在状态回调中注册新的 fd，放弃重连后由用户重新 open()
+    running_ = false;
+    linkLost();
+  }
+  return total;
+}
+#endif
+
+/// @brief 把串口 fd 注册到反应器
+bool SerialPort::attachReactor()
+{
+#if defined(__linux__)
+  {
+    // 持锁登记注册号：注册后事件可能立刻在反应器线程中处理，处理函数持同一把锁读取注册号
+    std::lock_guard<std::mutex> lock(reactor_mtx_);
+    timer_deadline_ns_ = -1;
+    reactor_id_ = reactor_->attach(serial_.getNativeHandle(), [this](uint32_t events, std::vector<uint8_t>& buffer) {
+      return onReactorReadable(events, buffer);
+    });
+    if (reactor_id_ != 0) return true;
+  }
+#endif
+  logMsg(LogLevel::Warning, "reactor unavailable, fall back to dedicated reader thread");
+  return false;
+}
+
+/// @brief 从反应器注销
+void SerialPort::detachReactor()
+{
+#if defined(__linux__)
+  // 注册号在处理函数中持 reactor_mtx_ 读写，这里也持锁取出；但不能持锁注销，
+  // 否则注销会等待正阻塞在这把锁上的处理函数。处理函数已注销自身时，反应器保留其注册直到处理函数返回
+  uint64_t fd_id;
+  {
+    std::lock_guard<std::mutex> lock(reactor_mtx_);
+    fd_id = reactor_id_;
+  }
+  if (fd_id == 0) return;
+  // 先注销串口 fd：返回后不会再有读事件处理，定时器也不会再被创建
+  reactor_->detach(fd_id);
+  uint64_t timer_id;
+  {
+    std::lock_guard<std::mutex> lock(reactor_mtx_);
+    timer_id = timer_id_;
+    reactor_id_ = timer_id_ = 0;
+  }
+  reactor_->detach(timer_id);
+  if (timer_fd_ >= 0)
+  {
+    ::close(timer_fd_);
+    timer_fd_ = -1;
+  }
+  if (readerDelivers()) flushCoalesced();
+#endif
+}
+
+/// @brief 反应器线程中处理串口 fd 事件
+bool SerialPort::onReactorReadable(uint32_t events, std::vector<uint8_t>& buffer)
+{
+#if defined(__linux__)
+  std::lock_guard<std::mutex> lock(reactor_mtx_);
+  if (!running_) return false;
+  try
+  {
+    if (!(events & EPOLLIN)) throw serial::SerialException("epoll reports device error (device disconnected?)");
+
+    // 与事件驱动模式相同：读超时为 0，读满一整块时继续读，直到 serial 库的预读缓冲取空
+    size_t n = readChunk(buffer);
+    if (n == 0)
+    {
+      if (!running_) return false;
+      throw serial::SerialException("device reports readiness to read but returned no data (device disconnected?)");
+    }
+    const size_t chunk = pool_ ? pool_->blockSize() : buffer.size();
+    while (n >= chunk && running_) n = readChunk(buffer);
+    if (readerDelivers()) armCoalesceTimer();
+    return true;
+  }
+  catch (const std::exception& e)
+  {
+    logMsg(LogLevel::Warning, std::string("read exception: ") + e.what());
+  }
+
+  // 不在共享线程中阻塞重连：先注销再交给重连线程关闭，避免 fd 号被复用后误删其他串口的注册
+  reactor_->detach(reactor_id_);
+  linkLost();
+#else
+  (void)events;
+  (void)buffer;
+#endif
+  return false;
+}
+
+/// @brief 反应器线程中处理合并定时器到期
+bool SerialPort::onReactorTimer()
+{
+#if defined(__linux__)
+  std::lock_guard<std::mutex> lock(reactor_mtx_);
+  uint64_t expirations = 0;
+  ssize_t r = ::read(timer_fd_, &expirations, sizeof(expirations));
+  (void)r;
+  timer_deadline_ns_ = -1;
+  pollCoalesced();
+  armCoalesceTimer();  // 定时器可能早于当前截止时间到期（期间已按大小交付并重新开始暂存）
+#endif
+  return true;
+}
+
+/// @brief 按合并缓冲的截止时间设置定时器
+void SerialPort::armCoalesceTimer()
+{
+#if defined(__linux__)
+  const int64_t deadline = coalescer_.deadlineNs();
+  if (deadline < 0 || deadline == timer_deadline_ns_) return;
+
+  if (timer_fd_ < 0)
+  {
+    timer_fd_ = ::timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+    if (timer_fd_ < 0)
+    {
+      logMsg(LogLevel::Warning, std::string("timerfd_create failed: ") + std::strerror(errno));
+      return;
+    }
+    timer_id_ = reactor_->attach(timer_fd_, [this](uint32_t, std::vector<uint8_t>&) { return onReactorTimer(); });
+  }
+
+  // steady_clock 即 CLOCK_MONOTONIC，截止时间可直接作为绝对到期时间
+  struct itimerspec spec;
+  std::memset(&spec, 0, sizeof(spec));
+  spec.it_value.tv_sec = static_cast<time_t>(deadline / 1000000000);
+  spec.it_value.tv_nsec = static_cast<long>(deadline % 1000000000);
+  if (::timerfd_settime(timer_fd_, TFD_TIMER_ABSTIME, &spec, nullptr) == 0) timer_deadline_ns_ = deadline;
+#endif
+}
+
+#if !defined(_WIN32)
+/// @brief 事件驱动模式读取循环
+void SerialPort::eventReadLoop(std::vector<uint8_t>& buffer)
+{
+  while (running_)
+  {
+    try
+    {
+      if (!serial_.isOpen())
       {
-        running_ = true;
-        if (!reader_thread_.joinable()) reader_thread_ = std::thread(&SerialPort::readLoop, this);
-        logMsg(LogLevel::Info, "SerialPort reconnected");
-        return;
+        readerLinkLost();
+        continue;
+      }
+
+      struct pollfd fds[2];
+      fds[0].fd = serial_.getNativeHandle();
+      fds[0].events = POLLIN;
+      fds[0].revents = 0;
+      fds[1].fd = wakeup_fds_[0];
+      fds[1].events = POLLIN;
+      fds[1].revents = 0;
+
+      // 无限期阻塞：只有数据到达、设备异常或 stop() 唤醒时才返回，空闲时没有任何定时唤醒；
+      // 仅当合并缓冲中有待交付数据时按其截止时间限时等待
+      const int64_t wait_us = readerDelivers() ? coalesceWaitUs() : -1;
+#if defined(__linux__)
+      struct timespec ts;
+      ts.tv_sec = static_cast<time_t>(wait_us / 1000000);
+      ts.tv_nsec = static_cast<long>(wait_us % 1000000) * 1000;
+      int r = ::ppoll(fds, 2, wait_us < 0 ? nullptr : &ts, nullptr);
+#else
+      int r = ::poll(fds, 2, wait_us < 0 ? -1 : static_cast<int>((wait_us + 999) / 1000));
+#endif
+      if (r < 0)
+      {
+        if (errno == EINTR) continue;
+        throw serial::IOException(__FILE__, __LINE__, errno);
+      }
+      if (r == 0)
+      {
+        pollCoalesced();  // 合并缓冲截止时间已到
+        continue;
+      }
+
+      if (fds[1].revents & POLLIN)
+      {
+        char sink[64];
+        while (::read(wakeup_fds_[0], sink, sizeof(sink)) > 0)
+        {
+        }
+        continue;  // 回到循环头检查 running_
+      }
+
+      if (fds[0].revents & POLLIN)
+      {
+        // 读超时为 0：只取走内核中已到达的数据，不会再等待
+        size_t n = readChunk(buffer);
+        if (n == 0)
+        {
+          if (!running_) break;  // 等待空闲数据块期间被停止
+          throw serial::SerialException("device reports readiness to read but returned no data (device disconnected?)");
+        }
+        // 读满一整块时 serial 库的预读缓冲中可能还留有数据，poll 不会再报告，继续读到不满一块为止
+        const size_t chunk = pool_ ? pool_->blockSize() : buffer.size();
+        while (n >= chunk && running_) n = readChunk(buffer);
+      }
+      else if (fds[0].revents & (POLLERR | POLLHUP | POLLNVAL))
+      {
+        throw serial::SerialException("poll reports device error (device disconnected?)");
       }
     }
-    catch (...)
+    catch (const std::exception& e)
     {
-      logMsg(LogLevel::Warning, "Reconnect attempt " + std::to_string(attempt) + " failed");
+      logMsg(LogLevel::Warning, std::string("read exception: ") + e.what());
+      readerLinkLost();
     }
   }
+}
+
+/// @brief 创建非阻塞唤醒管道
+bool SerialPort::openWakeup()
+{
+  if (wakeup_fds_[0] != -1) return true;
+  if (::pipe(wakeup_fds_) != 0)
+  {
+    wakeup_fds_[0] = wakeup_fds_[1] = -1;
+    return false;
+  }
+  for (int fd : wakeup_fds_)
+  {
+    ::fcntl(fd, F_SETFL, ::fcntl(fd, F_GETFL) | O_NONBLOCK);
+    ::fcntl(fd, F_SETFD, FD_CLOEXEC);
+  }
+  return true;
+}
+
+/// @brief 关闭唤醒管道
+void SerialPort::closeWakeup()
+{
+  for (int& fd : wakeup_fds_)
+  {
+    if (fd != -1) ::close(fd);
+    fd = -1;
+  }
+}
+
+/// @brief 唤醒阻塞在 poll 上的读线程
+void SerialPort::wakeup()
+{
+  if (wakeup_fds_[1] == -1) return;
+  const char c = 1;
+  ssize_t r = ::write(wakeup_fds_[1], &c, 1);  // 管道已满时 EAGAIN 亦可，读线程必然会被唤醒
+  (void)r;
+}
+#endif
+
+/// @brief 读取一次数据并交付
+size_t SerialPort::readChunk(std::vector<uint8_t>& buffer)
+{
+  if (!pool_)
+  {
+    size_t n = serial_.read(buffer.data(), buffer.size());
+    if (n > 0) deliver(buffer.data(), n, stampChunk());
+    return n;
+  }
+
+  RxBlock block;
+  if (pool_->policy() == RxBlockPool::Exhaustion::Block)
+  {
+    // 分段等待，以便 stop() 之后及时退出
+    while (running_ && !block) block = pool_->acquire(100);
+    if (!block) return 0;
+  }
+  else
+  {
+    block = pool_->acquire();
+  }
+
+  if (!block)
+  {
+    // Drop 策略：照常取走数据以免驱动缓冲溢出，但不交付
+    size_t n = serial_.read(buffer.data(), buffer.size());
+    pool_->noteDropped(n);
+    return n;
+  }
+
+  size_t n = serial_.read(block.mutableData(), block.capacity());
+  if (n > 0)
+  {
+    const RxTimestamp stamp = stampChunk();
+    block.setSize(n);
+    block.setTimestamp(stamp);
+    if (block_cb_) block_cb_(block);
+    if (queue_)
+    {
+      enqueue(std::move(block));
+    }
+    else
+    {
+      deliver(block.data(), n, stamp);
+    }
+  }
+  return n;
+}
+
+/// @brief 为数据块打时间戳
+RxTimestamp SerialPort::stampChunk()
+{
+  RxTimestamp stamp;
+  stamp.mono_ns = RxTimestamp::monoNow();
+  if (realtime_stamps_) stamp.real_ns = RxTimestamp::realNow();
+  if (last_chunk_ns_ != 0) gap_hist_.record(stamp.mono_ns - last_chunk_ns_);
+  last_chunk_ns_ = stamp.mono_ns;
+  return stamp;
+}
+
+/// @brief 交付接收数据
+void SerialPort::deliver(const uint8_t* data, size_t size, const RxTimestamp& stamp)
+{
+  if (ring_)
+  {
+    // 读线程只负责入环，回调由消费者执行
+    ring_->push(data, size);
+    notifyRing();
+    return;
+  }
+  dispatch(data, size, stamp);
+}
+
+/// @brief 调用数据回调并送入帧解码器
+void SerialPort::dispatch(const uint8_t* data, size_t size, const RxTimestamp& stamp)
+{
+  if (data_cb_)
+  {
+    if (coalescer_.enabled())
+    {
+      coalescer_.feed(data, size, stamp, CallbackCoalescer::nowNs(), coalesce_cb_);
+    }
+    else
+    {
+      callDataCallback(data, size, stamp);
+    }
+  }
+  if (decoder_)
+  {
+    decoder_->feed(data, size, [this, &stamp](const uint8_t* frame, size_t frame_size) {
+      if (!frame_cb_) return;
+      DataView view;
+      view.data = frame;
+      view.size = frame_size;
+      view.stamp = stamp;  // 帧以完成它的数据块的到达时间为准
+      const int64_t start = RxTimestamp::monoNow();
+      frame_cb_(view);
+      callback_hist_.record(RxTimestamp::monoNow() - start);
+    });
+  }
+}
+
+/// @brief 调用数据回调
+void SerialPort::callDataCallback(const uint8_t* data, size_t size, const RxTimestamp& stamp)
+{
+  DataView view;
+  view.data = data;
+  view.size = size;
+  view.stamp = stamp;
+  const int64_t start = RxTimestamp::monoNow();
+  data_cb_(view);
+  callback_hist_.record(RxTimestamp::monoNow() - start);
+}
 
+/// @brief 计算交付线程空闲时的最长等待时间
+int64_t SerialPort::coalesceWaitUs() const
+{
+  const int64_t deadline = coalescer_.deadlineNs();
+  if (deadline < 0) return -1;
+  const int64_t remaining = deadline - CallbackCoalescer::nowNs();
+  return remaining > 0 ? (remaining + 999) / 1000 : 0;
+}
+
+/// @brief 合并缓冲截止时间已到时交付
+void SerialPort::pollCoalesced()
+{
+  if (data_cb_) coalescer_.poll(CallbackCoalescer::nowNs(), coalesce_cb_);
+}
+
+/// @brief 交付合并缓冲中的剩余数据
+void SerialPort::flushCoalesced()
+{
+  if (data_cb_) coalescer_.flush(CallbackCoalescer::nowNs(), coalesce_cb_);
+}
+
+/// @brief 是否由 poll/epoll 等待数据
+bool SerialPort::eventDriven() const
+{
+  return read_mode_ == ReadMode::Event || reactor_;
+}
+
+/// @brief 读线程是否直接执行回调
+bool SerialPort::readerDelivers() const
+{
+  return !ring_ && !queue_;
+}
+
+/// @brief 按读取模式生成超时配置
+serial::Timeout SerialPort::makeTimeout() const
+{
+#if !defined(_WIN32)
+  // 事件驱动模式由 poll 负责等待，serial 库只取走已到达的数据；写超时保持不变
+  if (eventDriven() || read_mode_ == ReadMode::External) return serial::Timeout(serial::Timeout::max(), 0, 0, timeout_ms_, 0);
+#endif
+  return serial::Timeout::simpleTimeout(timeout_ms_);
+}
+
+/// @brief 读路径检测到断开
+void SerialPort::linkLost()
+{
+  disconnects_.fetch_add(1, std::memory_order_relaxed);
+  if (reconnect_max_ == 0)
+  {
+    // 不重连：关闭串口，需要时由用户重新 open()
+    if (!transition(LinkState::Open, LinkState::Closed)) return;
+    logMsg(LogLevel::Error, "disconnected, port closed");
+    std::lock_guard<std::mutex> lock(tx_mtx_);  // 等正在进行的写出结束后再关闭
+    if (serial_.isOpen()) serial_.close();
+    return;
+  }
+  lost_ns_.store(RxTimestamp::monoNow(), std::memory_order_relaxed);
+  if (transition(LinkState::Open, LinkState::Reconnecting)) logMsg(LogLevel::Warning, "disconnected, try reconnect");
+}
+
+/// @brief 读线程检测到断开
+void SerialPort::readerLinkLost()
+{
+  linkLost();
+  // 读线程在重连期间不访问串口；close() 开始或放弃重连时结束读循环
+  if (!waitLinkUp()) running_ = false;
+}
+
+/// @brief 启动重连线程
+void SerialPort::startReconnector()
+{
+  if (reconnect_max_ == 0 || reconnect_thread_.joinable()) return;
+  {
+    std::lock_guard<std::mutex> lock(state_mtx_);
+    reconnect_quit_ = false;
+  }
+  reconnect_thread_ = std::thread(&SerialPort::reconnectLoop, this);
+}
+
+/// @brief 停止重连线程
+void SerialPort::stopReconnector()
+{
+  {
+    std::lock_guard<std::mutex> lock(state_mtx_);
+    reconnect_quit_ = true;
+  }
+  state_cv_.notify_all();
+  if (reconnect_thread_.joinable())
+  {
+    reconnect_thread_.join();
+  }
+}
+
+/// @brief 重连线程主循环
+void SerialPort::reconnectLoop()
+{
+  std::unique_lock<std::mutex> lock(state_mtx_);
+  while (true)
+  {
+    state_cv_.wait(lock, [this] {
+      return reconnect_quit_ || state_.load(std::memory_order_relaxed) == LinkState::Reconnecting;
+    });
+    if (reconnect_quit_) return;
+    lock.unlock();
+    recover();
+    lock.lock();
+  }
+}
+
+/// @brief 按退避策略重新打开串口
+void SerialPort::recover()
+{
+  {
+    std::lock_guard<std::mutex> lock(tx_mtx_);  // 等正在进行的写出结束后再关闭
+    if (serial_.isOpen()) serial_.close();
+  }
+
+  size_t step = 1;
+  for (size_t attempt = 1; attempt <= reconnect_max_; ++attempt)
+  {
+    // 等待期间不持有任何锁，写路径快速失败或在队列中等待；close() 会打断等待，设备节点重新出现时立即重试
+    bool appeared = false;
+    if (!backoff(backoffDelayMs(step), LinkState::Reconnecting, &appeared)) return;
+    step = appeared ? 1 : step + 1;  // 节点刚出现时设备可能尚未就绪，之后从最短间隔重新退避
+    reconnect_attempts_.fetch_add(1, std::memory_order_relaxed);
+    try
+    {
+      {
+        std::lock_guard<std::mutex> lock(tx_mtx_);
+        resolveDevice();
+        serial_.open();
+        if (serial_.isOpen()) tuneLatency();  // 重新插入后 latency_timer 恢复为默认值，需要重新设置
+      }
+      if (serial_.isOpen())
+      {
+        if (resumeLink()) logMsg(LogLevel::Info, "SerialPort reconnected");
+        return;  // 失败时 close() 已经开始，串口交给 close() 关闭
+      }
+    }
+    catch (const std::exception& e)
+    {
+      logMsg(LogLevel::Warning, "Reconnect attempt " + std::to_string(attempt) + " failed: " + e.what());
+    }
+  }
+
+  // 放弃重连：串口保持关闭，读线程随之退出，需要时由用户重新 open()
   logMsg(LogLevel::Error, "reconnect failed after retries");
+  give_ups_.fetch_add(1, std::memory_order_relaxed);
+  transition(LinkState::Reconnecting, LinkState::Closed);
+}
+
+/// @brief 重连成功后恢复读路径
+bool SerialPort::resumeLink()
+{
+  // 读线程此时在等待状态变化，反应器与外部事件循环也已不再读取，可以安全地重置解码器
+  if (decoder_) decoder_->reset();  // 丢弃断开前遗留的半帧
+  last_chunk_ns_ = 0;
+  if (reactor_ && !attachReactor()) return false;
+  if (external_) running_ = true;
+
+  const int64_t lost_ns = lost_ns_.load(std::memory_order_relaxed);
+  if (!transition(LinkState::Reconnecting, LinkState::Open)) return false;
+  const int64_t elapsed = RxTimestamp::monoNow() - lost_ns;
+  last_recovery_ns_.store(elapsed, std::memory_order_relaxed);
+  recovery_hist_.record(elapsed);
+  recoveries_.fetch_add(1, std::memory_order_relaxed);
+  return true;
+}
+
+/// @brief 第 attempt 次重试前的等待时间
+uint32_t SerialPort::backoffDelayMs(size_t attempt) const
+{
+  const ReconnectPolicy& policy = reconnect_policy_;
+  const double growth = std::pow(std::max(policy.multiplier, 1.0), static_cast<double>(attempt - 1));
+  double delay = static_cast<double>(policy.initial_delay_ms) * growth;
+  delay = std::min(delay, static_cast<double>(policy.max_delay_ms));
+  const double jitter = std::min(std::max(policy.jitter, 0.0), 1.0);
+  if (jitter > 0.0)
+  {
+    static thread_local std::minstd_rand rng(static_cast<uint32_t>(RxTimestamp::monoNow()));
+    delay *= std::uniform_real_distribution<double>(1.0 - jitter, 1.0 + jitter)(rng);
+  }
+  return static_cast<uint32_t>(delay + 0.5);
+}
+
+/// @brief 设备节点当前是否存在
+bool SerialPort::deviceNodePresent() const
+{
+  PortMetadata meta;
+  if (identity_.valid()) return enumerator_->find(identity_, meta);
+#if !defined(_WIN32)
+  return ::access(port_.c_str(), F_OK) == 0;
+#else
+  return true;
+#endif
+}
+
+/// @brief 监视线程中处理设备节点事件
+void SerialPort::onHotplug(const DeviceWatcher::Event& event)
+{
+  if (!event.added) return;  // 断开由读路径检测，读出错比 uevent 更早
+  const LinkState state = state_.load(std::memory_order_acquire);
+  if (state != LinkState::Opening && state != LinkState::Reconnecting) return;
+
+  PortMetadata meta;
+  if (identity_.valid() ? !(enumerator_->metadata(event.devnode, meta) && identity_.matches(meta.identity()))
+                        : event.devnode != port_)
+  {
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(state_mtx_);
+    if (identity_.valid()) hotplug_node_ = event.devnode;
+    ++hotplug_seq_;
+  }
+  state_cv_.notify_all();
+}
+
+/// @brief 绑定身份时确定要打开的设备节点
+void SerialPort::resolveDevice()
+{
+  if (!identity_.valid()) return;  // 未绑定身份：port_ 即设备节点
+
+  // 优先使用监视器刚报告的节点，否则查枚举器的索引
+  std::string node;
+  {
+    std::lock_guard<std::mutex> lock(state_mtx_);
+    node.swap(hotplug_node_);
+  }
+  PortMetadata meta;
+  if (node.empty() && enumerator_->find(identity_, meta)) node = meta.port;
+  if (node.empty()) node = port_;
+  if (node != serial_.getPort())
+  {
+    logMsg(LogLevel::Info, "device identity resolved to " + node);
+    serial_.setPort(node);
+  }
+}
+
+/// @brief 无条件切换连接状态
+void SerialPort::setState(LinkState state)
+{
+  LinkState from;
+  {
+    std::lock_guard<std::mutex> lock(state_mtx_);
+    from = state_.exchange(state, std::memory_order_acq_rel);
+  }
+  state_cv_.notify_all();
+  if (state_cb_ && from != state) state_cb_(from, state);
+}
+
+/// @brief 仅当当前状态为 from 时切换到 to
+bool SerialPort::transition(LinkState from, LinkState to)
+{
+  {
+    std::lock_guard<std::mutex> lock(state_mtx_);
+    if (state_.load(std::memory_order_relaxed) != from) return false;
+    state_.store(to, std::memory_order_release);
+  }
+  state_cv_.notify_all();
+  if (state_cb_) state_cb_(from, to);
+  return true;
+}
+
+/// @brief 重试间隔等待
+bool SerialPort::backoff(uint32_t delay_ms, LinkState expected, bool* appeared)
+{
+  if (appeared) *appeared = false;
+  const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(delay_ms);
+  const auto probe = std::chrono::milliseconds(reconnect_policy_.probe_interval_ms);
+  // 热插拔监视器在节点出现时唤醒等待；没有监视器时轮询节点，节点已存在（如出错但设备仍在）时只按间隔等待
+  const bool probing = watch_id_ == 0 && reconnect_policy_.probe_interval_ms != 0 && !deviceNodePresent();
+  auto left = [&] { return state_.load(std::memory_order_relaxed) != expected || hotplug_seq_ != hotplug_seen_; };
+
+  std::unique_lock<std::mutex> lock(state_mtx_);
+  while (state_.load(std::memory_order_relaxed) == expected)
+  {
+    if (hotplug_seq_ != hotplug_seen_)
+    {
+      hotplug_seen_ = hotplug_seq_;
+      if (appeared) *appeared = true;
+      break;
+    }
+    const auto now = std::chrono::steady_clock::now();
+    if (now >= deadline) break;
+    if (state_cv_.wait_until(lock, probing ? std::min(deadline, now + probe) : deadline, left)) continue;
+    if (!probing) continue;
+    lock.unlock();
+    const bool present = deviceNodePresent();
+    lock.lock();
+    if (present)
+    {
+      if (appeared) *appeared = true;
+      break;
+    }
+  }
+  return state_.load(std::memory_order_relaxed) == expected;
+}
+
+/// @brief 等待打开或重连结束
+bool SerialPort::waitLinkUp()
+{
+  std::unique_lock<std::mutex> lock(state_mtx_);
+  state_cv_.wait(lock, [this] {
+    const LinkState state = state_.load(std::memory_order_relaxed);
+    return state != LinkState::Opening && state != LinkState::Reconnecting;
+  });
+  return state_.load(std::memory_order_relaxed) == LinkState::Open;
 }
 
 /// @brief 内部日志输出
@@ -0,0 +1,94 @@
+/// 说明：无锁单生产者/单消费者字节环形缓冲区实现
+
+#include "serialport/spsc_ring.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace
+{
+/// @brief 向上取整为 2 的幂
+size_t roundUpPow2(size_t n)
+{
+  size_t v = 64;
+  while (v < n) v <<= 1;
+  return v;
+}
+}  // namespace
+
+SpscRing::SpscRing(size_t capacity) :
+  capacity_(roundUpPow2(capacity)), mask_(capacity_ - 1), storage_(new uint8_t[capacity_])
+{
+}
+
+/// @brief 写入数据（生产者）
+size_t SpscRing::push(const uint8_t* data, size_t size)
+{
+  const size_t head = head_.load(std::memory_order_relaxed);
+  size_t free_space = capacity_ - (head - cached_tail_);
+  if (free_space < size)
+  {
+    // 本地缓存的读索引已过期，重新获取一次
+    cached_tail_ = tail_.load(std::memory_order_acquire);
+    free_space = capacity_ - (head - cached_tail_);
+  }
+
+  const size_t n = std::min(size, free_space);
+  if (n > 0)
+  {
+    const size_t offset = head & mask_;
+    const size_t first = std::min(n, capacity_ - offset);
+    std::memcpy(storage_.get() + offset, data, first);
+    std::memcpy(storage_.get(), data + first, n - first);
+    head_.store(head + n, std::memory_order_release);
+    pushed_bytes_.fetch_add(n, std::memory_order_relaxed);
+  }
+
+  // 高水位需要真实占用量：缓存的读索引可能严重滞后，这里每个数据块额外读取一次读索引
+  const size_t used = head + n - tail_.load(std::memory_order_relaxed);
+  if (used > high_water_.load(std::memory_order_relaxed)) high_water_.store(used, std::memory_order_relaxed);
+
+  if (n < size)
+  {
+    overflow_bytes_.fetch_add(size - n, std::memory_order_relaxed);
+    overflow_events_.fetch_add(1, std::memory_order_relaxed);
+  }
+  return n;
+}
+
+/// @brief 读出数据（消费者）
+size_t SpscRing::pop(uint8_t* out, size_t size)
+{
+  return consume(
+    [&out](const uint8_t* data, size_t n) {
+      std::memcpy(out, data, n);
+      out += n;
+    },
+    size);
+}
+
+/// @brief 零拷贝批量消费（消费者）
+size_t SpscRing::consume(const ConsumeCallback& cb, size_t max_bytes)
+{
+  const size_t tail = tail_.load(std::memory_order_relaxed);
+  if (cached_head_ == tail) cached_head_ = head_.load(std::memory_order_acquire);
+
+  const size_t n = std::min(cached_head_ - tail, max_bytes);
+  if (n == 0) return 0;
+
+  const size_t offset = tail & mask_;
+  const size_t first = std::min(n, capacity_ - offset);
+  cb(storage_.get() + offset, first);
+  if (n > first) cb(storage_.get(), n - first);
+
+  tail_.store(tail + n, std::memory_order_release);
+  return n;
+}
+
+/// @brief 当前可读字节数
+size_t SpscRing::size() const
+{
+  const size_t tail = tail_.load(std::memory_order_acquire);
+  const size_t head = head_.load(std::memory_order_acquire);
+  return head - tail;
+}
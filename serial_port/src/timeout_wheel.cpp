@@ -0,0 +1,68 @@
+/// 说明：哈希时间轮实现
+
+#include "serialport/timeout_wheel.h"
+
+#include <stdexcept>
+
+TimeoutWheel::TimeoutWheel(int64_t tick_ns, size_t slots) : slots_(slots), tick_ns_(tick_ns)
+{
+  if (tick_ns_ <= 0 || slots == 0) throw std::invalid_argument("TimeoutWheel: tick and slot count must be > 0");
+}
+
+/// @brief 添加条目
+void TimeoutWheel::add(uint64_t id, int64_t deadline_ns)
+{
+  int64_t tick = deadline_ns / tick_ns_;
+  if (tick <= current_tick_) tick = current_tick_ + 1;  // 已经过去的槽位，放到下一个
+  slots_[static_cast<size_t>(tick) % slots_.size()].push_back(Entry{id, deadline_ns});
+  ++count_;
+}
+
+/// @brief 删除条目
+bool TimeoutWheel::cancel(uint64_t id, int64_t deadline_ns)
+{
+  // 与 add() 相同的槽位计算：仍未到期的条目不会早于下一个 tick，被提前的条目一定在 current_tick_ + 1
+  int64_t tick = deadline_ns / tick_ns_;
+  if (tick <= current_tick_) tick = current_tick_ + 1;
+  std::vector<Entry>& slot = slots_[static_cast<size_t>(tick) % slots_.size()];
+  for (size_t i = 0; i < slot.size(); ++i)
+  {
+    if (slot[i].id != id) continue;
+    slot[i] = slot.back();  // 槽位内无序，与末尾交换后删除
+    slot.pop_back();
+    --count_;
+    return true;
+  }
+  return false;
+}
+
+/// @brief 推进到当前时间
+void TimeoutWheel::advance(int64_t now_ns, std::vector<uint64_t>& expired)
+{
+  const int64_t now_tick = now_ns / tick_ns_;
+  if (now_tick <= current_tick_) return;
+
+  // 落后超过一圈（包括第一次推进）时每个槽位只需检查一次
+  const int64_t slot_count = static_cast<int64_t>(slots_.size());
+  const int64_t first = (now_tick - current_tick_ > slot_count) ? now_tick - slot_count + 1 : current_tick_ + 1;
+  for (int64_t tick = first; tick <= now_tick && count_ > 0; ++tick)
+  {
+    std::vector<Entry>& slot = slots_[static_cast<size_t>(tick) % slots_.size()];
+    size_t kept = 0;
+    for (size_t i = 0; i < slot.size(); ++i)
+    {
+      // 槽位对应的是本圈，deadline 更晚的条目属于以后的圈，原地保留
+      if (slot[i].deadline_ns / tick_ns_ <= now_tick)
+      {
+        expired.push_back(slot[i].id);
+        --count_;
+      }
+      else
+      {
+        slot[kept++] = slot[i];
+      }
+    }
+    slot.resize(kept);
+  }
+  current_tick_ = now_tick;
+}
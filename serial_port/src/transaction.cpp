@@ -0,0 +1,254 @@
+/// 说明：请求/应答关联引擎实现
+
+#include "serialport/transaction.h"
+
+#include <algorithm>
+#include <chrono>
+
+#include "serialport/rx_timestamp.h"
+
+TransactionEngine::TransactionEngine(SerialPort& port, KeyExtractor extractor, size_t depth, uint32_t tick_ms) :
+  port_(port),
+  extractor_(std::move(extractor)),
+  depth_(depth == 0 ? 1 : depth),
+  wheel_(static_cast<int64_t>(tick_ms == 0 ? 1 : tick_ms) * 1000000)
+{
+  port_.setFrameCallback([this](const SerialPort::DataView& frame) { onFrame(frame); });
+  timer_thread_ = std::thread(&TransactionEngine::timerLoop, this);
+}
+
+TransactionEngine::~TransactionEngine()
+{
+  {
+    std::lock_guard<std::mutex> lock(mtx_);
+    stopping_ = true;
+  }
+  cv_.notify_all();
+  if (timer_thread_.joinable()) timer_thread_.join();
+  cancelAll();
+  port_.setFrameCallback(nullptr);
+}
+
+/// @brief 提交请求，以 future 取得应答
+std::future<TransactionEngine::Response> TransactionEngine::submit(const Request& request)
+{
+  auto promise = std::make_shared<std::promise<Response>>();
+  std::future<Response> future = promise->get_future();
+  submit(request, [promise](const Response& response) { promise->set_value(response); });
+  return future;
+}
+
+/// @brief 提交请求，完成时调用回调
+void TransactionEngine::submit(const Request& request, Completion done)
+{
+  const int64_t now = RxTimestamp::monoNow();
+  uint64_t id = 0;
+  bool send_now = false;
+  {
+    std::lock_guard<std::mutex> lock(mtx_);
+    id = next_id_++;
+    Pending& pending = pending_[id];
+    pending.request = request;
+    pending.done = std::move(done);
+    pending.deadline_ns = now + static_cast<int64_t>(request.timeout_ms) * 1000000;
+    wheel_.add(id, pending.deadline_ns);
+    send_now = in_flight_ < depth_;
+    if (send_now)
+    {
+      ++in_flight_;
+    }
+    else
+    {
+      waiting_.push_back(id);
+    }
+  }
+  cv_.notify_one();  // 时间轮为空时定时线程在无限期等待
+  if (send_now) send(id);
+}
+
+/// @brief 设置未匹配帧回调
+void TransactionEngine::setUnsolicitedCallback(SerialPort::FrameCallback cb)
+{
+  unsolicited_cb_ = std::move(cb);
+}
+
+/// @brief 取消所有未完成的请求
+void TransactionEngine::cancelAll()
+{
+  std::vector<uint64_t> ids;
+  {
+    std::lock_guard<std::mutex> lock(mtx_);
+    // 先取消排队中的请求，在途请求完成时就不会再发送它们
+    ids.assign(waiting_.begin(), waiting_.end());
+    for (const auto& item : pending_)
+    {
+      if (item.second.sent_ns != 0) ids.push_back(item.first);
+    }
+  }
+  const int64_t now = RxTimestamp::monoNow();
+  for (uint64_t id : ids) complete(id, Status::Cancelled, std::string(), now);
+}
+
+/// @brief 当前在途请求数
+size_t TransactionEngine::inFlight() const
+{
+  std::lock_guard<std::mutex> lock(mtx_);
+  return in_flight_;
+}
+
+/// @brief 当前排队的请求数
+size_t TransactionEngine::queued() const
+{
+  std::lock_guard<std::mutex> lock(mtx_);
+  return waiting_.size();
+}
+
+/// @brief 按事务类型获取统计
+std::map<std::string, TransactionEngine::TypeStats> TransactionEngine::stats() const
+{
+  std::map<std::string, TypeStats> result;
+  std::lock_guard<std::mutex> lock(mtx_);
+  for (const auto& item : type_stats_)
+  {
+    TypeStats& stats = result[item.first];
+    stats.completed = item.second->completed;
+    stats.timeouts = item.second->timeouts;
+    stats.failures = item.second->failures;
+    stats.rtt = item.second->rtt.snapshot();
+  }
+  return result;
+}
+
+/// @brief 发送请求
+void TransactionEngine::send(uint64_t id)
+{
+  std::string payload;
+  {
+    std::lock_guard<std::mutex> lock(mtx_);
+    auto it = pending_.find(id);
+    if (it == pending_.end()) return;  // 排队期间已超时或被取消
+    // 先登记再写出：应答可能在 write() 返回之前就已到达
+    it->second.sent_ns = RxTimestamp::monoNow();
+    by_key_[it->second.request.key].push_back(id);
+    payload = it->second.request.payload;
+  }
+  if (port_.write(payload) != payload.size())
+  {
+    complete(id, Status::WriteFailed, std::string(), RxTimestamp::monoNow());
+  }
+}
+
+/// @brief 帧回调：匹配在途请求
+void TransactionEngine::onFrame(const SerialPort::DataView& frame)
+{
+  // 以数据块的接收时间计算往返时延，不含回调排队时间
+  const int64_t now = frame.stamp.mono_ns != 0 ? frame.stamp.mono_ns : RxTimestamp::monoNow();
+  std::string key;
+  uint64_t id = 0;
+  if (extractor_(frame, key))
+  {
+    std::lock_guard<std::mutex> lock(mtx_);
+    auto it = by_key_.find(key);
+    if (it != by_key_.end())
+    {
+      id = it->second.front();
+      it->second.pop_front();
+      if (it->second.empty()) by_key_.erase(it);
+    }
+  }
+  if (id != 0 && complete(id, Status::Ok, frame.toString(), now)) return;
+  if (unsolicited_cb_) unsolicited_cb_(frame);
+}
+
+/// @brief 完成一个请求
+bool TransactionEngine::complete(uint64_t id, Status status, const std::string& frame, int64_t now_ns)
+{
+  Response response;
+  Completion done;
+  uint64_t next = 0;
+  {
+    std::lock_guard<std::mutex> lock(mtx_);
+    auto it = pending_.find(id);
+    if (it == pending_.end()) return false;
+    Pending pending = std::move(it->second);
+    pending_.erase(it);
+    // 超时的条目已由 advance() 取出；其他完成方式从时间轮删除，时间轮为空时定时线程不再唤醒
+    if (status != Status::Timeout) wheel_.cancel(id, pending.deadline_ns);
+
+    if (pending.sent_ns != 0)
+    {
+      if (status != Status::Ok)
+      {
+        // 未收到应答：从关联表中移除，之后到达的同键帧不再匹配该请求
+        auto key_it = by_key_.find(pending.request.key);
+        if (key_it != by_key_.end())
+        {
+          std::deque<uint64_t>& ids = key_it->second;
+          ids.erase(std::remove(ids.begin(), ids.end(), id), ids.end());
+          if (ids.empty()) by_key_.erase(key_it);
+        }
+      }
+      --in_flight_;
+      if (!waiting_.empty())
+      {
+        next = waiting_.front();
+        waiting_.pop_front();
+        ++in_flight_;
+      }
+    }
+    else
+    {
+      waiting_.erase(std::remove(waiting_.begin(), waiting_.end(), id), waiting_.end());
+    }
+
+    std::unique_ptr<TypeCounters>& counters = type_stats_[pending.request.type];
+    if (!counters) counters.reset(new TypeCounters);
+    response.status = status;
+    if (status == Status::Ok)
+    {
+      response.frame = frame;
+      response.rtt_ns = now_ns - pending.sent_ns;
+      ++counters->completed;
+      counters->rtt.record(response.rtt_ns);
+    }
+    else if (status == Status::Timeout)
+    {
+      ++counters->timeouts;
+    }
+    else
+    {
+      ++counters->failures;
+    }
+    done = std::move(pending.done);
+  }
+
+  if (done) done(response);
+  if (next != 0) send(next);
+  return true;
+}
+
+/// @brief 定时线程主循环
+void TransactionEngine::timerLoop()
+{
+  std::vector<uint64_t> expired;
+  std::unique_lock<std::mutex> lock(mtx_);
+  while (!stopping_)
+  {
+    if (wheel_.empty())
+    {
+      cv_.wait(lock);  // 没有任何请求时不做定时唤醒
+      continue;
+    }
+    cv_.wait_for(lock, std::chrono::nanoseconds(wheel_.tickNs()));
+    if (stopping_) break;
+
+    expired.clear();
+    wheel_.advance(RxTimestamp::monoNow(), expired);
+    if (expired.empty()) continue;
+
+    lock.unlock();
+    const int64_t now = RxTimestamp::monoNow();
+    for (uint64_t id : expired) complete(id, Status::Timeout, std::string(), now);
+    lock.lock();
+  }
+}
@@ -0,0 +1,110 @@
+/// 说明：按波特率控制发送节拍的令牌桶实现
+
+#include "serialport/tx_pacer.h"
+
+#include <algorithm>
+#include <chrono>
+#include <thread>
+
+#if defined(__linux__)
+#include <errno.h>
+#include <time.h>
+#endif
+
+#include "serialport/rx_timestamp.h"
+
+TxPacer::TxPacer() : config_(Config())
+{
+}
+
+TxPacer::TxPacer(const Config& config) : config_(config)
+{
+}
+
+/// @brief 设置单字节传输时间
+void TxPacer::setByteTime(uint32_t byte_ns)
+{
+  const uint32_t percent = std::min<uint32_t>(std::max<uint32_t>(config_.rate_percent, 1), 100);
+  interval_ns_.store(static_cast<int64_t>(byte_ns) * 100 / percent, std::memory_order_relaxed);
+}
+
+/// @brief 每块的最大字节数
+size_t TxPacer::chunkBytes() const
+{
+  return config_.burst_bytes == 0 ? 1 : config_.burst_bytes;
+}
+
+/// @brief 预约一块数据的写出时刻
+int64_t TxPacer::reserve(size_t bytes, bool frame_start)
+{
+  chunks_.fetch_add(1, std::memory_order_relaxed);
+  const int64_t now = RxTimestamp::monoNow();
+  const int64_t interval = interval_ns_.load(std::memory_order_relaxed);
+  if (interval == 0) return now;
+
+  const int64_t cost = static_cast<int64_t>(bytes) * interval;
+  const int64_t burst = static_cast<int64_t>(chunkBytes()) * interval;
+  const int64_t gap = static_cast<int64_t>(config_.frame_gap_us) * 1000;
+  int64_t tat = tat_ns_.load(std::memory_order_relaxed);
+  int64_t start = now;
+  do
+  {
+    // 桶中剩余 (tat - start) 对应的字节数加上本块不能超过桶容量；帧首块还要等上一帧排空并空闲 gap
+    start = frame_start ? std::max(now, tat + gap) : std::max(now, tat + cost - burst);
+  } while (!tat_ns_.compare_exchange_weak(tat, std::max(tat, start) + cost, std::memory_order_relaxed));
+  return start;
+}
+
+/// @brief 等待到指定时刻
+void TxPacer::waitUntil(int64_t deadline_ns)
+{
+  int64_t now = RxTimestamp::monoNow();
+  if (deadline_ns <= now) return;
+  delayed_.fetch_add(1, std::memory_order_relaxed);
+  wait_ns_.fetch_add(static_cast<uint64_t>(deadline_ns - now), std::memory_order_relaxed);
+
+  // 先睡到截止前 spin_us，剩下的一小段自旋，避免调度器唤醒延迟影响节拍
+  const int64_t wake_ns = deadline_ns - static_cast<int64_t>(config_.spin_us) * 1000;
+  if (wake_ns > now)
+  {
+#if defined(__linux__)
+    // Linux 上 steady_clock 即 CLOCK_MONOTONIC，以绝对时间睡眠，被信号打断后不会累积误差
+    timespec ts;
+    ts.tv_sec = static_cast<time_t>(wake_ns / 1000000000);
+    ts.tv_nsec = static_cast<long>(wake_ns % 1000000000);
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, nullptr) == EINTR)
+    {
+    }
+#else
+    // macOS 等没有 clock_nanosleep 的平台：同样按 steady_clock 的绝对时刻睡眠，精度由下面的自旋补足
+    std::this_thread::sleep_until(std::chrono::steady_clock::time_point(std::chrono::nanoseconds(wake_ns)));
+#endif
+  }
+  while ((now = RxTimestamp::monoNow()) < deadline_ns)
+  {
+    std::this_thread::yield();
+  }
+
+  const uint64_t late = static_cast<uint64_t>(now - deadline_ns);
+  uint64_t current = max_late_ns_.load(std::memory_order_relaxed);
+  while (late > current && !max_late_ns_.compare_exchange_weak(current, late, std::memory_order_relaxed))
+  {
+  }
+}
+
+/// @brief 清空节拍状态
+void TxPacer::reset()
+{
+  tat_ns_.store(0, std::memory_order_relaxed);
+}
+
+/// @brief 获取统计信息
+TxPacer::Stats TxPacer::stats() const
+{
+  Stats stats;
+  stats.chunks = chunks_.load(std::memory_order_relaxed);
+  stats.delayed = delayed_.load(std::memory_order_relaxed);
+  stats.wait_ns = wait_ns_.load(std::memory_order_relaxed);
+  stats.max_late_ns = max_late_ns_.load(std::memory_order_relaxed);
+  return stats;
+}
@@ -0,0 +1,238 @@
+/// 说明：无锁多生产者/单消费者发送队列实现
+
+#include "serialport/tx_queue.h"
+
+#include <chrono>
+
+#include "serialport/rx_timestamp.h"
+
+namespace
+{
+/// @brief 原子地把 target 提升到不小于 value
+void raiseTo(std::atomic<size_t>& target, size_t value)
+{
+  size_t current = target.load(std::memory_order_relaxed);
+  while (value > current && !target.compare_exchange_weak(current, value, std::memory_order_relaxed))
+  {
+  }
+}
+}  // namespace
+
+TxQueue::TxQueue()
+{
+  for (size_t i = 0; i < kPoolSlots; ++i) pool_[i].seq.store(i, std::memory_order_relaxed);
+  for (Lane& lane : lanes_)
+  {
+    Node* stub = new Node;
+    lane.head.store(stub, std::memory_order_relaxed);
+    lane.tail = stub;
+  }
+}
+
+TxQueue::~TxQueue()
+{
+  for (Lane& lane : lanes_)
+  {
+    Node* node = lane.tail;
+    while (node)
+    {
+      Node* next = node->next.load(std::memory_order_relaxed);
+      delete node;
+      node = next;
+    }
+  }
+  for (size_t pos = pool_head_.load(std::memory_order_relaxed); pos != pool_tail_; ++pos)
+  {
+    delete pool_[pos % kPoolSlots].node;
+  }
+}
+
+/// @brief 提交一条数据
+void TxQueue::push(std::string data, Completion done, Priority priority)
+{
+  const size_t size = data.size();
+  raiseTo(high_water_depth_, depth_.fetch_add(1, std::memory_order_relaxed) + 1);
+  raiseTo(high_water_bytes_, bytes_pending_.fetch_add(size, std::memory_order_relaxed) + size);
+  submitted_.fetch_add(1, std::memory_order_relaxed);
+  if (priority == Priority::Urgent) urgent_submitted_.fetch_add(1, std::memory_order_relaxed);
+
+  Node* node = allocNode();
+  node->item.data = std::move(data);
+  node->item.done = std::move(done);
+  node->item.enqueue_ns = RxTimestamp::monoNow();
+  // 交换 head 后再链接前驱：两步之间消费者看到的是尚未链接的队尾，只会暂时认为队列到此为止
+  Lane& lane = lanes_[static_cast<size_t>(priority)];
+  Node* prev = lane.head.exchange(node, std::memory_order_acq_rel);
+  prev->next.store(node, std::memory_order_release);
+
+  // 与 wait() 中的栅栏配对：要么这里看到等待标志，要么写线程看到新节点，不会丢失唤醒
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (waiting_.load(std::memory_order_relaxed))
+  {
+    std::lock_guard<std::mutex> lock(mtx_);
+    cv_.notify_one();
+  }
+}
+
+/// @brief 取出队首条目，紧急通道优先
+bool TxQueue::pop(Item& item)
+{
+  return pop(item, Priority::Urgent) || pop(item, Priority::Normal);
+}
+
+/// @brief 从指定通道取出队首条目
+bool TxQueue::pop(Item& item, Priority priority)
+{
+  Lane& lane = lanes_[static_cast<size_t>(priority)];
+  Node* next = lane.tail->next.load(std::memory_order_acquire);
+  if (!next) return false;
+  // next 成为新的哑元节点，条目移出后释放旧哑元
+  item = std::move(next->item);
+  recycleNode(lane.tail);
+  lane.tail = next;
+  return true;
+}
+
+/// @brief 取一个节点
+TxQueue::Node* TxQueue::allocNode()
+{
+  // 槽位序号等于 pos + 1 表示写线程已放回节点；小于它表示池为空
+  size_t pos = pool_head_.load(std::memory_order_relaxed);
+  for (;;)
+  {
+    Slot& slot = pool_[pos % kPoolSlots];
+    const size_t seq = slot.seq.load(std::memory_order_acquire);
+    const intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos + 1);
+    if (diff == 0)
+    {
+      if (pool_head_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+      {
+        Node* node = slot.node;
+        slot.seq.store(pos + kPoolSlots, std::memory_order_release);  // 槽位交还给写线程的下一圈
+        return node;
+      }
+    }
+    else if (diff < 0)
+    {
+      break;
+    }
+    else
+    {
+      pos = pool_head_.load(std::memory_order_relaxed);  // 其他生产者已取走该槽位
+    }
+  }
+  node_allocations_.fetch_add(1, std::memory_order_relaxed);
+  return new Node;
+}
+
+/// @brief 释放一个节点
+void TxQueue::recycleNode(Node* node)
+{
+  // 条目已在成为哑元时移出，这里只清掉残留状态
+  node->next.store(nullptr, std::memory_order_relaxed);
+  node->item.data.clear();
+  node->item.done = nullptr;
+
+  Slot& slot = pool_[pool_tail_ % kPoolSlots];
+  if (slot.seq.load(std::memory_order_acquire) != pool_tail_)
+  {
+    delete node;  // 池已满（生产者尚未取走上一圈的节点）
+    return;
+  }
+  slot.node = node;
+  slot.seq.store(pool_tail_ + 1, std::memory_order_release);
+  ++pool_tail_;
+}
+
+/// @brief 通道是否有条目
+bool TxQueue::ready(const Lane& lane) const
+{
+  return lane.tail->next.load(std::memory_order_acquire) != nullptr;
+}
+
+/// @brief 等待任一通道非空或被关闭
+bool TxQueue::wait()
+{
+  auto any = [this] { return ready(lanes_[0]) || ready(lanes_[1]); };
+  if (any()) return true;
+
+  std::unique_lock<std::mutex> lock(mtx_);
+  waiting_.store(true);
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  cv_.wait(lock, [&] { return any() || closed_; });
+  waiting_.store(false);
+  return any();
+}
+
+/// @brief 等待紧急通道非空、被关闭或超时
+bool TxQueue::waitUrgent(int64_t timeout_ns)
+{
+  const Lane& urgent = lanes_[static_cast<size_t>(Priority::Urgent)];
+  if (ready(urgent) || timeout_ns <= 0) return ready(urgent);
+
+  // 普通通道的提交也会唤醒，谓词不成立时继续等待剩余时间
+  std::unique_lock<std::mutex> lock(mtx_);
+  waiting_.store(true);
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  cv_.wait_for(lock, std::chrono::nanoseconds(timeout_ns), [&] { return ready(urgent) || closed_; });
+  waiting_.store(false);
+  return ready(urgent);
+}
+
+/// @brief 记录紧急条目时延
+void TxQueue::noteUrgentLatency(int64_t latency_ns)
+{
+  urgent_latency_.record(latency_ns);
+}
+
+/// @brief 记录条目完成
+void TxQueue::finish(size_t count, size_t bytes, size_t failed)
+{
+  depth_.fetch_sub(count, std::memory_order_relaxed);
+  bytes_pending_.fetch_sub(bytes, std::memory_order_relaxed);
+  completed_.fetch_add(count - failed, std::memory_order_relaxed);
+  failed_.fetch_add(failed, std::memory_order_relaxed);
+}
+
+/// @brief 记录一次底层写调用
+void TxQueue::noteWrite(size_t bytes)
+{
+  write_calls_.fetch_add(1, std::memory_order_relaxed);
+  bytes_written_.fetch_add(bytes, std::memory_order_relaxed);
+}
+
+/// @brief 开始接受唤醒
+void TxQueue::open()
+{
+  std::lock_guard<std::mutex> lock(mtx_);
+  closed_ = false;
+}
+
+/// @brief 关闭并唤醒写线程
+void TxQueue::close()
+{
+  {
+    std::lock_guard<std::mutex> lock(mtx_);
+    closed_ = true;
+  }
+  cv_.notify_all();
+}
+
+/// @brief 获取统计信息
+TxQueue::Stats TxQueue::stats() const
+{
+  Stats stats;
+  stats.depth = depth_.load(std::memory_order_relaxed);
+  stats.bytes_pending = bytes_pending_.load(std::memory_order_relaxed);
+  stats.high_water_depth = high_water_depth_.load(std::memory_order_relaxed);
+  stats.high_water_bytes = high_water_bytes_.load(std::memory_order_relaxed);
+  stats.submitted = submitted_.load(std::memory_order_relaxed);
+  stats.completed = completed_.load(std::memory_order_relaxed);
+  stats.failed = failed_.load(std::memory_order_relaxed);
+  stats.write_calls = write_calls_.load(std::memory_order_relaxed);
+  stats.bytes_written = bytes_written_.load(std::memory_order_relaxed);
+  stats.node_allocations = node_allocations_.load(std::memory_order_relaxed);
+  stats.urgent_submitted = urgent_submitted_.load(std::memory_order_relaxed);
+  stats.urgent_latency = urgent_latency_.snapshot();
+  return stats;
+}
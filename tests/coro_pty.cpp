@@ -0,0 +1,157 @@
+/// 说明：C++20 协程接口测试（需以 -DSERIALPORT_BUILD_CORO=ON 构建）
+/// 设备端同样是跑在 CoExecutor 上的协程，直接读写伪终端 master 端：
+/// 命令应答、readUntil 超时后已收数据留在缓冲区、内核缓冲满时 write 等待 POLLOUT、挂断后 readSome 返回空串
+
+#include <unistd.h>
+
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <string>
+
+#include "bench_util.h"
+#include "serialport/coro.h"
+
+namespace
+{
+using std::chrono::milliseconds;
+using Clock = CoExecutor::Clock;
+
+/**
+ * @brief 一个伪终端、一个执行器与绑定到它的协程串口
+ */
+struct Rig
+{
+  bench::PtyPair pty;
+  CoExecutor ex;
+  std::unique_ptr<SerialPort> sp;
+  std::unique_ptr<AsyncSerialPort> port;
+
+  /// @brief 创建伪终端并以协程接口打开串口
+  bool open()
+  {
+    if (!pty.open()) return false;
+    sp.reset(new SerialPort(pty.slave(), 115200));
+    sp->setLogCallback([](SerialPort::LogLevel, const std::string&) {});
+    port.reset(new AsyncSerialPort(ex, *sp));  // 须在 open() 之前构造
+    return sp->open();
+  }
+
+  /// @brief 设备端发送数据
+  bool send(const std::string& data)
+  {
+    return ::write(pty.master(), data.data(), data.size()) == static_cast<ssize_t>(data.size());
+  }
+};
+
+/// @brief 设备端：收到一行命令后回一行应答
+CoTask<void> answerOnce(CoExecutor& ex, int master)
+{
+  std::string line;
+  while (line.find("\r\n") == std::string::npos)
+  {
+    if (!co_await ex.readable(master, CoExecutor::after(milliseconds(1000)))) co_return;
+    char buf[64];
+    const ssize_t n = ::read(master, buf, sizeof(buf));
+    if (n <= 0) co_return;
+    line.append(buf, static_cast<size_t>(n));
+  }
+  const std::string reply = line == "PING\r\n" ? "PONG\r\n" : "ERR\r\n";
+  ssize_t r = ::write(master, reply.data(), reply.size());
+  (void)r;
+}
+
+/// @brief 设备端：以小块慢速读取，直到收满 total 字节
+CoTask<void> slowDrain(CoExecutor& ex, int master, size_t total, std::string& got)
+{
+  while (got.size() < total)
+  {
+    if (!co_await ex.readable(master, CoExecutor::after(milliseconds(2000)))) co_return;
+    char buf[1024];
+    const ssize_t n = ::read(master, buf, sizeof(buf));
+    if (n <= 0) co_return;
+    got.append(buf, static_cast<size_t>(n));
+    co_await ex.sleepUntil(CoExecutor::after(std::chrono::microseconds(200)));
+  }
+}
+
+/// @brief 写命令后 readUntil 取回应答
+CoTask<bool> commandReply(Rig& rig)
+{
+  rig.ex.spawn(answerOnce(rig.ex, rig.pty.master()));
+  const size_t written = co_await rig.port->write("PING\r\n", CoExecutor::after(milliseconds(1000)));
+  const std::string reply = co_await rig.port->readUntil("\r\n", CoExecutor::after(milliseconds(1000)));
+  co_return written == 6 && reply == "PONG\r\n" && rig.port->buffered() == 0;
+}
+
+/// @brief readUntil 超时返回空串，已收到的半行留在缓冲区，补齐后整行交付
+CoTask<bool> readUntilTimeout(Rig& rig)
+{
+  rig.send("PART");
+  const Clock::time_point start = Clock::now();
+  const std::string first = co_await rig.port->readUntil("\r\n", CoExecutor::after(milliseconds(50)));
+  const bool timed_out = first.empty() && Clock::now() - start >= milliseconds(50) && rig.port->buffered() == 4;
+
+  rig.send("IAL\r\nNEXT");
+  const std::string second = co_await rig.port->readUntil("\r\n", CoExecutor::after(milliseconds(1000)));
+  const std::string rest = co_await rig.port->readSome(CoExecutor::after(milliseconds(1000)));
+  co_return timed_out && second == "PARTIAL\r\n" && rest == "NEXT";
+}
+
+/// @brief 写出远大于伪终端缓冲的数据：设备端慢速读取时全部按序写完
+CoTask<bool> writeBackpressure(Rig& rig)
+{
+  std::string data(256 * 1024, '\0');
+  for (size_t i = 0; i < data.size(); ++i) data[i] = static_cast<char>(i * 7 % 251);
+  std::string got;
+  rig.ex.spawn(slowDrain(rig.ex, rig.pty.master(), data.size(), got));
+
+  const size_t written = co_await rig.port->write(data, CoExecutor::after(milliseconds(10000)));
+  const Clock::time_point deadline = Clock::now() + milliseconds(2000);
+  while (got.size() < data.size() && Clock::now() < deadline)
+  {
+    co_await rig.ex.sleepUntil(CoExecutor::after(milliseconds(1)));
+  }
+  co_return written == data.size() && got == data;
+}
+
+/// @brief 设备端不读：write 等待 POLLOUT 直到截止时间，返回已写入的部分
+CoTask<bool> writeDeadline(Rig& rig)
+{
+  const std::string data(256 * 1024, 'w');
+  const Clock::time_point start = Clock::now();
+  const size_t written = co_await rig.port->write(data, CoExecutor::after(milliseconds(100)));
+  co_return written > 0 && written < data.size() && Clock::now() - start >= milliseconds(100);
+}
+
+/// @brief 设备挂断后 readSome 不等到截止时间就返回空串
+CoTask<bool> readSomeHangup(Rig& rig)
+{
+  rig.send("bye");
+  const std::string first = co_await rig.port->readSome(CoExecutor::after(milliseconds(1000)));
+  rig.pty.close();
+  const Clock::time_point start = Clock::now();
+  const std::string second = co_await rig.port->readSome(CoExecutor::after(milliseconds(2000)));
+  co_return first == "bye" && second.empty() && Clock::now() - start < milliseconds(1000) && !rig.sp->isOpen();
+}
+
+/// @brief 在新的伪终端上运行一项检查并打印结果
+bool check(const char* name, CoTask<bool> (*test)(Rig&))
+{
+  Rig rig;
+  const bool ok = rig.open() && rig.ex.run(test(rig));
+  std::printf("%-44s %s\n", name, ok ? "ok" : "FAIL");
+  return ok;
+}
+}  // namespace
+
+int main()
+{
+  int failures = 0;
+  if (!check("write, then readUntil the reply", commandReply)) ++failures;
+  if (!check("readUntil deadline keeps partial data", readUntilTimeout)) ++failures;
+  if (!check("write under POLLOUT back-pressure", writeBackpressure)) ++failures;
+  if (!check("write deadline while the device is stalled", writeDeadline)) ++failures;
+  if (!check("readSome returns empty after hangup", readSomeHangup)) ++failures;
+  return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,161 @@
+/// 说明：帧解码器行为测试（不依赖伪终端，直接按块输入）
+/// 覆盖跨块分隔符、多字节分隔符跨块时取最早结束的匹配、跨块定长帧、5 字节 varint、
+/// 超长 varint 的丢弃与重新同步，以及完整落在输入块内的帧以视图交付（指向输入块本身）
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "serialport/frame_decoder.h"
+
+namespace
+{
+/**
+ * @brief 收集解出的帧及其地址
+ */
+struct Collector
+{
+  std::vector<std::string> frames;     ///< 帧内容
+  std::vector<const uint8_t*> starts;  ///< 帧起始地址（回调期间的视图地址）
+
+  FrameDecoder::FrameCallback callback()
+  {
+    return [this](const uint8_t* data, size_t size) {
+      frames.emplace_back(reinterpret_cast<const char*>(data), size);
+      starts.push_back(data);
+    };
+  }
+};
+
+/// @brief 输入一块数据
+void feed(FrameDecoder& decoder, const std::string& chunk, Collector& out)
+{
+  decoder.feed(reinterpret_cast<const uint8_t*>(chunk.data()), chunk.size(), out.callback());
+}
+
+/// @brief 逐字节输入
+void feedBytes(FrameDecoder& decoder, const std::string& data, Collector& out)
+{
+  for (char c : data) feed(decoder, std::string(1, c), out);
+}
+
+/// @brief 打印一项检查的结果，返回是否通过
+bool check(const char* name, bool ok)
+{
+  std::printf("%-44s %s\n", name, ok ? "ok" : "FAIL");
+  return ok;
+}
+
+/// @brief 分隔符横跨两块，含不交付分隔符的配置
+bool delimiterSplitAcrossChunks()
+{
+  DelimiterFrameDecoder decoder("\r\n");
+  Collector out;
+  feed(decoder, "abc\r", out);
+  feed(decoder, "\ndef\r\nxy", out);
+  feed(decoder, "z\r\n", out);
+
+  DelimiterFrameDecoder stripped("\r\n", false);
+  Collector bare;
+  feed(stripped, "abc\r", bare);
+  feed(stripped, "\n", bare);
+  return out.frames == std::vector<std::string>{"abc\r\n", "def\r\n", "xyz\r\n"} &&
+         bare.frames == std::vector<std::string>{"abc"};
+}
+
+/// @brief 多字节分隔符跨块
+bool multiByteDelimiterEarliestEnd()
+{
+  // 上一块末尾 "ABA" 与本块开头 "B" 组成分隔符，"A" 与 "BAB" 也能组成；
+  // 必须取落在上一块中最长的部分，即帧在最早的分隔符处结束
+  DelimiterFrameDecoder decoder("ABAB");
+  Collector out;
+  feed(decoder, "xABA", out);
+  feed(decoder, "BABy", out);
+  feed(decoder, "ABAB", out);
+  // 分隔符分布在三块中
+  feed(decoder, "zA", out);
+  feed(decoder, "B", out);
+  feed(decoder, "AB", out);
+  return out.frames == std::vector<std::string>{"xABAB", "AByABAB", "zABAB"} && decoder.stats().frames == 3;
+}
+
+/// @brief 定长帧跨块
+bool fixedFrameStraddlingChunks()
+{
+  FixedLengthFrameDecoder decoder(4);
+  Collector out;
+  feed(decoder, "ab", out);
+  feed(decoder, "cdefg", out);
+  feed(decoder, "h", out);
+  feed(decoder, "ijkl", out);
+  return out.frames == std::vector<std::string>{"abcd", "efgh", "ijkl"};
+}
+
+/// @brief 5 字节 varint 长度字段，整块与逐字节输入
+bool varintFiveBytes()
+{
+  // 非最简编码的 5 字节 varint，值为 3
+  const std::string frame = std::string("\x83\x80\x80\x80\x00", 5) + "abc";
+  LengthPrefixedFrameDecoder whole(LengthPrefixedFrameDecoder::LengthField::Varint);
+  Collector a;
+  feed(whole, frame + frame, a);
+  LengthPrefixedFrameDecoder split(LengthPrefixedFrameDecoder::LengthField::Varint);
+  Collector b;
+  feedBytes(split, frame, b);
+  return a.frames == std::vector<std::string>{frame, frame} && b.frames == std::vector<std::string>{frame} &&
+         whole.stats().dropped_bytes == 0 && split.stats().dropped_bytes == 0;
+}
+
+/// @brief 超长 varint 被逐字节丢弃后重新同步
+bool varintOverlongResync()
+{
+  // 6 个带续位的字节：前两个起点是超过 5 字节的 varint，之后的起点给出超过 max_frame 的长度，
+  // 逐字节丢弃后在 "\x02hi" 上重新同步
+  const std::string garbage(6, '\xff');
+  const std::string frame = "\x02hi";
+  LengthPrefixedFrameDecoder whole(LengthPrefixedFrameDecoder::LengthField::Varint, 0, 0, 64);
+  Collector a;
+  feed(whole, garbage + frame, a);
+  LengthPrefixedFrameDecoder split(LengthPrefixedFrameDecoder::LengthField::Varint, 0, 0, 64);
+  Collector b;
+  feedBytes(split, garbage + frame, b);
+  return a.frames == std::vector<std::string>{frame} && whole.stats().dropped_bytes == 6 &&
+         b.frames == std::vector<std::string>{frame} && split.stats().dropped_bytes == 6;
+}
+
+/// @brief 块内的帧以视图交付
+bool zeroCopyViews()
+{
+  // 完整落在块内的帧指向输入块本身；跨块拼接的帧来自解码器内部缓冲区
+  const std::string chunk = "one\ntwo\nthr";
+  DelimiterFrameDecoder delimited("\n");
+  Collector out;
+  feed(delimited, chunk, out);
+  const std::string tail = "ee\n";
+  feed(delimited, tail, out);
+  const uint8_t* begin = reinterpret_cast<const uint8_t*>(chunk.data());
+  const bool delimited_ok = out.frames == std::vector<std::string>{"one\n", "two\n", "three\n"} &&
+                            out.starts[0] == begin && out.starts[1] == begin + 4 &&
+                            out.starts[2] != reinterpret_cast<const uint8_t*>(tail.data());
+
+  const std::string frames = std::string("\x01x\x02yz", 5);
+  LengthPrefixedFrameDecoder prefixed(LengthPrefixedFrameDecoder::LengthField::Uint8);
+  Collector lp;
+  feed(prefixed, frames, lp);
+  const uint8_t* lp_begin = reinterpret_cast<const uint8_t*>(frames.data());
+  return delimited_ok && lp.frames.size() == 2 && lp.starts[0] == lp_begin && lp.starts[1] == lp_begin + 2;
+}
+}  // namespace
+
+int main()
+{
+  int failures = 0;
+  if (!check("delimiter split across chunks", delimiterSplitAcrossChunks())) ++failures;
+  if (!check("multi-byte delimiter, earliest end", multiByteDelimiterEarliestEnd())) ++failures;
+  if (!check("fixed frame straddling chunks", fixedFrameStraddlingChunks())) ++failures;
+  if (!check("5-byte varint, whole and byte by byte", varintFiveBytes())) ++failures;
+  if (!check("over-long varint dropped, resync", varintOverlongResync())) ++failures;
+  if (!check("in-chunk frames delivered as views", zeroCopyViews())) ++failures;
+  return failures == 0 ? 0 : 1;
+}
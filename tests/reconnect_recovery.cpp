@@ -0,0 +1,127 @@
+/// 说明：断线重连故障注入测试——在伪终端上模拟拔出与重新插入，测量恢复时间
+/// 串口通过一个符号链接打开；拔出时删除链接并关闭 master 端（slave 端挂断），间隔一段时间后
+/// 新建伪终端并把链接指向它，相当于设备在同一路径上重新枚举。
+/// 对轮询读、事件驱动读与共享反应器三种读路径各注入若干次：每次都必须恢复到 Open 并重新收到数据，
+/// 且重新插入到恢复的耗时不超过上限
+
+#include <unistd.h>
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "bench_util.h"
+#include "serialport/port_reactor.h"
+#include "serialport/serialport.h"
+
+namespace
+{
+const int kRounds = 5;                        ///< 每种读路径的注入次数
+const int kUnpluggedMs = 200;                 ///< 拔出持续时间（重连退避已进入较长间隔）
+const int64_t kMaxRecoveryNs = 1000000000LL;  ///< 重新插入到恢复（含收到数据）的上限
+
+/**
+ * @brief 插入设备：新建伪终端并把链接指向其 slave 端
+ */
+bool plug(bench::PtyPair& pty, const std::string& link)
+{
+  if (!pty.open()) return false;
+  ::unlink(link.c_str());
+  return ::symlink(pty.slave().c_str(), link.c_str()) == 0;
+}
+
+/// @brief 等待条件成立，超时返回 false
+template <typename Pred>
+bool waitFor(Pred pred, int64_t timeout_ns)
+{
+  const int64_t deadline = bench::nowNs() + timeout_ns;
+  while (!pred())
+  {
+    if (bench::nowNs() >= deadline) return false;
+    std::this_thread::sleep_for(std::chrono::microseconds(100));
+  }
+  return true;
+}
+
+/**
+ * @brief 对一种读路径注入故障
+ * @return 所有轮次都在上限内恢复并收到数据时返回 true
+ */
+bool run(const char* name, SerialPort::ReadMode mode, bool reactor, const std::string& link)
+{
+  bench::PtyPair pty;
+  if (!plug(pty, link)) return false;
+
+  std::atomic<size_t> received{0};
+  SerialPort sp(link, 115200);
+  sp.setReadMode(mode).setReconnectLimit(100).setLogCallback([](SerialPort::LogLevel, const std::string&) {});
+  sp.setDataViewCallback([&](const SerialPort::DataView& data) { received.fetch_add(data.size); });
+  if (reactor) sp.setReactor(std::make_shared<PortReactor>(1));
+  if (!sp.open()) return false;
+
+  bool ok = true;
+  std::vector<int64_t> to_open;
+  std::vector<int64_t> to_data;
+  for (int round = 0; round < kRounds && ok; ++round)
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    ::unlink(link.c_str());
+    pty.close();
+    std::this_thread::sleep_for(std::chrono::milliseconds(kUnpluggedMs));
+
+    if (!plug(pty, link)) return false;
+    const int64_t plugged = bench::nowNs();
+    if (!waitFor([&] { return sp.linkState() == SerialPort::LinkState::Open; }, kMaxRecoveryNs))
+    {
+      std::printf("%s: round %d did not reopen\n", name, round);
+      ok = false;
+      break;
+    }
+    to_open.push_back(bench::nowNs() - plugged);
+
+    // 设备重新插入后立即发数据，确认读路径也已恢复
+    const size_t before = received.load();
+    if (::write(pty.master(), "ping", 4) != 4 ||
+        !waitFor([&] { return received.load() >= before + 4; }, kMaxRecoveryNs - to_open.back()))
+    {
+      std::printf("%s: round %d reopened but received no data\n", name, round);
+      ok = false;
+      break;
+    }
+    to_data.push_back(bench::nowNs() - plugged);
+  }
+
+  char label[64];
+  std::snprintf(label, sizeof(label), "%s: replug -> open", name);
+  bench::printPercentiles(label, to_open, 1e6, "ms");
+  std::snprintf(label, sizeof(label), "%s: replug -> data", name);
+  bench::printPercentiles(label, to_data, 1e6, "ms");
+
+  const SerialPort::ReconnectStats stats = sp.reconnectStats();
+  std::printf("%-34s disconnects %llu, recoveries %llu, attempts %llu, disconnect -> open p50 %.1f ms\n", "",
+              static_cast<unsigned long long>(stats.disconnects), static_cast<unsigned long long>(stats.recoveries),
+              static_cast<unsigned long long>(stats.attempts), stats.recovery.percentile(50) / 1e6);
+  sp.close();
+  return ok && stats.recoveries == static_cast<uint64_t>(kRounds);
+}
+}  // namespace
+
+int main()
+{
+  // 每个进程使用自己的链接路径，并行运行的测试互不干扰
+  const std::string link = "/tmp/testReconnectRecovery-" + std::to_string(::getpid());
+  std::printf("%d rounds per read path, unplugged %d ms each\n", kRounds, kUnpluggedMs);
+
+  int failures = 0;
+  if (!run("polling", SerialPort::ReadMode::Polling, false, link)) ++failures;
+  if (!run("event", SerialPort::ReadMode::Event, false, link)) ++failures;
+  if (!run("reactor", SerialPort::ReadMode::Event, true, link)) ++failures;
+  ::unlink(link.c_str());
+
+  std::printf("%s\n", failures == 0 ? "ok" : "FAIL");
+  return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,156 @@
+/// 说明：有界接收队列测试（不依赖伪终端）
+/// 在小容量队列上验证 DropOldest 与 DropNewest 的丢弃块数、字节数精确计数，
+/// Block 策略的超时与背压等待，以及慢消费者回调只触发一次、回落到阈值一半以下后重新布防
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "serialport/rx_queue.h"
+
+namespace
+{
+/// @brief 从池中取一块，填入 size 字节，首字节为标记
+RxBlock makeBlock(const std::shared_ptr<RxBlockPool>& pool, size_t size, uint8_t tag)
+{
+  RxBlock block = pool->acquire();
+  std::memset(block.mutableData(), tag, size);
+  block.setSize(size);
+  return block;
+}
+
+/// @brief 依次出队，返回各块的标记（不等待）
+std::vector<uint8_t> drain(RxQueue& queue)
+{
+  std::vector<uint8_t> tags;
+  RxBlock block;
+  while (queue.pop(block, 0)) tags.push_back(block.data()[0]);
+  return tags;
+}
+
+/// @brief 打印一项检查的结果，返回是否通过
+bool check(const char* name, bool ok)
+{
+  std::printf("%-44s %s\n", name, ok ? "ok" : "FAIL");
+  return ok;
+}
+
+/// @brief DropOldest：挤出队首的块，直到新块能放下
+bool dropOldest(const std::shared_ptr<RxBlockPool>& pool)
+{
+  RxQueue queue(4, 100, RxQueue::Overflow::DropOldest);
+  bool ok = true;
+  ok &= queue.push(makeBlock(pool, 10, 1));
+  ok &= queue.push(makeBlock(pool, 20, 2));
+  ok &= queue.push(makeBlock(pool, 30, 3));
+  ok &= queue.push(makeBlock(pool, 40, 4));
+  ok &= queue.push(makeBlock(pool, 5, 5));   // 块数已满：挤出 10 字节的 1 号
+  ok &= queue.push(makeBlock(pool, 50, 6));  // 字节数不足：挤出 2 号与 3 号（50 字节）
+  const RxQueue::Stats stats = queue.stats();
+  ok &= stats.dropped_chunks == 3 && stats.dropped_bytes == 60 && stats.loss_events == 2 && stats.last_loss_ns != 0;
+  ok &= stats.enqueued_chunks == 6 && stats.enqueued_bytes == 155 && stats.chunks == 3 && stats.bytes == 95;
+  ok &= stats.high_water_chunks == 4 && stats.high_water_bytes == 100;
+  return ok && drain(queue) == std::vector<uint8_t>{4, 5, 6};
+}
+
+/// @brief DropNewest：放不下的新块被丢弃，已排队数据不变
+bool dropNewest(const std::shared_ptr<RxBlockPool>& pool)
+{
+  RxQueue queue(3, 50, RxQueue::Overflow::DropNewest);
+  bool ok = true;
+  ok &= queue.push(makeBlock(pool, 20, 1));
+  ok &= queue.push(makeBlock(pool, 20, 2));
+  ok &= !queue.push(makeBlock(pool, 20, 3));  // 字节数超限
+  ok &= queue.push(makeBlock(pool, 10, 4));
+  ok &= !queue.push(makeBlock(pool, 1, 5));  // 块数超限
+  const RxQueue::Stats stats = queue.stats();
+  ok &= stats.dropped_chunks == 2 && stats.dropped_bytes == 21 && stats.loss_events == 2;
+  ok &= stats.enqueued_chunks == 3 && stats.enqueued_bytes == 50;
+  return ok && drain(queue) == std::vector<uint8_t>{1, 2, 4};
+}
+
+/// @brief Block：限时等待超时后块留给调用方；无限等待直到消费者腾出空间，不计丢弃
+bool blockBackPressure(const std::shared_ptr<RxBlockPool>& pool)
+{
+  RxQueue queue(2, 0, RxQueue::Overflow::Block);
+  bool ok = true;
+  ok &= queue.push(makeBlock(pool, 8, 1));
+  ok &= queue.push(makeBlock(pool, 8, 2));
+
+  RxBlock pending = makeBlock(pool, 8, 3);
+  ok &= !queue.push(std::move(pending), 20);
+  ok &= pending && pending.size() == 8;  // 超时：所有权仍在调用方
+
+  std::thread consumer([&] {
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    RxBlock block;
+    queue.pop(block, 0);
+  });
+  const auto start = std::chrono::steady_clock::now();
+  ok &= queue.push(std::move(pending));
+  const auto waited = std::chrono::steady_clock::now() - start;
+  consumer.join();
+
+  RxQueue::Stats stats = queue.stats();
+  ok &= waited >= std::chrono::milliseconds(30) && stats.block_waits == 2 && stats.blocked_ns >= 40000000ULL;
+  ok &= stats.dropped_chunks == 0 && stats.dropped_bytes == 0 && stats.enqueued_chunks == 3;
+
+  // 关闭后入队计为丢弃
+  queue.close();
+  ok &= !queue.push(makeBlock(pool, 7, 4));
+  stats = queue.stats();
+  ok &= stats.dropped_chunks == 1 && stats.dropped_bytes == 7;
+  return ok && drain(queue) == std::vector<uint8_t>{2, 3};
+}
+
+/// @brief 慢消费者回调：越过阈值触发一次，回落到阈值一半以下后重新布防
+bool slowConsumer(const std::shared_ptr<RxBlockPool>& pool)
+{
+  RxQueue queue(16, 0, RxQueue::Overflow::DropNewest);
+  std::atomic<int> fired{0};
+  size_t fired_bytes = 0;
+  queue.setSlowConsumer(100, [&](const RxQueue::Stats& stats) {
+    fired_bytes = stats.bytes;
+    fired.fetch_add(1);
+  });
+
+  bool ok = true;
+  queue.push(makeBlock(pool, 40, 1));
+  queue.push(makeBlock(pool, 40, 2));
+  ok &= fired == 0;
+  queue.push(makeBlock(pool, 40, 3));  // 120 字节越过阈值
+  ok &= fired == 1 && fired_bytes == 120;
+  queue.push(makeBlock(pool, 40, 4));  // 仍在阈值之上，不再触发
+  ok &= fired == 1;
+
+  RxBlock block;
+  queue.pop(block, 0);
+  queue.pop(block, 0);
+  queue.push(makeBlock(pool, 40, 5));  // 回落到 80 字节（高于阈值一半）后再越过，未重新布防
+  ok &= fired == 1;
+  queue.pop(block, 0);
+  queue.pop(block, 0);
+  queue.pop(block, 0);  // 回落到 0，重新布防
+  queue.push(makeBlock(pool, 40, 6));
+  queue.push(makeBlock(pool, 40, 7));
+  queue.push(makeBlock(pool, 40, 8));  // 再次越过阈值
+  ok &= fired == 2 && fired_bytes == 120 && queue.stats().slow_consumer_events == 2;
+  return ok;
+}
+}  // namespace
+
+int main()
+{
+  std::shared_ptr<RxBlockPool> pool = std::make_shared<RxBlockPool>(32, 64);
+
+  int failures = 0;
+  if (!check("DropOldest: exact dropped chunks/bytes", dropOldest(pool))) ++failures;
+  if (!check("DropNewest: exact dropped chunks/bytes", dropNewest(pool))) ++failures;
+  if (!check("Block: timeout and back-pressure", blockBackPressure(pool))) ++failures;
+  if (!check("slow consumer: fires once, re-arms", slowConsumer(pool))) ++failures;
+  return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,146 @@
+/// 说明：零拷贝视图回调的堆分配测试
+/// 替换全局 operator new 计数，在伪终端上持续收数据：视图回调在稳态下不得有任何堆分配；
+/// 同时测量字符串回调作为对照（每个数据块至少分配一次），确认计数确实生效
+
+#include <unistd.h>
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <thread>
+
+#include "bench_util.h"
+#include "serialport/serialport.h"
+
+namespace
+{
+std::atomic<uint64_t> g_allocs{0};  ///< 进程内所有线程的 operator new 调用次数
+}  // namespace
+
+void* operator new(std::size_t size)
+{
+  g_allocs.fetch_add(1, std::memory_order_relaxed);
+  if (void* p = std::malloc(size ? size : 1)) return p;
+  throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size)
+{
+  g_allocs.fetch_add(1, std::memory_order_relaxed);
+  if (void* p = std::malloc(size ? size : 1)) return p;
+  throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept
+{
+  std::free(p);
+}
+
+void operator delete[](void* p) noexcept
+{
+  std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept
+{
+  std::free(p);
+}
+
+void operator delete[](void* p, std::size_t) noexcept
+{
+  std::free(p);
+}
+
+namespace
+{
+const int kWarmupChunks = 50;     ///< 预热块数（首次回调等一次性分配不计入）
+const int kMeasureChunks = 1000;  ///< 计数的块数
+const size_t kChunkBytes = 64;    ///< 每块字节数
+
+/**
+ * @brief 向伪终端逐块写入并等待全部交付
+ * @return 全部交付返回 true
+ */
+bool pump(bench::PtyPair& pty, std::atomic<size_t>& received, int chunks)
+{
+  static const char block[kChunkBytes] = {0};
+  const size_t target = received.load() + chunks * kChunkBytes;
+  for (int i = 0; i < chunks; ++i)
+  {
+    if (::write(pty.master(), block, kChunkBytes) != static_cast<ssize_t>(kChunkBytes)) return false;
+    std::this_thread::sleep_for(std::chrono::microseconds(100));  // 让每块单独交付
+  }
+  const int64_t deadline = bench::nowNs() + 5000000000LL;
+  while (received.load() < target && bench::nowNs() < deadline)
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  return received.load() == target;
+}
+
+/**
+ * @brief 测量一种读模式与回调类型稳态下每块的分配次数
+ * @return 每块平均分配次数，失败返回负数
+ */
+double measure(SerialPort::ReadMode mode, bool view)
+{
+  bench::PtyPair pty;
+  if (!pty.open()) return -1;
+
+  std::atomic<size_t> received{0};
+  std::atomic<size_t> calls{0};
+  SerialPort sp(pty.slave(), 115200);
+  sp.setReadMode(mode).setTimeout(1);
+  if (view)
+  {
+    sp.setDataViewCallback([&](const SerialPort::DataView& data) {
+      received.fetch_add(data.size);
+      calls.fetch_add(1);
+    });
+  }
+  else
+  {
+    sp.setDataCallback([&](const std::string& data) {
+      received.fetch_add(data.size());
+      calls.fetch_add(1);
+    });
+  }
+  if (!sp.open()) return -1;
+
+  if (!pump(pty, received, kWarmupChunks)) return -1;
+  const size_t calls_before = calls.load();
+  const uint64_t allocs_before = g_allocs.load();
+  if (!pump(pty, received, kMeasureChunks)) return -1;
+  const uint64_t allocs = g_allocs.load() - allocs_before;
+  const size_t delivered = calls.load() - calls_before;
+  sp.close();
+  return delivered ? static_cast<double>(allocs) / delivered : -1;
+}
+}  // namespace
+
+int main()
+{
+  struct Case
+  {
+    const char* name;
+    SerialPort::ReadMode mode;
+    bool view;
+  };
+  const Case cases[] = {
+      {"polling/view", SerialPort::ReadMode::Polling, true},
+      {"event/view", SerialPort::ReadMode::Event, true},
+      {"event/string", SerialPort::ReadMode::Event, false},
+  };
+
+  int failures = 0;
+  for (const Case& c : cases)
+  {
+    const double per_chunk = measure(c.mode, c.view);
+    // 视图回调必须为 0；字符串回调作为对照，至少每块一次
+    const bool ok = per_chunk >= 0 && (c.view ? per_chunk == 0 : per_chunk >= 1);
+    std::printf("%-14s allocations per chunk: %.3f  %s\n", c.name, per_chunk, ok ? "ok" : "FAIL");
+    if (!ok) ++failures;
+  }
+  return failures == 0 ? 0 : 1;
+}